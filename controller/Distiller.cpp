@@ -0,0 +1,247 @@
+//-------------------------------------------------------------
+//【文件名】Distiller.cpp
+//【功能模块和目的】知识蒸馏：用大网络（教师）的输出训练小网络（学生）的实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "Distiller.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+// Per-sample microseconds of one-at-a-time and single-threaded whole-batch inference
+void measureLatency(const CompiledNetwork& network, const vector<double>& inputs, int64_t rows, int repeats,
+                    double& single, double& batch) {
+    const int64_t iInputs = network.getInputSize();
+    const int iRepeats = max(1, repeats);
+    vector<double> row(static_cast<size_t>(iInputs));
+    volatile double rSink = 0.0;  // Keeps the timed calls observable
+    auto start = chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < iRepeats; ++iRepeat) {
+        for (int64_t iRow = 0; iRow < rows; ++iRow) {
+            copy(inputs.begin() + iRow * iInputs, inputs.begin() + (iRow + 1) * iInputs, row.begin());
+            rSink = network.predict(row)[0];
+        }
+    }
+    auto middle = chrono::steady_clock::now();
+    for (int iRepeat = 0; iRepeat < iRepeats; ++iRepeat) {
+        rSink = network.predictBatch(inputs, rows)[0];
+    }
+    auto end = chrono::steady_clock::now();
+    static_cast<void>(rSink);
+    const double rSamples = static_cast<double>(rows) * iRepeats;
+    single = chrono::duration<double, micro>(middle - start).count() / rSamples;
+    batch = chrono::duration<double, micro>(end - middle).count() / rSamples;
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】Distiller
+//【函数功能】构造函数
+//【参数】teacher：教师网络
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Distiller::Distiller(const Network& teacher) : m_iTeacherParameters(0), m_iRows(0) {
+    Trainer layout;
+    if (m_teacher.compile(teacher) && layout.loadFrom(teacher)) {
+        m_iTeacherParameters = layout.getParameterCount();
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】isReady
+//【函数功能】判断教师网络是否编译成功
+//【参数】无
+//【返回值】bool，是否可用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Distiller::isReady() const {
+    return m_teacher.isCompiled() && m_iTeacherParameters > 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取输入个数
+//【参数】无
+//【返回值】int64_t，输入个数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Distiller::getInputSize() const {
+    return m_teacher.getInputSize();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOutputSize
+//【函数功能】获取输出个数
+//【参数】无
+//【返回值】int64_t，输出个数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Distiller::getOutputSize() const {
+    return m_teacher.getOutputSize();
+}
+
+//-------------------------------------------------------------
+//【函数名称】setTransferInputs
+//【函数功能】设置迁移输入集并计算教师输出
+//【参数】inputs：输入，rows：样本数，pool：线程池
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Distiller::setTransferInputs(const vector<double>& inputs, int64_t rows, ThreadPool& pool) {
+    if (!isReady() || rows < 2 || static_cast<int64_t>(inputs.size()) != rows * getInputSize()) {
+        return false;
+    }
+    // The teacher runs once per transfer set, batched across the pool
+    m_targets = m_teacher.predictBatch(inputs, rows, pool);
+    m_inputs = inputs;
+    m_iRows = rows;
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】synthesizeTransferInputs
+//【函数功能】均匀生成迁移输入集并计算教师输出
+//【参数】rows：样本数，low、high：取值区间，seed：种子，pool：线程池
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Distiller::synthesizeTransferInputs(int64_t rows, double low, double high, uint64_t seed, ThreadPool& pool) {
+    if (!isReady() || rows < 2 || !(low < high)) {
+        return false;
+    }
+    mt19937_64 random(seed);
+    uniform_real_distribution<double> value(low, high);
+    vector<double> inputs(static_cast<size_t>(rows * getInputSize()));
+    for (double& rValue : inputs) {
+        rValue = value(random);
+    }
+    return setTransferInputs(inputs, rows, pool);
+}
+
+//-------------------------------------------------------------
+//【函数名称】getTransferRows
+//【函数功能】获取迁移集的样本数
+//【参数】无
+//【返回值】int64_t，样本数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Distiller::getTransferRows() const {
+    return m_iRows;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getTransferTargets
+//【函数功能】获取教师在迁移集上的输出
+//【参数】无
+//【返回值】const vector<double>&，教师输出
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<double>& Distiller::getTransferTargets() const {
+    return m_targets;
+}
+
+//-------------------------------------------------------------
+//【函数名称】distill
+//【函数功能】训练学生网络拟合教师输出并生成报告
+//【参数】student：学生网络，optimizer：优化器，settings：设置，pool：线程池
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Distiller::distill(Network& student, unique_ptr<Optimizer> optimizer, const DistillationSettings& settings,
+                        ThreadPool& pool) {
+    const int64_t iInputs = getInputSize();
+    const int64_t iOutputs = getOutputSize();
+    const double rFraction = min(1.0, max(0.0, settings.rHeldOutFraction));
+    const int64_t iHeldOut = static_cast<int64_t>(ceil(m_iRows * rFraction));
+    const int64_t iTraining = m_iRows - iHeldOut;
+    Trainer trainer;
+    trainer.setOptimizer(move(optimizer));
+    if (m_iRows == 0 || iHeldOut < 1 || iTraining < 1 || settings.iEpochs < 1 || !trainer.loadFrom(student) ||
+        trainer.getInputSize() != iInputs || trainer.getOutputSize() != iOutputs) {
+        return false;
+    }
+
+    // The held-out tail never reaches the optimizer
+    const vector<double> trainingInputs(m_inputs.begin(), m_inputs.begin() + iTraining * iInputs);
+    const vector<double> trainingTargets(m_targets.begin(), m_targets.begin() + iTraining * iOutputs);
+    const vector<double> heldOutInputs(m_inputs.begin() + iTraining * iInputs, m_inputs.end());
+    DistillationReport report;
+    report.iTeacherParameters = m_iTeacherParameters;
+    report.iStudentParameters = trainer.getParameterCount();
+    report.iTrainingRows = iTraining;
+    report.iHeldOutRows = iHeldOut;
+    for (int iEpoch = 0; iEpoch < settings.iEpochs; ++iEpoch) {
+        report.epochLosses.push_back(trainer.trainEpoch(trainingInputs, trainingTargets, iTraining,
+                                                        settings.iBatchSize, pool, ReductionMode::Deterministic));
+    }
+    CompiledNetwork compiled;
+    if (!trainer.writeTo(student) || !compiled.compile(student)) {
+        return false;
+    }
+
+    // Fidelity to the teacher on the held-out rows: MSE, explained variance and arg-max agreement
+    const vector<double> outputs = compiled.predictBatch(heldOutInputs, iHeldOut);
+    const double* pTeacher = m_targets.data() + iTraining * iOutputs;
+    double rSquaredError = 0.0;
+    double rVariance = 0.0;
+    for (int64_t iOutput = 0; iOutput < iOutputs; ++iOutput) {
+        double rMean = 0.0;
+        for (int64_t iRow = 0; iRow < iHeldOut; ++iRow) {
+            rMean += pTeacher[iRow * iOutputs + iOutput];
+        }
+        rMean /= static_cast<double>(iHeldOut);
+        for (int64_t iRow = 0; iRow < iHeldOut; ++iRow) {
+            const double rTeacher = pTeacher[iRow * iOutputs + iOutput];
+            const double rDifference = outputs[iRow * iOutputs + iOutput] - rTeacher;
+            rSquaredError += rDifference * rDifference;
+            rVariance += (rTeacher - rMean) * (rTeacher - rMean);
+        }
+    }
+    int64_t iAgreeing = 0;
+    for (int64_t iRow = 0; iRow < iHeldOut; ++iRow) {
+        const double* pStudentRow = outputs.data() + iRow * iOutputs;
+        const double* pTeacherRow = pTeacher + iRow * iOutputs;
+        iAgreeing += max_element(pStudentRow, pStudentRow + iOutputs) - pStudentRow ==
+                     max_element(pTeacherRow, pTeacherRow + iOutputs) - pTeacherRow ? 1 : 0;
+    }
+    report.rHeldOutMse = rSquaredError / static_cast<double>(iHeldOut * iOutputs);
+    report.rFidelity = rVariance > 0.0 ? 1.0 - rSquaredError / rVariance : (rSquaredError == 0.0 ? 1.0 : 0.0);
+    report.rAgreement = static_cast<double>(iAgreeing) / static_cast<double>(iHeldOut);
+
+    measureLatency(m_teacher, heldOutInputs, iHeldOut, settings.iLatencyRepeats,
+                   report.rTeacherMicroseconds, report.rTeacherBatchMicroseconds);
+    measureLatency(compiled, heldOutInputs, iHeldOut, settings.iLatencyRepeats,
+                   report.rStudentMicroseconds, report.rStudentBatchMicroseconds);
+    m_report = move(report);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getReport
+//【函数功能】获取最近一次成功蒸馏的报告
+//【参数】无
+//【返回值】const DistillationReport&，报告
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const DistillationReport& Distiller::getReport() const {
+    return m_report;
+}
@@ -0,0 +1,182 @@
+//-------------------------------------------------------------
+//【文件名】Distiller.hpp
+//【功能模块和目的】知识蒸馏：用大网络（教师）的输出训练小网络（学生）的声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef Distiller_hpp
+#define Distiller_hpp
+
+#include "../model/neural_components/Network.hpp"
+#include "../model/inference_engine/CompiledNetwork.hpp"
+#include "../model/training/Trainer.hpp"
+#include "../model/training/Optimizer.hpp"
+#include "../utils/ThreadPool.hpp"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】DistillationSettings
+//【功能】一次蒸馏的训练和计时设置
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct DistillationSettings {
+    int iEpochs = 50;                // 训练轮数
+    int64_t iBatchSize = 32;         // 小批量大小
+    double rHeldOutFraction = 0.2;   // 迁移集末尾留作评估、不参与训练的比例
+    int iLatencyRepeats = 20;        // 计时时重复推理评估集的次数
+};
+
+//-------------------------------------------------------------
+//【类名】DistillationReport
+//【功能】一次蒸馏的结果：学生与教师的规模、推理延迟和学生对教师的拟合程度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct DistillationReport {
+    int64_t iTeacherParameters = 0;        // 教师的扁平参数个数（Trainer的稠密布局，与推理计算量成正比）
+    int64_t iStudentParameters = 0;        // 学生的扁平参数个数
+    int64_t iTrainingRows = 0;
+    int64_t iHeldOutRows = 0;
+    vector<double> epochLosses;            // 每轮训练的均方误差（相对教师输出）
+    double rHeldOutMse = 0.0;              // 评估集上学生与教师输出的均方误差
+    double rFidelity = 0.0;                // 1 - 均方误差 / 教师输出的方差（决定系数，1为完全一致）
+    double rAgreement = 0.0;               // 评估集上最大输出下标与教师相同的比例（单输出时为1）
+    double rTeacherMicroseconds = 0.0;     // 教师逐个样本推理的平均延迟（CompiledNetwork::predict）
+    double rStudentMicroseconds = 0.0;     // 学生逐个样本推理的平均延迟
+    double rTeacherBatchMicroseconds = 0.0;  // 教师整批推理时每个样本的平均耗时（单线程predictBatch）
+    double rStudentBatchMicroseconds = 0.0;  // 学生整批推理时每个样本的平均耗时
+};
+
+//-------------------------------------------------------------
+//【类名】Distiller
+//【功能】知识蒸馏：教师网络在迁移输入集上整批推理得到软目标，学生网络以均方误差拟合这些输出，
+//       结束后报告学生与教师的参数个数、推理延迟和拟合程度，供权衡速度与精度
+//【说明】迁移输入可以是实际样本（setTransferInputs），也可以在给定区间内均匀合成
+//       （synthesizeTransferInputs）。教师输出只在设置输入时由CompiledNetwork::predictBatch
+//       在线程池上计算一次，之后蒸馏多个学生时重复使用。迁移集末尾的rHeldOutFraction部分
+//       不参与训练，用于评估学生和计时，实际样本按时间等顺序排列时应先打乱。
+//       学生以ReductionMode::Deterministic的数据并行小批量训练，结果与线程数无关。
+//       延迟在调用线程上测量，逐个样本和整批两种方式分别对应在线服务和离线批处理
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class Distiller {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】Distiller
+    //【函数功能】构造函数，编译教师网络
+    //【参数】teacher：教师网络（之后不再引用）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit Distiller(const Network& teacher);
+
+    //-------------------------------------------------------------
+    //【函数名称】isReady
+    //【函数功能】判断教师网络是否编译成功
+    //【参数】无
+    //【返回值】bool，编译成功时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isReady() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取教师网络的输入个数
+    //【参数】无
+    //【返回值】int64_t，输入个数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getOutputSize
+    //【函数功能】获取教师网络的输出个数
+    //【参数】无
+    //【返回值】int64_t，输出个数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getOutputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】setTransferInputs
+    //【函数功能】设置迁移输入集，并用教师网络整批推理得到目标
+    //【参数】inputs：rows×getInputSize()个行主序输入，rows：样本数，pool：线程池
+    //【返回值】bool，教师可用、rows至少为2且长度一致时返回true；失败时原迁移集不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool setTransferInputs(const vector<double>& inputs, int64_t rows, ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】synthesizeTransferInputs
+    //【函数功能】在[low, high]内均匀生成迁移输入集，并用教师网络整批推理得到目标
+    //【参数】rows：样本数，low、high：输入的取值区间，seed：随机数种子，pool：线程池
+    //【返回值】bool，是否成功（条件同setTransferInputs，且low < high）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool synthesizeTransferInputs(int64_t rows, double low, double high, uint64_t seed, ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】getTransferRows
+    //【函数功能】获取迁移集的样本数
+    //【参数】无
+    //【返回值】int64_t，样本数（未设置时为0）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getTransferRows() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getTransferTargets
+    //【函数功能】获取教师在迁移集上的输出
+    //【参数】无
+    //【返回值】const vector<double>&，rows×getOutputSize()个行主序输出
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<double>& getTransferTargets() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】distill
+    //【函数功能】训练学生网络拟合教师输出，把参数写回学生网络并生成报告
+    //【参数】student：学生网络（输入输出个数与教师相同，结构任意），optimizer：学生使用的优化器
+    //       （为空时使用Trainer默认的SGD），settings：训练和计时设置，pool：线程池
+    //【返回值】bool，已设置迁移集、学生尺寸匹配且训练集和评估集都不为空时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool distill(Network& student, unique_ptr<Optimizer> optimizer, const DistillationSettings& settings,
+                 ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】getReport
+    //【函数功能】获取最近一次成功蒸馏的报告
+    //【参数】无
+    //【返回值】const DistillationReport&，报告
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const DistillationReport& getReport() const;
+
+private:
+    CompiledNetwork m_teacher;
+    int64_t m_iTeacherParameters;
+    vector<double> m_inputs;   // Transfer inputs, row-major
+    vector<double> m_targets;  // Teacher outputs for m_inputs
+    int64_t m_iRows;
+    DistillationReport m_report;
+};
+
+#endif // Distiller_hpp
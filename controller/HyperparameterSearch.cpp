@@ -0,0 +1,291 @@
+//-------------------------------------------------------------
+//【文件名】HyperparameterSearch.cpp
+//【功能模块和目的】并行训练多个候选配置、逐轮淘汰的超参数搜索实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "HyperparameterSearch.hpp"
+#include "../model/neural_components/Layer.hpp"
+#include "../model/neural_components/Neuron.hpp"
+#include "../model/neural_components/Synapse.hpp"
+#include "../model/activation_functions/ActivationFunction.hpp"
+#include "../exporter/ANNExporter.hpp"
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// Divergent candidates rank after every finite loss
+double rankingLoss(const SearchResult& result) {
+    const double rLoss = result.validationLosses.empty() ? numeric_limits<double>::infinity()
+                                                         : result.validationLosses.back();
+    return isfinite(rLoss) ? rLoss : numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】HyperparameterSearch
+//【函数功能】构造函数
+//【参数】inputSize：输入个数，outputSize：输出个数，hiddenLayers：隐藏层数，seed：初始权重种子
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+HyperparameterSearch::HyperparameterSearch(int inputSize, int outputSize, int hiddenLayers, uint64_t seed)
+    : m_iInputSize(inputSize), m_iOutputSize(outputSize), m_iHiddenLayers(max(1, hiddenLayers)), m_uSeed(seed) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】addCandidate
+//【函数功能】加入一个候选配置
+//【参数】candidate：候选配置
+//【返回值】bool，是否加入
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool HyperparameterSearch::addCandidate(const SearchCandidate& candidate) {
+    if (!(candidate.rLearningRate > 0.0) || candidate.iHiddenWidth < 1 ||
+        !createActivationFunction(candidate.activation)) {
+        return false;
+    }
+    m_candidates.push_back(candidate);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】addGrid
+//【函数功能】加入全部组合
+//【参数】learningRates：学习率，widths：宽度，activations：激活函数名称
+//【返回值】int，加入的候选数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int HyperparameterSearch::addGrid(const vector<double>& learningRates, const vector<int>& widths,
+                                  const vector<string>& activations) {
+    int iAdded = 0;
+    for (const string& activation : activations) {
+        for (int iWidth : widths) {
+            for (double rLearningRate : learningRates) {
+                SearchCandidate candidate;
+                candidate.rLearningRate = rLearningRate;
+                candidate.iHiddenWidth = iWidth;
+                candidate.activation = activation;
+                iAdded += addCandidate(candidate) ? 1 : 0;
+            }
+        }
+    }
+    return iAdded;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getCandidateCount
+//【函数功能】获取候选数
+//【参数】无
+//【返回值】int，候选数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int HyperparameterSearch::getCandidateCount() const {
+    return static_cast<int>(m_candidates.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】run
+//【函数功能】训练并逐轮淘汰所有候选
+//【参数】inputs、targets：训练样本，rows：样本数，validationInputs、validationTargets：验证样本，
+//       validationRows：验证样本数，batchSize：小批量大小，epochsPerRound：每轮训练的轮数，
+//       rounds：轮数，survivorFraction：保留比例，pool：线程池
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool HyperparameterSearch::run(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                               const vector<double>& validationInputs, const vector<double>& validationTargets,
+                               int64_t validationRows, int64_t batchSize, int epochsPerRound, int rounds,
+                               double survivorFraction, ThreadPool& pool) {
+    m_results.clear();
+    if (m_candidates.empty() || rows <= 0 || validationRows <= 0 || epochsPerRound < 1 || rounds < 1 ||
+        static_cast<int64_t>(inputs.size()) != rows * m_iInputSize ||
+        static_cast<int64_t>(targets.size()) != rows * m_iOutputSize ||
+        static_cast<int64_t>(validationInputs.size()) != validationRows * m_iInputSize ||
+        static_cast<int64_t>(validationTargets.size()) != validationRows * m_iOutputSize) {
+        return false;
+    }
+
+    vector<unique_ptr<Trainer>> trainers;
+    m_results.resize(m_candidates.size());
+    for (size_t uIdx = 0; uIdx < m_candidates.size(); ++uIdx) {
+        SearchResult& result = m_results[uIdx];
+        result.candidate = m_candidates[uIdx];
+        result.network = buildNetwork(m_iInputSize, m_iOutputSize, m_iHiddenLayers, result.candidate, m_uSeed);
+        trainers.emplace_back(new Trainer());
+        trainers.back()->getOptimizer().setLearningRate(result.candidate.rLearningRate);
+        if (!result.network || !trainers.back()->loadFrom(*result.network)) {
+            m_results.clear();
+            return false;
+        }
+    }
+
+    vector<int> active(m_candidates.size());
+    for (size_t uIdx = 0; uIdx < active.size(); ++uIdx) {
+        active[uIdx] = static_cast<int>(uIdx);
+    }
+    const double rFraction = min(1.0, max(0.0, survivorFraction));
+    for (int iRound = 0; iRound < rounds; ++iRound) {
+        // Tasks are claimed in order: start the most expensive candidates first
+        stable_sort(active.begin(), active.end(), [&trainers](int iLeft, int iRight) {
+            return trainers[iLeft]->getParameterCount() > trainers[iRight]->getParameterCount();
+        });
+        pool.parallelFor(static_cast<int64_t>(active.size()), [&](int64_t iTask, int) {
+            const int iCandidate = active[iTask];
+            Trainer& trainer = *trainers[iCandidate];
+            SearchResult& result = m_results[iCandidate];
+            for (int iEpoch = 0; iEpoch < epochsPerRound; ++iEpoch) {
+                trainer.trainEpoch(inputs, targets, rows, batchSize);
+            }
+            result.iEpochsTrained += epochsPerRound;
+            result.validationLosses.push_back(trainer.evaluate(validationInputs, validationTargets, validationRows));
+        });
+        if (iRound + 1 == rounds) {
+            break;
+        }
+
+        // Successive halving: the rest of the budget goes to the best part of the population
+        stable_sort(active.begin(), active.end(), [this](int iLeft, int iRight) {
+            const double rLeft = rankingLoss(m_results[iLeft]);
+            const double rRight = rankingLoss(m_results[iRight]);
+            return rLeft < rRight || (rLeft == rRight && iLeft < iRight);
+        });
+        const size_t uKeep = max<size_t>(1, static_cast<size_t>(ceil(active.size() * rFraction)));
+        for (size_t uIdx = uKeep; uIdx < active.size(); ++uIdx) {
+            m_results[active[uIdx]].bStoppedEarly = true;
+        }
+        active.resize(min(uKeep, active.size()));
+    }
+
+    for (size_t uIdx = 0; uIdx < trainers.size(); ++uIdx) {
+        trainers[uIdx]->writeTo(*m_results[uIdx].network);
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResults
+//【函数功能】获取各候选的结果
+//【参数】无
+//【返回值】const vector<SearchResult>&，结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<SearchResult>& HyperparameterSearch::getResults() const {
+    return m_results;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getRanking
+//【函数功能】获取排名
+//【参数】无
+//【返回值】vector<int>，结果下标
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<int> HyperparameterSearch::getRanking() const {
+    vector<int> ranking(m_results.size());
+    for (size_t uIdx = 0; uIdx < ranking.size(); ++uIdx) {
+        ranking[uIdx] = static_cast<int>(uIdx);
+    }
+    stable_sort(ranking.begin(), ranking.end(), [this](int iLeft, int iRight) {
+        const SearchResult& left = m_results[iLeft];
+        const SearchResult& right = m_results[iRight];
+        if (left.iEpochsTrained != right.iEpochsTrained) {
+            return left.iEpochsTrained > right.iEpochsTrained;
+        }
+        return rankingLoss(left) < rankingLoss(right);
+    });
+    return ranking;
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportWinners
+//【函数功能】写出排名靠前的网络
+//【参数】prefix：文件名前缀，count：写出的个数
+//【返回值】int，成功写出的文件数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int HyperparameterSearch::exportWinners(const string& prefix, int count) const {
+    const vector<int> ranking = getRanking();
+    ANNExporter exporter;
+    int iWritten = 0;
+    for (int iRank = 0; iRank < count && iRank < static_cast<int>(ranking.size()); ++iRank) {
+        const SearchResult& result = m_results[ranking[iRank]];
+        if (result.network && exporter.exportNetwork(*result.network, prefix + to_string(iRank + 1) + ".ANN")) {
+            ++iWritten;
+        }
+    }
+    return iWritten;
+}
+
+//-------------------------------------------------------------
+//【函数名称】buildNetwork
+//【函数功能】按候选配置构造全连接网络
+//【参数】inputSize：输入个数，outputSize：输出个数，hiddenLayers：隐藏层数，candidate：候选配置，seed：种子
+//【返回值】unique_ptr<Network>，网络，参数无效时为nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+unique_ptr<Network> HyperparameterSearch::buildNetwork(int inputSize, int outputSize, int hiddenLayers,
+                                                       const SearchCandidate& candidate, uint64_t seed) {
+    if (inputSize < 1 || outputSize < 1 || hiddenLayers < 1 || candidate.iHiddenWidth < 1 ||
+        !createActivationFunction(candidate.activation)) {
+        return nullptr;
+    }
+    vector<int> widths(static_cast<size_t>(hiddenLayers) + 2, candidate.iHiddenWidth);
+    widths.front() = inputSize;
+    widths.back() = outputSize;
+
+    unique_ptr<Network> network(new Network("Search " + candidate.activation + " " +
+                                            to_string(candidate.iHiddenWidth)));
+    for (size_t uLayerIdx = 0; uLayerIdx < widths.size(); ++uLayerIdx) {
+        const bool bHidden = uLayerIdx > 0 && uLayerIdx + 1 < widths.size();
+        unique_ptr<Layer> layer(new Layer());
+        for (int iNeuronIdx = 0; iNeuronIdx < widths[uLayerIdx]; ++iNeuronIdx) {
+            unique_ptr<Neuron> neuron(new Neuron(0.0, createActivationFunction(bHidden ? candidate.activation : "Linear")));
+            if (uLayerIdx == 0) {
+                neuron->addInputSynapse(unique_ptr<Synapse>(new Synapse(1.0, nullptr, neuron.get(), false)));
+            }
+            layer->addNeuron(move(neuron));
+        }
+        network->addLayer(move(layer));
+    }
+
+    // Glorot-uniform weights; the same width starts from the same weights for every learning rate
+    mt19937_64 random(seed ^ (static_cast<uint64_t>(candidate.iHiddenWidth) * 0x9E3779B97F4A7C15ULL));
+    for (size_t uLayerIdx = 1; uLayerIdx < widths.size(); ++uLayerIdx) {
+        const double rLimit = sqrt(6.0 / (widths[uLayerIdx - 1] + widths[uLayerIdx]));
+        uniform_real_distribution<double> weight(-rLimit, rLimit);
+        vector<vector<double>> weights(static_cast<size_t>(widths[uLayerIdx - 1]),
+                                       vector<double>(static_cast<size_t>(widths[uLayerIdx])));
+        for (vector<double>& row : weights) {
+            for (double& rWeight : row) {
+                rWeight = weight(random);
+            }
+        }
+        if (!network->getLayer(static_cast<int>(uLayerIdx) - 1)
+                 ->connectToLayer(*network->getLayer(static_cast<int>(uLayerIdx)), weights)) {
+            return nullptr;
+        }
+    }
+    Layer* pOutput = network->getLayer(static_cast<int>(widths.size()) - 1);
+    for (int iNeuronIdx = 0; iNeuronIdx < pOutput->getNeuronCount(); ++iNeuronIdx) {
+        Neuron* pNeuron = pOutput->getNeuron(iNeuronIdx);
+        pNeuron->addOutputSynapse(unique_ptr<Synapse>(new Synapse(1.0, pNeuron, nullptr, true)));
+    }
+    return network;
+}
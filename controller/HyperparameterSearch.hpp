@@ -0,0 +1,171 @@
+//-------------------------------------------------------------
+//【文件名】HyperparameterSearch.hpp
+//【功能模块和目的】并行训练多个候选配置、逐轮淘汰的超参数搜索声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef HyperparameterSearch_hpp
+#define HyperparameterSearch_hpp
+
+#include "../model/neural_components/Network.hpp"
+#include "../model/training/Trainer.hpp"
+#include "../utils/ThreadPool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】SearchCandidate
+//【功能】一组待比较的超参数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct SearchCandidate {
+    double rLearningRate = 0.01;    // SGD学习率
+    int iHiddenWidth = 16;          // 每个隐藏层的神经元数
+    string activation = "Sigmoid";  // 隐藏层激活函数名称（见createActivationFunction）
+};
+
+//-------------------------------------------------------------
+//【类名】SearchResult
+//【功能】一个候选配置的搜索结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct SearchResult {
+    SearchCandidate candidate;
+    vector<double> validationLosses;  // 每一轮结束时的验证误差（发散时为inf或nan）
+    int64_t iEpochsTrained = 0;
+    bool bStoppedEarly = false;       // 在某一轮后被淘汰
+    unique_ptr<Network> network;      // 训练结束（或被淘汰）时的参数已写回
+};
+
+//-------------------------------------------------------------
+//【类名】HyperparameterSearch
+//【功能】为同一数据集构造多个候选网络（输入层、hiddenLayers个隐藏层、线性输出层），
+//       分轮训练：每轮所有存活的候选各训练epochsPerRound轮并计算验证误差，
+//       之后只保留验证误差最低的一部分，其余提前停止；最后按验证误差排名，用ANNExporter写出前几名
+//【说明】每个候选在一个线程中单线程训练（Trainer::trainEpoch不带ThreadPool），候选之间并行，
+//       不会在池中再套池造成超额订阅。ThreadPool的执行者从共享计数器领取下一个任务，
+//       先完成的线程立即接手剩余候选，效果与工作窃取相同；每轮按参数个数从大到小排列任务，
+//       最慢的候选最先开始，减少一轮末尾的空等。每个候选的结果只取决于它的配置和种子，
+//       与线程数和调度顺序无关。初始权重按Glorot均匀分布，由种子和网络宽度确定，
+//       同一宽度、不同学习率的候选从相同的权重出发
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class HyperparameterSearch {
+public:
+    static const uint64_t DEFAULT_SEED = 20261018;  // 默认的初始权重种子
+
+    //-------------------------------------------------------------
+    //【函数名称】HyperparameterSearch
+    //【函数功能】构造函数
+    //【参数】inputSize：输入个数，outputSize：输出个数，hiddenLayers：隐藏层数（小于1时按1处理），
+    //       seed：初始权重种子
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    HyperparameterSearch(int inputSize, int outputSize, int hiddenLayers = 1, uint64_t seed = DEFAULT_SEED);
+
+    //-------------------------------------------------------------
+    //【函数名称】addCandidate
+    //【函数功能】加入一个候选配置
+    //【参数】candidate：候选配置
+    //【返回值】bool，学习率为正、宽度至少为1且激活函数名称有效时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool addCandidate(const SearchCandidate& candidate);
+
+    //-------------------------------------------------------------
+    //【函数名称】addGrid
+    //【函数功能】加入学习率、宽度、激活函数的全部组合
+    //【参数】learningRates：学习率，widths：隐藏层宽度，activations：激活函数名称
+    //【返回值】int，加入的候选数（无效的组合被跳过）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int addGrid(const vector<double>& learningRates, const vector<int>& widths, const vector<string>& activations);
+
+    //-------------------------------------------------------------
+    //【函数名称】getCandidateCount
+    //【函数功能】获取候选数
+    //【参数】无
+    //【返回值】int，候选数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getCandidateCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】run
+    //【函数功能】训练并逐轮淘汰所有候选（丢弃上一次run的结果）
+    //【参数】inputs、targets：rows个训练样本（行主序），validationInputs、validationTargets：
+    //       validationRows个验证样本，batchSize：小批量大小，epochsPerRound：每轮训练的轮数，
+    //       rounds：轮数，survivorFraction：每轮（最后一轮除外）保留的比例（至少保留1个），pool：线程池
+    //【返回值】bool，有候选且数据尺寸与网络一致时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool run(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+             const vector<double>& validationInputs, const vector<double>& validationTargets, int64_t validationRows,
+             int64_t batchSize, int epochsPerRound, int rounds, double survivorFraction, ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】getResults
+    //【函数功能】获取各候选的结果（顺序与加入顺序相同）
+    //【参数】无
+    //【返回值】const vector<SearchResult>&，结果
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<SearchResult>& getResults() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getRanking
+    //【函数功能】获取排名：训练轮数多的在前，轮数相同时最后的验证误差低的在前
+    //【参数】无
+    //【返回值】vector<int>，结果下标，第一名在最前
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<int> getRanking() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】exportWinners
+    //【函数功能】用ANNExporter把排名前count的网络写为prefix + 名次（1起） + ".ANN"
+    //【参数】prefix：文件名前缀，count：写出的个数
+    //【返回值】int，成功写出的文件数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int exportWinners(const string& prefix, int count) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】buildNetwork
+    //【函数功能】按候选配置构造全连接网络
+    //【参数】inputSize：输入个数，outputSize：输出个数，hiddenLayers：隐藏层数，
+    //       candidate：候选配置，seed：初始权重种子
+    //【返回值】unique_ptr<Network>，网络；参数无效时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static unique_ptr<Network> buildNetwork(int inputSize, int outputSize, int hiddenLayers,
+                                            const SearchCandidate& candidate, uint64_t seed);
+
+private:
+    int m_iInputSize;
+    int m_iOutputSize;
+    int m_iHiddenLayers;
+    uint64_t m_uSeed;
+    vector<SearchCandidate> m_candidates;
+    vector<SearchResult> m_results;
+};
+
+#endif // HyperparameterSearch_hpp
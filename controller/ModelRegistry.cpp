@@ -0,0 +1,442 @@
+//-------------------------------------------------------------
+//【文件名】ModelRegistry.cpp
+//【功能模块和目的】多模型注册表（按内存预算LRU淘汰）及模型句柄实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ModelRegistry.hpp"
+#include "../importer/ANNImporter.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】loadFromFile
+//【函数功能】默认加载函数：把注册键当作ANN文件路径导入
+//【参数】path：文件路径
+//【返回值】unique_ptr<Network>，失败返回nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+static unique_ptr<Network> loadFromFile(const string& path) {
+    ANNImporter importer;
+    return importer.importNetwork(path);
+}
+
+//-------------------------------------------------------------
+//【函数名称】ModelHandle
+//【函数功能】默认构造函数，创建空句柄
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelHandle::ModelHandle() {
+}
+
+//-------------------------------------------------------------
+//【函数名称】ModelHandle
+//【函数功能】构造指向指定模型的句柄
+//【参数】key：注册键，model：编译模型
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelHandle::ModelHandle(const string& key, shared_ptr<const CompiledNetwork> model)
+    : m_key(key), m_model(model) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~ModelHandle
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelHandle::~ModelHandle() = default;
+
+//-------------------------------------------------------------
+//【函数名称】isValid
+//【函数功能】判断句柄是否指向模型
+//【参数】无
+//【返回值】bool，非空返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ModelHandle::isValid() const {
+    return m_model != nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】predict
+//【函数功能】在句柄指向的模型上推理
+//【参数】inputs：输入向量
+//【返回值】vector<double>，输出向量
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> ModelHandle::predict(const vector<double>& inputs) const {
+    if (!m_model) {
+        throw runtime_error("Model handle is empty");
+    }
+    return m_model->predict(inputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】getKey
+//【函数功能】获取注册键
+//【参数】无
+//【返回值】const string&，注册键
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const string& ModelHandle::getKey() const {
+    return m_key;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取模型输入长度
+//【参数】无
+//【返回值】int64_t，输入长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelHandle::getInputSize() const {
+    return m_model ? m_model->getInputSize() : 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResidentBytes
+//【函数功能】获取模型占用的内存字节数
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelHandle::getResidentBytes() const {
+    return m_model ? m_model->getResidentBytes() : 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】ModelRegistry
+//【函数功能】构造函数
+//【参数】memoryBudget：内存预算（字节）
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelRegistry::ModelRegistry(int64_t memoryBudget)
+    : m_loader(loadFromFile), m_bCustomLoader(false), m_iMemoryBudget(memoryBudget), m_iResidentBytes(0),
+      m_iHitCount(0), m_iMissCount(0), m_iEvictionCount(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~ModelRegistry
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelRegistry::~ModelRegistry() = default;
+
+//-------------------------------------------------------------
+//【函数名称】evictToBudget
+//【函数功能】从最久未使用的模型开始淘汰，直到满足预算
+//【参数】keep：不得淘汰的键
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ModelRegistry::evictToBudget(const string& keep) {
+    while (m_iResidentBytes > m_iMemoryBudget && !m_recency.empty()) {
+        const string& victim = m_recency.back();
+        if (victim == keep) {
+            break; // Only the model being served is left
+        }
+        map<string, Entry>::iterator it = m_entries.find(victim);
+        m_iResidentBytes -= it->second.iBytes;
+        m_entries.erase(it);
+        m_recency.pop_back();
+        ++m_iEvictionCount;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】acquire
+//【函数功能】获取模型句柄，未驻留时导入并编译
+//【参数】key：模型名称或路径
+//【返回值】ModelHandle，失败时为空句柄
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 设置了编译模型缓存且使用默认加载函数时经由缓存加载
+//-------------------------------------------------------------
+ModelHandle ModelRegistry::acquire(const string& key) {
+    Loader loader;
+    shared_ptr<CompiledModelCache> cache;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        map<string, Entry>::iterator it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_recency.splice(m_recency.begin(), m_recency, it->second.position);
+            ++m_iHitCount;
+            return ModelHandle(key, it->second.model);
+        }
+        ++m_iMissCount;
+        loader = m_loader;
+        if (!m_bCustomLoader) {
+            cache = m_importCache;
+        }
+    }
+
+    // Import and compile without holding the lock so other models stay servable
+    shared_ptr<const CompiledNetwork> compiled;
+    if (cache) {
+        compiled = cache->load(key);
+    } else {
+        try {
+            unique_ptr<Network> network = loader(key);
+            shared_ptr<CompiledNetwork> fresh(new CompiledNetwork());
+            if (network && fresh->compile(*network)) {
+                compiled = fresh;
+            }
+        }
+        catch (const exception&) {
+            return ModelHandle();
+        }
+    }
+    if (!compiled) {
+        return ModelHandle();
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    map<string, Entry>::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        // Another thread loaded the same key meanwhile; serve the resident copy
+        m_recency.splice(m_recency.begin(), m_recency, it->second.position);
+        return ModelHandle(key, it->second.model);
+    }
+    Entry entry;
+    entry.model = compiled;
+    entry.iBytes = compiled->getResidentBytes();
+    m_recency.push_front(key);
+    entry.position = m_recency.begin();
+    m_entries[key] = entry;
+    m_iResidentBytes += entry.iBytes;
+    evictToBudget(key);
+    return ModelHandle(key, compiled);
+}
+
+//-------------------------------------------------------------
+//【函数名称】addModel
+//【函数功能】编译已在内存中的网络并以指定键加入注册表
+//【参数】key：注册键，network：源网络
+//【返回值】bool，编译成功返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ModelRegistry::addModel(const string& key, const Network& network) {
+    shared_ptr<CompiledNetwork> compiled(new CompiledNetwork());
+    if (!compiled->compile(network)) {
+        return false;
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    map<string, Entry>::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_iResidentBytes -= it->second.iBytes;
+        m_recency.erase(it->second.position);
+        m_entries.erase(it);
+    }
+    Entry entry;
+    entry.model = compiled;
+    entry.iBytes = compiled->getResidentBytes();
+    m_recency.push_front(key);
+    entry.position = m_recency.begin();
+    m_entries[key] = entry;
+    m_iResidentBytes += entry.iBytes;
+    evictToBudget(key);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】evict
+//【函数功能】从注册表移除指定模型
+//【参数】key：注册键
+//【返回值】bool，模型曾驻留返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ModelRegistry::evict(const string& key) {
+    lock_guard<mutex> lock(m_mutex);
+    map<string, Entry>::iterator it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    m_iResidentBytes -= it->second.iBytes;
+    m_recency.erase(it->second.position);
+    m_entries.erase(it);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】clear
+//【函数功能】移除全部模型
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ModelRegistry::clear() {
+    lock_guard<mutex> lock(m_mutex);
+    m_entries.clear();
+    m_recency.clear();
+    m_iResidentBytes = 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】contains
+//【函数功能】判断模型当前是否驻留
+//【参数】key：注册键
+//【返回值】bool，驻留返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ModelRegistry::contains(const string& key) const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_entries.find(key) != m_entries.end();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResidentKeys
+//【函数功能】获取驻留模型的键，最近使用在前
+//【参数】无
+//【返回值】vector<string>，键列表
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<string> ModelRegistry::getResidentKeys() const {
+    lock_guard<mutex> lock(m_mutex);
+    return vector<string>(m_recency.begin(), m_recency.end());
+}
+
+//-------------------------------------------------------------
+//【函数名称】setLoader
+//【函数功能】设置由键生成网络的加载函数
+//【参数】loader：加载函数，为空时恢复默认
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ModelRegistry::setLoader(Loader loader) {
+    lock_guard<mutex> lock(m_mutex);
+    m_bCustomLoader = static_cast<bool>(loader);
+    m_loader = loader ? loader : Loader(loadFromFile);
+}
+
+//-------------------------------------------------------------
+//【函数名称】setImportCache
+//【函数功能】设置编译模型缓存
+//【参数】cache：编译模型缓存，为空时关闭
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ModelRegistry::setImportCache(shared_ptr<CompiledModelCache> cache) {
+    lock_guard<mutex> lock(m_mutex);
+    m_importCache = cache;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setMemoryBudget
+//【函数功能】设置内存预算并淘汰超出部分
+//【参数】memoryBudget：预算字节数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ModelRegistry::setMemoryBudget(int64_t memoryBudget) {
+    lock_guard<mutex> lock(m_mutex);
+    m_iMemoryBudget = memoryBudget;
+    evictToBudget(m_recency.empty() ? string() : m_recency.front());
+}
+
+//-------------------------------------------------------------
+//【函数名称】getMemoryBudget
+//【函数功能】获取内存预算
+//【参数】无
+//【返回值】int64_t，预算字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelRegistry::getMemoryBudget() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_iMemoryBudget;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResidentBytes
+//【函数功能】获取驻留模型占用的总字节数
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelRegistry::getResidentBytes() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_iResidentBytes;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getModelCount
+//【函数功能】获取驻留模型数量
+//【参数】无
+//【返回值】size_t，数量
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+size_t ModelRegistry::getModelCount() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getHitCount
+//【函数功能】获取命中次数
+//【参数】无
+//【返回值】int64_t，次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelRegistry::getHitCount() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_iHitCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getMissCount
+//【函数功能】获取未命中次数
+//【参数】无
+//【返回值】int64_t，次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelRegistry::getMissCount() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_iMissCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getEvictionCount
+//【函数功能】获取淘汰次数
+//【参数】无
+//【返回值】int64_t，次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ModelRegistry::getEvictionCount() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_iEvictionCount;
+}
@@ -0,0 +1,384 @@
+//-------------------------------------------------------------
+//【文件名】ModelRegistry.hpp
+//【功能模块和目的】多模型注册表（按内存预算LRU淘汰）及模型句柄声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef ModelRegistry_hpp
+#define ModelRegistry_hpp
+
+#include "../model/neural_components/Network.hpp"
+#include "../model/inference_engine/CompiledNetwork.hpp"
+#include "../importer/CompiledModelCache.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ModelHandle
+//【功能】注册表中一个模型的推理句柄
+//【说明】句柄持有编译模型的共享所有权，模型被淘汰后句柄仍可继续推理，直到句柄销毁；
+//       predict为const，可在多个线程中同时使用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class ModelHandle {
+private:
+    string m_key;                                // Registry key the model was loaded under
+    shared_ptr<const CompiledNetwork> m_model;   // Null for an empty handle
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】ModelHandle
+    //【函数功能】默认构造函数，创建空句柄
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelHandle();
+    
+    //-------------------------------------------------------------
+    //【函数名称】ModelHandle
+    //【函数功能】构造指向指定模型的句柄
+    //【参数】key：注册键，model：编译模型
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelHandle(const string& key, shared_ptr<const CompiledNetwork> model);
+    
+    //-------------------------------------------------------------
+    //【函数名称】ModelHandle（拷贝构造）
+    //【函数功能】拷贝构造函数，与原句柄共享模型
+    //【参数】other：被拷贝的句柄
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelHandle(const ModelHandle& other) = default;
+    
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源句柄
+    //【返回值】ModelHandle&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelHandle& operator=(const ModelHandle& other) = default;
+    
+    //-------------------------------------------------------------
+    //【函数名称】~ModelHandle
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~ModelHandle();
+    
+    //-------------------------------------------------------------
+    //【函数名称】isValid
+    //【函数功能】判断句柄是否指向模型
+    //【参数】无
+    //【返回值】bool，非空返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isValid() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】在句柄指向的模型上推理
+    //【参数】inputs：输入向量
+    //【返回值】vector<double>，输出向量；空句柄或输入长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predict(const vector<double>& inputs) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getKey
+    //【函数功能】获取注册键
+    //【参数】无
+    //【返回值】const string&，注册键
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const string& getKey() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取模型输入长度
+    //【参数】无
+    //【返回值】int64_t，输入长度，空句柄为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getResidentBytes
+    //【函数功能】获取模型占用的内存字节数
+    //【参数】无
+    //【返回值】int64_t，字节数，空句柄为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getResidentBytes() const;
+};
+
+//-------------------------------------------------------------
+//【类名】ModelRegistry
+//【功能】按名称或路径管理多个已编译模型，超出内存预算时淘汰最久未使用的模型
+//【说明】默认把键当作ANN文件路径导入，可用setLoader改为按名称查找等其他来源。
+//       注册表只保存编译模型（不保留对象图），内存按CompiledNetwork::getResidentBytes计算；
+//       最近访问的模型即使单独超出预算也会保留。所有公有方法可在多线程中调用，
+//       模型的导入和编译在锁外进行
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 默认加载函数可经由CompiledModelCache读取已编译的缓存文件
+//-------------------------------------------------------------
+class ModelRegistry {
+public:
+    typedef function<unique_ptr<Network>(const string&)> Loader;  // 由注册键生成网络
+    
+    static const int64_t DEFAULT_MEMORY_BUDGET = 256LL * 1024 * 1024;  // 默认预算256 MiB
+
+private:
+    //-------------------------------------------------------------
+    //【类名】Entry
+    //【功能】一个驻留模型及其在LRU链表中的位置
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    struct Entry {
+        shared_ptr<const CompiledNetwork> model;  // Compiled model
+        list<string>::iterator position;          // Node in m_recency
+        int64_t iBytes;                           // Resident size charged to the budget
+    };
+    
+    mutable mutex m_mutex;          // Guards every member below
+    map<string, Entry> m_entries;   // Resident models by key
+    list<string> m_recency;         // Keys, most recently used first
+    Loader m_loader;                // Key to network
+    bool m_bCustomLoader;           // True once setLoader() installed a non-default loader
+    shared_ptr<CompiledModelCache> m_importCache;  // Used for path keys when set
+    int64_t m_iMemoryBudget;        // Budget in bytes
+    int64_t m_iResidentBytes;       // Sum of resident model sizes
+    int64_t m_iHitCount;            // acquire() calls served from memory
+    int64_t m_iMissCount;           // acquire() calls that had to load
+    int64_t m_iEvictionCount;       // Models dropped to respect the budget
+    
+    //-------------------------------------------------------------
+    //【函数名称】evictToBudget
+    //【函数功能】从最久未使用的模型开始淘汰，直到满足预算（保留keep指定的模型），调用方须持有锁
+    //【参数】keep：不得淘汰的键
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void evictToBudget(const string& keep);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】ModelRegistry
+    //【函数功能】构造函数
+    //【参数】memoryBudget：内存预算（字节）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit ModelRegistry(int64_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    
+    //-------------------------------------------------------------
+    //【函数名称】ModelRegistry（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，注册表持有互斥量）
+    //【参数】other：被拷贝的注册表
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelRegistry(const ModelRegistry& other) = delete;
+    
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源注册表
+    //【返回值】ModelRegistry&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelRegistry& operator=(const ModelRegistry& other) = delete;
+    
+    //-------------------------------------------------------------
+    //【函数名称】~ModelRegistry
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~ModelRegistry();
+    
+    //-------------------------------------------------------------
+    //【函数名称】acquire
+    //【函数功能】获取模型句柄：已驻留时直接返回并标记为最近使用，否则导入、编译后加入注册表
+    //【参数】key：模型名称或路径
+    //【返回值】ModelHandle，导入或编译失败时为空句柄
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelHandle acquire(const string& key);
+    
+    //-------------------------------------------------------------
+    //【函数名称】addModel
+    //【函数功能】编译已在内存中的网络并以指定键加入注册表（替换同键模型）
+    //【参数】key：注册键，network：源网络
+    //【返回值】bool，编译成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool addModel(const string& key, const Network& network);
+    
+    //-------------------------------------------------------------
+    //【函数名称】evict
+    //【函数功能】从注册表移除指定模型（已发出的句柄不受影响）
+    //【参数】key：注册键
+    //【返回值】bool，模型曾驻留返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool evict(const string& key);
+    
+    //-------------------------------------------------------------
+    //【函数名称】clear
+    //【函数功能】移除全部模型，统计计数保持不变
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void clear();
+    
+    //-------------------------------------------------------------
+    //【函数名称】contains
+    //【函数功能】判断模型当前是否驻留（不改变使用顺序）
+    //【参数】key：注册键
+    //【返回值】bool，驻留返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool contains(const string& key) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getResidentKeys
+    //【函数功能】获取驻留模型的键，按最近使用在前排列
+    //【参数】无
+    //【返回值】vector<string>，键列表
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<string> getResidentKeys() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】setLoader
+    //【函数功能】设置由键生成网络的加载函数
+    //【参数】loader：加载函数，为空时恢复默认（按ANN文件路径导入）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setLoader(Loader loader);
+    
+    //-------------------------------------------------------------
+    //【函数名称】setImportCache
+    //【函数功能】设置编译模型缓存：使用默认加载函数时，未驻留的模型经由缓存加载，跳过文本解析
+    //【参数】cache：编译模型缓存，为空时关闭
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setImportCache(shared_ptr<CompiledModelCache> cache);
+    
+    //-------------------------------------------------------------
+    //【函数名称】setMemoryBudget
+    //【函数功能】设置内存预算并立即淘汰超出部分
+    //【参数】memoryBudget：预算字节数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setMemoryBudget(int64_t memoryBudget);
+    
+    //-------------------------------------------------------------
+    //【函数名称】getMemoryBudget
+    //【函数功能】获取内存预算
+    //【参数】无
+    //【返回值】int64_t，预算字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getMemoryBudget() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getResidentBytes
+    //【函数功能】获取驻留模型占用的总字节数
+    //【参数】无
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getResidentBytes() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getModelCount
+    //【函数功能】获取驻留模型数量
+    //【参数】无
+    //【返回值】size_t，数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    size_t getModelCount() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getHitCount
+    //【函数功能】获取命中驻留模型的acquire次数
+    //【参数】无
+    //【返回值】int64_t，次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getHitCount() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getMissCount
+    //【函数功能】获取需要重新导入的acquire次数
+    //【参数】无
+    //【返回值】int64_t，次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getMissCount() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getEvictionCount
+    //【函数功能】获取因预算被淘汰的模型数
+    //【参数】无
+    //【返回值】int64_t，次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getEvictionCount() const;
+};
+
+#endif // ModelRegistry_hpp
@@ -8,6 +8,16 @@
 #include "NetworkController.hpp"
 #include "../importer/ANNImporter.hpp"
 #include "../exporter/ANNExporter.hpp"
+#include "../exporter/ANNBinaryExporter.hpp"
+#include "../exporter/ANNHeaderExporter.hpp"
+#include "../exporter/ANNPatchExporter.hpp"
+#include "../importer/ANNPatchApplier.hpp"
+#include "../model/inference_engine/KernelDispatch.hpp"
+#include "../model/inference_engine/PackedGemm.hpp"
+#include "../model/training/Trainer.hpp"
+#include "../model/training/Dataset.hpp"
+#include "../model/training/BatchLoader.hpp"
+#include "../utils/ThreadPool.hpp"
 #include <stdexcept>
 #include <sstream>
 
@@ -23,7 +33,7 @@ unique_ptr<NetworkController> NetworkController::m_instance = nullptr;
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-NetworkController::NetworkController() : m_network(nullptr) {
+NetworkController::NetworkController() : m_current(nullptr) {
 }
 
 //-------------------------------------------------------------
@@ -32,9 +42,13 @@ NetworkController::NetworkController() : m_network(nullptr) {
 //【参数】无
 //【返回值】无
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 先等待后台导入结束，避免工作线程访问已析构的成员
 //-------------------------------------------------------------
-NetworkController::~NetworkController() = default;
+NetworkController::~NetworkController() {
+    if (m_pendingImport.valid()) {
+        m_pendingImport.wait();
+    }
+}
 
 //-------------------------------------------------------------
 //【函数名称】getInstance
@@ -70,20 +84,232 @@ void NetworkController::cleanup() {
 //【参数】filename：文件名
 //【返回值】bool，是否导入成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 导入后编译并原子发布
 //-------------------------------------------------------------
 bool NetworkController::importNetwork(const string& filename) {
     try {
         ANNImporter importer;
-        m_network = importer.importNetwork(filename);
-        return m_network != nullptr;
+        shared_ptr<Network> network(importer.importNetwork(filename).release());
+        shared_ptr<CompiledNetwork> compiled(new CompiledNetwork());
+        publishNetwork(network, network && compiled->compile(*network) ? compiled : nullptr);
+        return network != nullptr;
+    }
+    catch (const exception&) {
+        publishNetwork(nullptr, nullptr);
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】importNetwork
+//【函数功能】从内存缓冲区导入神经网络
+//【参数】data：内容首地址，size：字节数
+//【返回值】bool，是否导入成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::importNetwork(const char* data, size_t size) {
+    try {
+        ANNImporter importer;
+        shared_ptr<Network> network(importer.importNetwork(data, size).release());
+        shared_ptr<CompiledNetwork> compiled(new CompiledNetwork());
+        publishNetwork(network, network && compiled->compile(*network) ? compiled : nullptr);
+        return network != nullptr;
+    }
+    catch (const exception&) {
+        publishNetwork(nullptr, nullptr);
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】importNetworkLazily
+//【函数功能】以延迟加载模式导入神经网络
+//【参数】filename：文件名
+//【返回值】bool，是否导入成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::importNetworkLazily(const string& filename) {
+    try {
+        ANNImporter importer;
+        importer.setLazyLoading(true);
+        // Compiling would load every layer; leave that to the first inference
+        shared_ptr<Network> network(importer.importNetwork(filename).release());
+        publishNetwork(network, nullptr);
+        return network != nullptr;
+    }
+    catch (const exception&) {
+        publishNetwork(nullptr, nullptr);
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】importNetworkAsync
+//【函数功能】在后台线程导入、验证、编译网络并原子替换当前模型
+//【参数】filename：文件名
+//【返回值】bool，任务是否已启动
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::importNetworkAsync(const string& filename) {
+    // One background import at a time, published in request order
+    if (m_pendingImport.valid()) {
+        m_pendingImport.wait();
+    }
+    
+    try {
+        m_pendingImport = async(launch::async, [this, filename]() {
+            try {
+                ANNImporter importer;
+                shared_ptr<Network> network(importer.importNetwork(filename).release());
+                shared_ptr<CompiledNetwork> compiled(new CompiledNetwork());
+                // A model that cannot serve inference never replaces the current one
+                if (!network || !compiled->compile(*network)) {
+                    return false;
+                }
+                publishNetwork(network, compiled);
+                return true;
+            }
+            catch (const exception&) {
+                return false;
+            }
+        });
+        return true;
     }
     catch (const exception&) {
-        m_network = nullptr;
         return false;
     }
 }
 
+//-------------------------------------------------------------
+//【函数名称】waitForPendingImport
+//【函数功能】等待后台导入完成
+//【参数】无
+//【返回值】bool，新模型是否已发布
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::waitForPendingImport() {
+    if (!m_pendingImport.valid()) {
+        return false;
+    }
+    return m_pendingImport.get();
+}
+
+//-------------------------------------------------------------
+//【函数名称】isImportPending
+//【函数功能】判断是否有尚未完成的后台导入
+//【参数】无
+//【返回值】bool，是否有进行中的后台导入
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::isImportPending() const {
+    return m_pendingImport.valid() &&
+           m_pendingImport.wait_for(chrono::seconds(0)) != future_status::ready;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getModelGeneration
+//【函数功能】获取当前模型版本号
+//【参数】无
+//【返回值】uint64_t，版本号
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+uint64_t NetworkController::getModelGeneration() const {
+    shared_ptr<const ModelVersion> version = atomic_load(&m_current);
+    return version ? version->generation : 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】currentNetwork
+//【函数功能】获取当前版本的网络对象
+//【参数】无
+//【返回值】shared_ptr<Network>，无网络时为空
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+shared_ptr<Network> NetworkController::currentNetwork() const {
+    shared_ptr<const ModelVersion> version = atomic_load(&m_current);
+    return version ? version->network : nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】publishNetwork
+//【函数功能】将新网络发布为当前版本
+//【参数】network：新网络，compiled：编译结果
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void NetworkController::publishNetwork(shared_ptr<Network> network, shared_ptr<const CompiledNetwork> compiled) {
+    lock_guard<mutex> lock(m_publishMutex);
+    shared_ptr<const ModelVersion> previous = atomic_load(&m_current);
+    shared_ptr<ModelVersion> version(new ModelVersion());
+    version->network = move(network);
+    version->compiled = move(compiled);
+    version->generation = previous ? previous->generation + 1 : 1;
+    atomic_store(&m_current, shared_ptr<const ModelVersion>(version));
+}
+
+//-------------------------------------------------------------
+//【函数名称】editNetwork
+//【函数功能】写时复制地编辑当前网络并发布为新版本
+//【参数】edit：编辑操作，expected：期望的当前网络（可为空）
+//【返回值】bool，是否编辑成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::editNetwork(const function<bool(Network&)>& edit, const shared_ptr<Network>& expected) {
+    lock_guard<mutex> lock(m_publishMutex);
+    shared_ptr<const ModelVersion> previous = atomic_load(&m_current);
+    if (!previous || !previous->network || (expected && previous->network != expected)) {
+        return false;
+    }
+    // Readers may hold the published network, so the edit goes to a private copy
+    shared_ptr<Network> network(new Network(*previous->network));
+    if (!edit(*network)) {
+        return false;
+    }
+    network->clearImportErrors();
+    shared_ptr<ModelVersion> version(new ModelVersion());
+    version->network = move(network);
+    version->generation = previous->generation + 1;
+    atomic_store(&m_current, shared_ptr<const ModelVersion>(version));
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】compileVersion
+//【函数功能】为尚未编译的版本生成编译结果
+//【参数】version：模型版本
+//【返回值】shared_ptr<const CompiledNetwork>，无法编译时为空
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+shared_ptr<const CompiledNetwork> NetworkController::compileVersion(const shared_ptr<const ModelVersion>& version) const {
+    // Compiling reads the object graph, so concurrent callers take turns
+    lock_guard<mutex> lock(m_publishMutex);
+    shared_ptr<const ModelVersion> latest = atomic_load(&m_current);
+    if (latest == version && latest->compiled) {
+        return latest->compiled;
+    }
+    
+    shared_ptr<CompiledNetwork> compiled(new CompiledNetwork());
+    if (!compiled->compile(*version->network)) {
+        return nullptr;
+    }
+    if (latest == version) {
+        shared_ptr<ModelVersion> updated(new ModelVersion(*version));
+        updated->compiled = compiled;
+        atomic_store(&m_current, shared_ptr<const ModelVersion>(updated));
+    }
+    return compiled;
+}
+
 //-------------------------------------------------------------
 //【函数名称】exportNetwork
 //【函数功能】导出神经网络
@@ -93,13 +319,148 @@ bool NetworkController::importNetwork(const string& filename) {
 //【更改记录】
 //-------------------------------------------------------------
 bool NetworkController::exportNetwork(const string& filename) const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return false;
     }
     
     try {
         ANNExporter exporter;
-        return exporter.exportNetwork(*m_network, filename);
+        return exporter.exportNetwork(*network, filename);
+    }
+    catch (const exception&) {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetworkToString
+//【函数功能】导出神经网络到内存字符串
+//【参数】无
+//【返回值】string，ANN格式内容，失败返回空字符串
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string NetworkController::exportNetworkToString() const {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        return "";
+    }
+    
+    try {
+        ANNExporter exporter;
+        return exporter.exportNetworkToString(*network);
+    }
+    catch (const exception&) {
+        return "";
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportCompiledNetwork
+//【函数功能】导出编译后的二进制模型
+//【参数】filename：文件名
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::exportCompiledNetwork(const string& filename) const {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        return false;
+    }
+    
+    try {
+        ANNBinaryExporter exporter;
+        return exporter.exportNetwork(*network, filename);
+    }
+    catch (const exception&) {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】setInferenceEngine
+//【函数功能】选择runInference使用的执行引擎
+//【参数】engine：执行引擎
+//【返回值】bool，是否设置成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 写时复制，发布为新版本
+//-------------------------------------------------------------
+bool NetworkController::setInferenceEngine(InferenceEngine engine) {
+    return editNetwork([engine](Network& network) {
+        network.setInferenceEngine(engine);
+        return true;
+    });
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetworkHeader
+//【函数功能】将当前神经网络生成为独立C++头文件
+//【参数】filename：文件名，namespaceName：命名空间
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::exportNetworkHeader(const string& filename, const string& namespaceName) const {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        return false;
+    }
+    
+    try {
+        ANNHeaderExporter exporter;
+        return exporter.setNamespaceName(namespaceName) && exporter.exportNetwork(*network, filename);
+    }
+    catch (const exception&) {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportPatch
+//【函数功能】导出相对于基准文件的差异补丁
+//【参数】baseFilename：基准ANN文件，patchFilename：补丁文件
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool NetworkController::exportPatch(const string& baseFilename, const string& patchFilename) const {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        return false;
+    }
+    
+    try {
+        ANNImporter importer;
+        unique_ptr<Network> base = importer.importNetwork(baseFilename);
+        if (!base) {
+            return false;
+        }
+        ANNPatchExporter exporter;
+        return exporter.exportPatch(*base, *network, patchFilename);
+    }
+    catch (const exception&) {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyPatch
+//【函数功能】在当前网络的副本上应用补丁文件，成功后发布为新版本
+//【参数】patchFilename：补丁文件
+//【返回值】bool，是否应用成功
+//【说明】每次应用都复制整个网络，代价为O(模型大小)
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 写时复制：在副本上应用补丁，成功后发布为新版本
+//-------------------------------------------------------------
+bool NetworkController::applyPatch(const string& patchFilename) {
+    try {
+        // A patch that fails part-way leaves only the discarded copy half-applied
+        return editNetwork([&patchFilename](Network& network) {
+            ANNPatchApplier applier;
+            return applier.applyPatch(network, patchFilename);
+        });
     }
     catch (const exception&) {
         return false;
@@ -112,10 +473,10 @@ bool NetworkController::exportNetwork(const string& filename) const {
 //【参数】无
 //【返回值】bool，是否存在神经网络
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 读取当前版本快照
 //-------------------------------------------------------------
 bool NetworkController::hasNetwork() const {
-    return m_network != nullptr;
+    return currentNetwork() != nullptr;
 }
 
 //-------------------------------------------------------------
@@ -127,11 +488,12 @@ bool NetworkController::hasNetwork() const {
 //【更改记录】
 //-------------------------------------------------------------
 bool NetworkController::validateNetwork() const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return false;
     }
     
-    return m_network->isValid();
+    return network->isValid();
 }
 
 //-------------------------------------------------------------
@@ -140,24 +502,45 @@ bool NetworkController::validateNetwork() const {
 //【参数】无
 //【返回值】字符串，统计信息
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 显示所用推理引擎
+//           2026-10-18 显示稠密内核的指令集级别
 //-------------------------------------------------------------
 string NetworkController::getNetworkStatistics() const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return "No network loaded.";
     }
     
     ostringstream oss;
     oss << "Network Statistics:\n";
-    oss << "  Total Layers: " << m_network->getLayerCount() << "\n";
-    oss << "  Total Neurons: " << m_network->getNeuronCount() << "\n";
-    oss << "  Total Synapses (含输入输出): " << m_network->getSynapseCount() << "\n";
-    oss << "  Valid: " << (m_network->isValid() ? "Yes" : "No");
+    oss << "  Total Layers: " << network->getLayerCount() << "\n";
+    oss << "  Total Neurons: " << network->getNeuronCount() << "\n";
+    oss << "  Total Synapses (含输入输出): " << network->getSynapseCount() << "\n";
+    oss << "  Valid: " << (network->isValid() ? "Yes" : "No") << "\n";
+    
+    // The compiled form reports whether generated code actually replaced the dense kernels
+    shared_ptr<const ModelVersion> version = atomic_load(&m_current);
+    oss << "  Inference Engine: ";
+    if (network->getInferenceEngine() == InferenceEngine::Jit) {
+        if (version->compiled && version->compiled->isJitActive()) {
+            oss << "JIT (" << version->compiled->getJitCodeBytes() << " bytes of code)";
+        } else if (version->compiled) {
+            oss << "JIT requested, using compiled kernels";
+        } else {
+            oss << "JIT (compiled on next inference)";
+        }
+    } else {
+        oss << "Compiled";
+    }
+    oss << "\n  Kernel ISA: " << KernelDispatch::getIsaName(KernelDispatch::getActiveIsa());
+    if (KernelDispatch::isOverridden()) {
+        oss << " (forced; CPU supports " << KernelDispatch::getIsaName(KernelDispatch::getDetectedIsa()) << ")";
+    }
     
     // Include import error information if any
-    if (m_network->hasImportErrors()) {
+    if (network->hasImportErrors()) {
         oss << "\n\n[IMPORT WARNINGS]\n";
-        oss << m_network->getImportErrorMessage();
+        oss << network->getImportErrorMessage();
     }
     
     return oss.str();
@@ -169,21 +552,20 @@ string NetworkController::getNetworkStatistics() const {
 //【参数】无
 //【返回值】字符串，层信息
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 不再访问层对象，避免触发延迟加载
 //-------------------------------------------------------------
 string NetworkController::getLayerInformation() const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return "No network loaded.";
     }
     
     ostringstream oss;
     oss << "Layer Information:\n";
     
-    for (int iLayerIdx = 0; iLayerIdx < m_network->getLayerCount(); ++iLayerIdx) {
-        const Layer* layer = m_network->getLayer(iLayerIdx);
-        if (layer) {
-            oss << "  Layer " << iLayerIdx << ": " << layer->getNeuronCount() << " neurons\n";
-        }
+    // Neuron counts only, so that lazily loaded weights stay on disk
+    for (int iLayerIdx = 0; iLayerIdx < network->getLayerCount(); ++iLayerIdx) {
+        oss << "  Layer " << iLayerIdx << ": " << network->getLayerNeuronCount(iLayerIdx) << " neurons\n";
     }
     
     return oss.str();
@@ -198,11 +580,12 @@ string NetworkController::getLayerInformation() const {
 //【更改记录】
 //-------------------------------------------------------------
 string NetworkController::getNeuronInformation(int layerIndex) const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return "No network loaded.";
     }
     
-    const Layer* layer = m_network->getLayer(layerIndex);
+    const Layer* layer = network->getLayer(layerIndex);
     if (!layer) {
         return "Invalid layer index.";
     }
@@ -228,11 +611,12 @@ string NetworkController::getNeuronInformation(int layerIndex) const {
 //【更改记录】
 //-------------------------------------------------------------
 string NetworkController::getNeuronConnections(int layerIndex, int neuronIndex) const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return "No network loaded.";
     }
     
-    const Layer* layer = m_network->getLayer(layerIndex);
+    const Layer* layer = network->getLayer(layerIndex);
     if (!layer) {
         return "Invalid layer index.";
     }
@@ -258,18 +642,21 @@ string NetworkController::getNeuronConnections(int layerIndex, int neuronIndex)
 //【参数】无
 //【返回值】bool，是否添加成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改成功后使当前版本的编译结果失效
+//           2026-10-18 写时复制，发布为新版本
 //-------------------------------------------------------------
 bool NetworkController::addLayer() {
-    if (!hasNetwork()) {
-        m_network = unique_ptr<Network>(new Network());
-    }
-    
     try {
-        m_network->addLayer(unique_ptr<Layer>(new Layer()));
-        // Clear import errors when network is modified
-        m_network->clearImportErrors();
-        return true;
+        if (!currentNetwork()) {
+            shared_ptr<Network> network(new Network());
+            network->addLayer(unique_ptr<Layer>(new Layer()));
+            publishNetwork(network, nullptr);
+            return true;
+        }
+        return editNetwork([](Network& network) {
+            network.addLayer(unique_ptr<Layer>(new Layer()));
+            return true;
+        });
     }
     catch (const exception&) {
         return false;
@@ -282,20 +669,14 @@ bool NetworkController::addLayer() {
 //【参数】layerIndex：层索引
 //【返回值】bool，是否删除成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改成功后使当前版本的编译结果失效
+//           2026-10-18 写时复制，发布为新版本
 //-------------------------------------------------------------
 bool NetworkController::deleteLayer(int layerIndex) {
-    if (!hasNetwork()) {
-        return false;
-    }
-    
     try {
-        bool result = m_network->removeLayer(layerIndex);
-        if (result) {
-            // Clear import errors when network is modified
-            m_network->clearImportErrors();
-        }
-        return result;
+        return editNetwork([layerIndex](Network& network) {
+            return network.removeLayer(layerIndex);
+        });
     }
     catch (const exception&) {
         return false;
@@ -308,28 +689,20 @@ bool NetworkController::deleteLayer(int layerIndex) {
 //【参数】layerIndex：层索引，neuronIndex：神经元索引，bias：新的偏置值
 //【返回值】bool，是否修改成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改成功后使当前版本的编译结果失效
+//           2026-10-18 写时复制，发布为新版本
 //-------------------------------------------------------------
 bool NetworkController::modifyNeuronBias(int layerIndex, int neuronIndex, double bias) {
-    if (!hasNetwork()) {
-        return false;
-    }
-    
-    Layer* layer = m_network->getLayer(layerIndex);
-    if (!layer) {
-        return false;
-    }
-    
-    Neuron* neuron = layer->getNeuron(neuronIndex);
-    if (!neuron) {
-        return false;
-    }
-    
     try {
-        neuron->setBias(bias);
-        // Clear import errors when network is modified
-        m_network->clearImportErrors();
-        return true;
+        return editNetwork([layerIndex, neuronIndex, bias](Network& network) {
+            Layer* layer = network.getLayer(layerIndex);
+            Neuron* neuron = layer ? layer->getNeuron(neuronIndex) : nullptr;
+            if (!neuron) {
+                return false;
+            }
+            neuron->setBias(bias);
+            return true;
+        });
     }
     catch (const exception&) {
         return false;
@@ -342,19 +715,14 @@ bool NetworkController::modifyNeuronBias(int layerIndex, int neuronIndex, double
 //【参数】layerIndex：层索引，neuronIndex：神经元索引
 //【返回值】bool，是否删除成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改成功后使当前版本的编译结果失效
+//           2026-10-18 写时复制，发布为新版本
 //-------------------------------------------------------------
 bool NetworkController::deleteNeuron(int layerIndex, int neuronIndex) {
-    if (!hasNetwork()) {
-        return false;
-    }
-    
     try {
-        bool success = m_network->removeNeuron(layerIndex, neuronIndex);
-        if (success) {
-            m_network->clearImportErrors();
-        }
-        return success;
+        return editNetwork([layerIndex, neuronIndex](Network& network) {
+            return network.removeNeuron(layerIndex, neuronIndex);
+        });
     }
     catch (const exception&) {
         return false;
@@ -367,34 +735,30 @@ bool NetworkController::deleteNeuron(int layerIndex, int neuronIndex) {
 //【参数】fromLayer：源层索引，fromNeuron：源神经元索引，toLayer：目标层索引，toNeuron：目标神经元索引，weight：连接权重
 //【返回值】bool，是否连接成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改成功后使当前版本的编译结果失效
+//           2026-10-18 写时复制，发布为新版本
 //-------------------------------------------------------------
 bool NetworkController::connectNeurons(int fromLayer, int fromNeuron, int toLayer, int toNeuron, double weight) {
-    if (!hasNetwork()) {
-        return false;
-    }
-    
     // Check if layers are adjacent
     if (toLayer != fromLayer + 1) {
         return false;
     }
     
-    Layer* sourceLayer = m_network->getLayer(fromLayer);
-    Layer* targetLayer = m_network->getLayer(toLayer);
-    
-    if (!sourceLayer || !targetLayer) {
-        return false;
-    }
-    
-    Neuron* pSourceNeuron = sourceLayer->getNeuron(fromNeuron);
-    Neuron* pTargetNeuron = targetLayer->getNeuron(toNeuron);
-    
-    if (!pSourceNeuron || !pTargetNeuron) {
-        return false;
-    }
-    
     try {
-        return pSourceNeuron->connectTo(*pTargetNeuron, weight);
+        return editNetwork([=](Network& network) {
+            Layer* sourceLayer = network.getLayer(fromLayer);
+            Layer* targetLayer = network.getLayer(toLayer);
+            if (!sourceLayer || !targetLayer) {
+                return false;
+            }
+            
+            Neuron* pSourceNeuron = sourceLayer->getNeuron(fromNeuron);
+            Neuron* pTargetNeuron = targetLayer->getNeuron(toNeuron);
+            if (!pSourceNeuron || !pTargetNeuron) {
+                return false;
+            }
+            return pSourceNeuron->connectTo(*pTargetNeuron, weight);
+        });
     }
     catch (const exception&) {
         return false;
@@ -407,19 +771,15 @@ bool NetworkController::connectNeurons(int fromLayer, int fromNeuron, int toLaye
 //【参数】无
 //【返回值】输入大小，失败返回-1
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 不再访问层对象，避免触发延迟加载
 //-------------------------------------------------------------
 int NetworkController::getInputSize() const {
-    if (!hasNetwork()) {
-        return -1;
-    }
-    
-    const Layer* firstLayer = m_network->getLayer(0);
-    if (!firstLayer) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return -1;
     }
     
-    return firstLayer->getNeuronCount();
+    return network->getLayerNeuronCount(0);
 }
 
 //-------------------------------------------------------------
@@ -428,18 +788,207 @@ int NetworkController::getInputSize() const {
 //【参数】inputs：输入数据
 //【返回值】推理结果
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 使用当前版本快照的编译结果，无法编译时退回对象图推理
+//           2026-10-18 退回对象图推理时持有发布锁
 //-------------------------------------------------------------
 vector<double> NetworkController::runInference(const vector<double>& inputs) const {
-    if (!hasNetwork()) {
+    // The snapshot keeps this version alive even if a newer one is published meanwhile
+    shared_ptr<const ModelVersion> version = atomic_load(&m_current);
+    if (!version || !version->network) {
         throw runtime_error("No network loaded");
     }
     
-    if (!m_network->isValid()) {
+    shared_ptr<const CompiledNetwork> compiled = version->compiled;
+    if (!compiled) {
+        compiled = compileVersion(version);
+    }
+    if (compiled) {
+        return compiled->predict(inputs);
+    }
+    
+    // Object-graph inference writes neuron state, so it takes turns with compiling and editing
+    lock_guard<mutex> lock(m_publishMutex);
+    if (!version->network->isValid()) {
         throw runtime_error("Network is not valid");
     }
     
-    return m_network->predict(inputs);
+    return version->network->predict(inputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】runBatchInference
+//【函数功能】对一批输入整批运行推理
+//【参数】inputs：各样本的输入
+//【返回值】各样本的输出
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 多个行块时在共享线程池上并行
+//           2026-10-18 退回对象图推理时持有发布锁
+//-------------------------------------------------------------
+vector<vector<double>> NetworkController::runBatchInference(const vector<vector<double>>& inputs) const {
+    shared_ptr<const ModelVersion> version = atomic_load(&m_current);
+    if (!version || !version->network) {
+        throw runtime_error("No network loaded");
+    }
+    
+    shared_ptr<const CompiledNetwork> compiled = version->compiled;
+    if (!compiled) {
+        compiled = compileVersion(version);
+    }
+    vector<vector<double>> outputs;
+    if (!compiled) {
+        lock_guard<mutex> lock(m_publishMutex);
+        if (!version->network->isValid()) {
+            throw runtime_error("Network is not valid");
+        }
+        for (const vector<double>& input : inputs) {
+            outputs.push_back(version->network->predict(input));
+        }
+        return outputs;
+    }
+    
+    // One row-major matrix in, one out
+    const size_t uInputSize = static_cast<size_t>(compiled->getInputSize());
+    vector<double> matrix;
+    matrix.reserve(inputs.size() * uInputSize);
+    for (const vector<double>& input : inputs) {
+        if (input.size() != uInputSize) {
+            throw runtime_error("Input size mismatch with first layer neuron count");
+        }
+        matrix.insert(matrix.end(), input.begin(), input.end());
+    }
+    // Batches spanning several row blocks are split across the shared pool; the split is by row,
+    // so the results do not depend on the number of threads
+    const int64_t iRows = static_cast<int64_t>(inputs.size());
+    vector<double> results = iRows > PackedGemm::BLOCK_ROWS
+                                 ? compiled->predictBatch(matrix, iRows, ThreadPool::getShared())
+                                 : compiled->predictBatch(matrix, iRows);
+    const size_t uOutputSize = static_cast<size_t>(compiled->getOutputSize());
+    for (size_t uRow = 0; uRow < inputs.size(); ++uRow) {
+        outputs.push_back(vector<double>(results.begin() + uRow * uOutputSize,
+                                         results.begin() + (uRow + 1) * uOutputSize));
+    }
+    return outputs;
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainNetwork
+//【函数功能】训练当前网络并写回
+//【参数】inputs：输入，targets：目标，epochs：轮数，batchSize：每批样本数，learningRate：学习率
+//【返回值】double，训练后的均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 每批在共享线程池上数据并行计算
+//           2026-10-18 训练结果写入副本后发布为新版本
+//-------------------------------------------------------------
+double NetworkController::trainNetwork(const vector<vector<double>>& inputs, const vector<vector<double>>& targets,
+                                       int epochs, int64_t batchSize, double learningRate) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        throw runtime_error("No network loaded");
+    }
+    Trainer trainer;
+    if (!trainer.loadFrom(*network)) {
+        throw runtime_error("Network is not valid for training");
+    }
+    if (inputs.empty() || inputs.size() != targets.size()) {
+        throw runtime_error("Training data must contain one target for each input");
+    }
+
+    // One row-major matrix each for inputs and targets
+    vector<double> inputMatrix;
+    vector<double> targetMatrix;
+    for (size_t uRow = 0; uRow < inputs.size(); ++uRow) {
+        if (static_cast<int64_t>(inputs[uRow].size()) != trainer.getInputSize() ||
+            static_cast<int64_t>(targets[uRow].size()) != trainer.getOutputSize()) {
+            throw runtime_error("Training sample size mismatch with network");
+        }
+        inputMatrix.insert(inputMatrix.end(), inputs[uRow].begin(), inputs[uRow].end());
+        targetMatrix.insert(targetMatrix.end(), targets[uRow].begin(), targets[uRow].end());
+    }
+
+    trainer.getOptimizer().setLearningRate(learningRate);
+    const int64_t iRows = static_cast<int64_t>(inputs.size());
+    double rLoss = trainer.evaluate(inputMatrix, targetMatrix, iRows);
+    for (int iEpoch = 0; iEpoch < epochs; ++iEpoch) {
+        // Deterministic reduction: the result does not depend on the number of cores
+        trainer.trainEpoch(inputMatrix, targetMatrix, iRows, batchSize, ThreadPool::getShared(),
+                           ReductionMode::Deterministic);
+    }
+    if (epochs > 0) {
+        rLoss = trainer.evaluate(inputMatrix, targetMatrix, iRows);
+        if (!editNetwork([&trainer](Network& trained) { return trainer.writeTo(trained); }, network)) {
+            throw runtime_error("Network was replaced during training");
+        }
+    }
+    return rLoss;
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainNetworkFromDataset
+//【函数功能】用.annd数据集文件训练当前网络并写回
+//【参数】filename：数据集路径，epochs：轮数，batchSize：每批样本数，learningRate：学习率
+//【返回值】double，最后一轮的均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 训练结果写入副本后发布为新版本
+//-------------------------------------------------------------
+double NetworkController::trainNetworkFromDataset(const string& filename, int epochs, int64_t batchSize,
+                                                  double learningRate) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
+        throw runtime_error("No network loaded");
+    }
+    Trainer trainer;
+    if (!trainer.loadFrom(*network)) {
+        throw runtime_error("Network is not valid for training");
+    }
+    if (epochs < 1) {
+        throw runtime_error("Epoch count must be positive");
+    }
+    Dataset dataset;
+    if (!dataset.open(filename)) {
+        throw runtime_error("Cannot open dataset: " + filename);
+    }
+    if (dataset.getInputWidth() != trainer.getInputSize() || dataset.getTargetWidth() != trainer.getOutputSize()) {
+        throw runtime_error("Dataset sample size mismatch with network");
+    }
+
+    trainer.getOptimizer().setLearningRate(learningRate);
+    BatchLoader loader(dataset, batchSize, true, DATASET_SHUFFLE_SEED);
+    double rLoss = 0.0;
+    for (int iEpoch = 0; iEpoch < epochs; ++iEpoch) {
+        rLoss = trainer.trainEpoch(loader, ThreadPool::getShared(), ReductionMode::Deterministic);
+    }
+    if (!editNetwork([&trainer](Network& trained) { return trainer.writeTo(trained); }, network)) {
+        throw runtime_error("Network was replaced during training");
+    }
+    return rLoss;
+}
+
+//-------------------------------------------------------------
+//【函数名称】runInference
+//【函数功能】在注册表中按键指定的模型上运行推理
+//【参数】modelKey：模型名称或路径，inputs：输入数据
+//【返回值】推理结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> NetworkController::runInference(const string& modelKey, const vector<double>& inputs) {
+    ModelHandle handle = m_registry.acquire(modelKey);
+    if (!handle.isValid()) {
+        throw runtime_error("Model could not be loaded: " + modelKey);
+    }
+    return handle.predict(inputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】getModelRegistry
+//【函数功能】获取多模型注册表
+//【参数】无
+//【返回值】ModelRegistry&，注册表引用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ModelRegistry& NetworkController::getModelRegistry() {
+    return m_registry;
 }
 
 //-------------------------------------------------------------
@@ -451,20 +1000,21 @@ vector<double> NetworkController::runInference(const vector<double>& inputs) con
 //【更改记录】
 //-------------------------------------------------------------
 string NetworkController::getValidationDetails() const {
-    if (!hasNetwork()) {
+    shared_ptr<Network> network = currentNetwork();
+    if (!network) {
         return "No network loaded.";
     }
     
     ostringstream oss;
     
     // Basic validation result
-    bool bIsValid = m_network->isValid();
+    bool bIsValid = network->isValid();
     oss << "Network Validation: " << (bIsValid ? "PASSED" : "FAILED") << "\n";
     
     // If there are import errors, show them
-    if (m_network->hasImportErrors()) {
+    if (network->hasImportErrors()) {
         oss << "\nIMPORT VALIDATION ERRORS:\n";
-        oss << m_network->getImportErrorMessage() << "\n";
+        oss << network->getImportErrorMessage() << "\n";
         oss << "\nNote: The network has been auto-corrected during import, but the original file contains specification violations.\n";
         oss << "Please review and correct the source file to eliminate these warnings.\n";
     } else if (!bIsValid) {
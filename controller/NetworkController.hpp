@@ -9,9 +9,16 @@
 #define NetworkController_hpp
 
 #include "../model/neural_components/Network.hpp"
+#include "../model/inference_engine/CompiledNetwork.hpp"
+#include "ModelRegistry.hpp"
 #include <memory>
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <future>
+#include <functional>
 
 using namespace std;
 
@@ -20,12 +27,79 @@ using namespace std;
 //【功能】神经网络业务逻辑控制器，单例模式
 //【说明】MVC模式下的Controller层，协调界面与模型
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 当前模型改为以shared_ptr原子发布的只读版本：推理读取版本快照并使用其编译结果，
+//           新模型可在后台线程导入、验证、编译后原子替换，进行中的推理继续使用旧版本完成。
+//           编辑类操作仍须在同一线程中调用
+//           2026-10-18 编辑类操作改为写时复制：编辑副本后发布为新版本，已发布的网络不再被修改。
+//           每次编辑都深复制整个网络（含延迟导入层的全部权重），代价为O(模型大小)，与改动多少无关
+//           2026-10-18 增加多模型注册表，按名称或路径同时驻留多个只读模型，供按键推理使用
+//           2026-10-18 增加trainNetwork，以反向传播训练当前网络（属于编辑类操作）
+//           2026-10-18 增加trainNetworkFromDataset，从内存映射的数据集文件训练
 //-------------------------------------------------------------
 class NetworkController {
 private:
+    //-------------------------------------------------------------
+    //【类名】ModelVersion
+    //【功能】一次发布的模型版本
+    //【说明】发布后不再修改（网络对象也不再被编辑）；compiled为空表示尚未编译（延迟导入或编辑后发布的版本），
+    //       下次推理时编译
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    struct ModelVersion {
+        shared_ptr<Network> network;                 // Object graph for editing and inspection
+        shared_ptr<const CompiledNetwork> compiled;  // Read-only form used by runInference
+        uint64_t generation;                         // Incremented whenever a new network is published
+    };
+    
     static unique_ptr<NetworkController> m_instance;  // 单例实例
-    unique_ptr<Network> m_network;    // 当前神经网络模型
+    mutable shared_ptr<const ModelVersion> m_current; // 当前模型版本，只通过atomic_load/atomic_store访问
+    mutable mutex m_publishMutex;                     // 串行化版本发布、编辑、编译和对象图推理
+    future<bool> m_pendingImport;                     // 后台导入任务
+    ModelRegistry m_registry;                         // 按键推理的多模型注册表
+    
+    //-------------------------------------------------------------
+    //【函数名称】currentNetwork
+    //【函数功能】获取当前版本的网络对象
+    //【参数】无
+    //【返回值】shared_ptr<Network>，无网络时为空
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    shared_ptr<Network> currentNetwork() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】publishNetwork
+    //【函数功能】将新网络发布为当前版本（版本号加一）
+    //【参数】network：新网络（可为空），compiled：其编译结果（可为空）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void publishNetwork(shared_ptr<Network> network, shared_ptr<const CompiledNetwork> compiled);
+    
+    //-------------------------------------------------------------
+    //【函数名称】editNetwork
+    //【函数功能】写时复制地编辑当前网络：复制当前版本的网络，在副本上执行edit，成功后把副本发布为新版本
+    //【参数】edit：编辑操作，返回是否成功；expected：不为空时只在当前网络仍是它时编辑
+    //【返回值】bool，有当前网络、expected匹配且edit成功时返回true；失败时当前版本不变
+    //【说明】整个过程持有m_publishMutex，与发布、编译和对象图推理互斥；已发布的网络不再被修改，
+    //       进行中的推理继续使用旧版本。版本之间不共享层：每次编辑都深复制整个对象图并重新链接连接，
+    //       时间和内存代价为O(模型大小)，即使只改一个偏置；修改大模型时应把多处改动合并为一次编辑
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool editNetwork(const function<bool(Network&)>& edit, const shared_ptr<Network>& expected = nullptr);
+    
+    //-------------------------------------------------------------
+    //【函数名称】compileVersion
+    //【函数功能】为尚未编译的版本生成编译结果，若该版本仍为当前版本则一并发布
+    //【参数】version：模型版本
+    //【返回值】shared_ptr<const CompiledNetwork>，网络无法编译时为空
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    shared_ptr<const CompiledNetwork> compileVersion(const shared_ptr<const ModelVersion>& version) const;
     
     //-------------------------------------------------------------
     //【函数名称】NetworkController
@@ -58,6 +132,8 @@ private:
     NetworkController& operator=(const NetworkController&) = delete;
 
 public:
+    static const uint64_t DATASET_SHUFFLE_SEED = 20261018;  // trainNetworkFromDataset的洗牌种子，结果可复现
+
     //-------------------------------------------------------------
     //【函数名称】getInstance
     //【函数功能】获取单例实例
@@ -84,7 +160,7 @@ public:
     //【参数】无
     //【返回值】无
     //【开发者及日期】林钲凯 2025-07-27
-    //【更改记录】
+    //【更改记录】2026-10-18 先等待后台导入结束
     //-------------------------------------------------------------
     ~NetworkController();
     
@@ -98,6 +174,26 @@ public:
     //-------------------------------------------------------------
     bool importNetwork(const string& filename);
     
+    //-------------------------------------------------------------
+    //【函数名称】importNetwork
+    //【函数功能】从内存中的ANN内容导入神经网络，无需临时文件
+    //【参数】data：模型内容首地址，size：字节数
+    //【返回值】bool，导入成功返回true，否则返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool importNetwork(const char* data, size_t size);
+    
+    //-------------------------------------------------------------
+    //【函数名称】importNetworkLazily
+    //【函数功能】以延迟加载模式从文件导入神经网络：只读取拓扑，各层权重在首次访问时加载
+    //【参数】filename：要导入的文件路径，网络存在期间文件须保持不变
+    //【返回值】bool，导入成功返回true，否则返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool importNetworkLazily(const string& filename);
+    
     //-------------------------------------------------------------
     //【函数名称】exportNetwork
     //【函数功能】导出神经网络到文件
@@ -108,6 +204,108 @@ public:
     //-------------------------------------------------------------
     bool exportNetwork(const string& filename) const;
     
+    //-------------------------------------------------------------
+    //【函数名称】exportNetworkToString
+    //【函数功能】将当前神经网络以ANN格式导出到内存字符串
+    //【参数】无
+    //【返回值】string，ANN格式内容，无网络或导出失败返回空字符串
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string exportNetworkToString() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】exportCompiledNetwork
+    //【函数功能】将当前神经网络编译为逐层稠密权重并导出为.annb文件，供StreamingExecutor外存推理
+    //【参数】filename：要导出的.annb文件路径
+    //【返回值】bool，导出成功返回true，否则返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool exportCompiledNetwork(const string& filename) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】setInferenceEngine
+    //【函数功能】选择runInference使用的执行引擎，下次推理时按新引擎重新编译
+    //【参数】engine：执行引擎
+    //【返回值】bool，有网络时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool setInferenceEngine(InferenceEngine engine);
+    
+    //-------------------------------------------------------------
+    //【函数名称】exportNetworkHeader
+    //【函数功能】将当前神经网络生成为不依赖本项目的独立C++头文件（权重为constexpr数组）
+    //【参数】filename：输出文件名（.hpp或.h），namespaceName：生成代码的命名空间
+    //【返回值】bool，是否导出成功；命名空间不是合法标识符时返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool exportNetworkHeader(const string& filename, const string& namespaceName) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】exportPatch
+    //【函数功能】将当前神经网络相对于基准文件的修改导出为补丁文件
+    //【参数】baseFilename：修改前的ANN文件路径，patchFilename：要导出的补丁文件路径
+    //【返回值】bool，导出成功返回true；基准无法导入或层结构不同时返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool exportPatch(const string& baseFilename, const string& patchFilename) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】applyPatch
+    //【函数功能】在当前网络的副本上应用补丁文件，成功后把副本发布为新版本
+    //【参数】patchFilename：补丁文件路径
+    //【返回值】bool，应用成功返回true；失败时当前版本保持不变
+    //【说明】补丁只描述改动，但应用时仍按editNetwork复制整个网络，代价为O(模型大小)
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 改为写时复制，不再原地修改已发布的网络
+    //-------------------------------------------------------------
+    bool applyPatch(const string& patchFilename);
+    
+    //-------------------------------------------------------------
+    //【函数名称】importNetworkAsync
+    //【函数功能】在后台线程导入、验证并编译网络，成功后原子替换当前模型；
+    //           替换前后的推理不会暂停，已开始的推理在旧版本上完成
+    //【参数】filename：要导入的文件路径
+    //【返回值】bool，任务已启动返回true（上一个后台导入会先等待完成）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool importNetworkAsync(const string& filename);
+    
+    //-------------------------------------------------------------
+    //【函数名称】waitForPendingImport
+    //【函数功能】等待后台导入完成
+    //【参数】无
+    //【返回值】bool，新模型已发布返回true；导入、验证或编译失败（当前模型保持不变）或无后台任务时返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool waitForPendingImport();
+    
+    //-------------------------------------------------------------
+    //【函数名称】isImportPending
+    //【函数功能】判断是否有尚未完成的后台导入
+    //【参数】无
+    //【返回值】bool，有进行中的后台导入返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isImportPending() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getModelGeneration
+    //【函数功能】获取当前模型版本号，每次导入新网络后加一
+    //【参数】无
+    //【返回值】uint64_t，版本号，从未导入时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    uint64_t getModelGeneration() const;
+    
     //-------------------------------------------------------------
     //【函数名称】hasNetwork
     //【函数功能】检查当前是否已加载网络
@@ -235,9 +433,68 @@ public:
     //【返回值】vector<double>，网络的输出值向量
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】推理失败时抛出runtime_error异常
+    //           2026-10-18 使用当前版本的编译结果，可与后台导入及其他推理并发调用
     //-------------------------------------------------------------
     vector<double> runInference(const vector<double>& inputs) const;
     
+    //-------------------------------------------------------------
+    //【函数名称】runBatchInference
+    //【函数功能】对一批输入整批运行推理（CompiledNetwork::predictBatch），结果与逐个runInference相同；
+    //           超过一个行块时按行块在ThreadPool::getShared()上并行，结果与线程数无关
+    //【参数】inputs：各样本的输入值向量
+    //【返回值】vector<vector<double>>，各样本的输出；无网络、网络无效或某个输入长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 多个行块时在共享线程池上并行
+    //-------------------------------------------------------------
+    vector<vector<double>> runBatchInference(const vector<vector<double>>& inputs) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】trainNetwork
+    //【函数功能】用Trainer在给定样本上以SGD训练当前网络若干轮，训练结果写回当前网络
+    //           （与其他编辑操作相同，之后的推理重新编译）；每批在ThreadPool::getShared()上
+    //           以确定归约方式数据并行计算，结果与核数无关
+    //【参数】inputs：各样本的输入，targets：各样本的目标输出，epochs：轮数，
+    //       batchSize：每批样本数，learningRate：学习率
+    //【返回值】double，训练后在这些样本上的均方误差；无网络、网络无效、样本数为0或长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 每批数据并行计算
+    //-------------------------------------------------------------
+    double trainNetwork(const vector<vector<double>>& inputs, const vector<vector<double>>& targets,
+                        int epochs, int64_t batchSize, double learningRate);
+    
+    //-------------------------------------------------------------
+    //【函数名称】trainNetworkFromDataset
+    //【函数功能】用内存映射的.annd数据集文件（见Dataset）训练当前网络若干轮，训练结果写回当前网络；
+    //           每轮以固定种子DATASET_SHUFFLE_SEED打乱样本顺序，后台线程预取下一批，
+    //           每批在ThreadPool::getShared()上以确定归约方式数据并行计算
+    //【参数】filename：数据集路径，epochs：轮数（至少为1），batchSize：每批样本数，learningRate：学习率
+    //【返回值】double，最后一轮各批更新前均方误差的加权平均；无网络、网络无效、轮数小于1、
+    //         文件无法打开或宽度与网络不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainNetworkFromDataset(const string& filename, int epochs, int64_t batchSize, double learningRate);
+    
+    //-------------------------------------------------------------
+    //【函数名称】runInference
+    //【函数功能】在注册表中按键指定的模型上运行推理，模型未驻留时先导入
+    //【参数】modelKey：模型名称或路径，inputs：输入值向量
+    //【返回值】vector<double>，输出值向量；模型无法加载或输入长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> runInference(const string& modelKey, const vector<double>& inputs);
+    
+    //-------------------------------------------------------------
+    //【函数名称】getModelRegistry
+    //【函数功能】获取多模型注册表，用于获取模型句柄、设置内存预算或加载函数
+    //【参数】无
+    //【返回值】ModelRegistry&，注册表引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ModelRegistry& getModelRegistry();
+    
     //-------------------------------------------------------------
     //【函数名称】getValidationDetails
     //【函数功能】获取详细的验证信息，包括导入错误
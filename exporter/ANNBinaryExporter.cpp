@@ -0,0 +1,104 @@
+//-------------------------------------------------------------
+//【文件名】ANNBinaryExporter.cpp
+//【功能模块和目的】编译后二进制模型（.annb）导出器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ANNBinaryExporter.hpp"
+#include "../model/inference_engine/CompiledLayer.hpp"
+#include "../model/inference_engine/BinaryModelFormat.hpp"
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】exportNetwork
+//【函数功能】导出编译后的网络到文件
+//【参数】network：网络引用，filename：文件名
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNBinaryExporter::exportNetwork(const Network& network, const string& filename) {
+    if (!isFormatSupported(filename)) {
+        return false;
+    }
+
+    ofstream file(filename, ios::out | ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    if (!exportNetwork(network, file)) {
+        return false;
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetwork
+//【函数功能】导出编译后的网络到输出流：先写层表，再逐层编译并写出权重块
+//【参数】network：网络引用，stream：输出流
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNBinaryExporter::exportNetwork(const Network& network, ostream& stream) {
+    if (!stream.good() || !validateNetworkForExport(network)) {
+        return false;
+    }
+
+    // The layer table is fully determined by the layer widths
+    vector<int64_t> widths;
+    vector<int64_t> inputWidths;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        widths.push_back(network.getLayerNeuronCount(iLayerIdx));
+        inputWidths.push_back(iLayerIdx == 0 ? 1 : widths[iLayerIdx - 1]);
+    }
+    if (!BinaryModelFormat::writeHeader(stream, widths, inputWidths)) {
+        return false;
+    }
+
+    // Only one compiled layer is held at a time
+    CompiledLayer compiled;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        const Layer* pLayer = network.getLayer(iLayerIdx);
+        if (!pLayer || !compiled.compile(*pLayer, inputWidths[iLayerIdx], iLayerIdx == 0)) {
+            return false;
+        }
+        if (!compiled.writeTo(stream)) {
+            return false;
+        }
+    }
+
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getSupportedExtensions
+//【函数功能】获取支持的文件扩展名
+//【参数】无
+//【返回值】支持的文件扩展名字符串
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNBinaryExporter::getSupportedExtensions() const {
+    return ".annb";
+}
+
+//-------------------------------------------------------------
+//【函数名称】getExporterName
+//【函数功能】获取导出器名称
+//【参数】无
+//【返回值】导出器名称字符串
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNBinaryExporter::getExporterName() const {
+    return "ANN Binary Exporter";
+}
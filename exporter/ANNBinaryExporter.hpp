@@ -0,0 +1,86 @@
+//-------------------------------------------------------------
+//【文件名】ANNBinaryExporter.hpp
+//【功能模块和目的】编译后二进制模型（.annb）导出器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef AnnBinaryExporter_hpp
+#define AnnBinaryExporter_hpp
+
+#include "BaseExporter.hpp"
+#include <ostream>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ANNBinaryExporter
+//【功能】将网络编译为逐层稠密权重块并写入.annb文件，供StreamingExecutor外存推理
+//【说明】只保存推理所需的数据（宽度、激活函数、偏置、按树突顺序排列的权重），
+//       不保留突触的源神经元信息，因此该格式不能再导入为Network对象。
+//       每次只编译一层，导出时的额外内存为一层的稠密权重
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class ANNBinaryExporter : public BaseExporter {
+public:
+    /**
+     * @brief Constructor
+     */
+    ANNBinaryExporter() = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】ANNBinaryExporter（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的导出器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNBinaryExporter(const ANNBinaryExporter& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源导出器
+    //【返回值】ANNBinaryExporter&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNBinaryExporter& operator=(const ANNBinaryExporter& other) = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~ANNBinaryExporter() = default;
+
+    /**
+     * @brief Export the compiled network to an .annb file
+     * @param network Network to export
+     * @param filename Path to output file, opened in binary mode
+     * @return True if export successful
+     */
+    bool exportNetwork(const Network& network, const string& filename) override;
+
+    /**
+     * @brief Export the compiled network to a binary output stream
+     * @param network Network to export
+     * @param stream Destination stream; need not be seekable
+     * @return True if export successful, false if the network cannot be run by predict()
+     */
+    bool exportNetwork(const Network& network, ostream& stream) override;
+
+    /**
+     * @brief Get supported file extensions
+     * @return ".annb"
+     */
+    string getSupportedExtensions() const override;
+
+    /**
+     * @brief Get exporter name
+     * @return "ANN Binary Exporter"
+     */
+    string getExporterName() const override;
+};
+
+#endif // AnnBinaryExporter_hpp
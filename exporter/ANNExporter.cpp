@@ -10,6 +10,9 @@
 #include "../utils/FileUtils.hpp"
 #include <iomanip>
 #include <sstream>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
 
 using namespace std;
 
@@ -21,7 +24,7 @@ using namespace std;
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-ANNExporter::ANNExporter() {
+ANNExporter::ANNExporter() : m_bDenseBlocksEnabled(true) {
 }
 
 //-------------------------------------------------------------
@@ -40,7 +43,7 @@ ANNExporter::~ANNExporter() = default;
 //【参数】network：网络引用，filename：文件名
 //【返回值】bool，是否导出成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 写入逻辑移至流版本，本函数只负责打开文件
 //-------------------------------------------------------------
 bool ANNExporter::exportNetwork(const Network& network, const string& filename) {
     if (!isFormatSupported(filename)) {
@@ -56,33 +59,50 @@ bool ANNExporter::exportNetwork(const Network& network, const string& filename)
         return false;
     }
     
+    if (!exportNetwork(network, file)) {
+        return false;
+    }
+    
+    file.close();
+    return !file.fail();
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetwork
+//【函数功能】以ANN格式导出神经网络到输出流
+//【参数】network：网络引用，stream：输出流
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNExporter::exportNetwork(const Network& network, ostream& stream) {
+    if (!stream.good() || !validateNetworkForExport(network)) {
+        return false;
+    }
+    
+    // The writers switch the stream to fixed notation; leave the caller's stream as we found it
+    ios_base::fmtflags savedFlags = stream.flags();
+    streamsize savedPrecision = stream.precision();
+    bool bSuccess = false;
+    
     try {
         // Write file header
-        writeComment(file, "ANN Neural Network File");
-        writeComment(file, "Generated by ANN Exporter");
-        file << endl;
-        
-        // Write network header
-        if (!writeNetworkHeader(file, network)) {
-            return false;
-        }
-        
-        // Write layer information
-        if (!writeLayerInformation(file, network)) {
-            return false;
-        }
+        writeComment(stream, "ANN Neural Network File");
+        writeComment(stream, "Generated by ANN Exporter");
+        stream << endl;
         
-        // Write connections
-        if (!writeConnections(file, network)) {
-            return false;
-        }
-        
-        file.close();
-        return true;
+        // Write network header, layer information and connections
+        bSuccess = writeNetworkHeader(stream, network)
+                && writeLayerInformation(stream, network)
+                && writeConnections(stream, network);
     }
     catch (const exception&) {
-        return false;
+        bSuccess = false;
     }
+    
+    stream.flags(savedFlags);
+    stream.precision(savedPrecision);
+    return bSuccess && stream.good();
 }
 
 //-------------------------------------------------------------
@@ -109,6 +129,30 @@ string ANNExporter::getExporterName() const {
     return "ANN Exporter";
 }
 
+//-------------------------------------------------------------
+//【函数名称】setDenseBlocksEnabled
+//【函数功能】设置是否对全连接层对输出稠密块（D记录）
+//【参数】enabled：true输出稠密块，false全部按S记录逐条输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNExporter::setDenseBlocksEnabled(bool enabled) {
+    m_bDenseBlocksEnabled = enabled;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isDenseBlocksEnabled
+//【函数功能】查询是否输出稠密块
+//【参数】无
+//【返回值】bool，是否输出稠密块
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNExporter::isDenseBlocksEnabled() const {
+    return m_bDenseBlocksEnabled;
+}
+
 //-------------------------------------------------------------
 //【函数名称】writeNetworkHeader
 //【函数功能】写入网络头信息
@@ -117,7 +161,7 @@ string ANNExporter::getExporterName() const {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-bool ANNExporter::writeNetworkHeader(ofstream& file, const Network& network) {
+bool ANNExporter::writeNetworkHeader(ostream& file, const Network& network) {
     writeComment(file, network.getName());
     file << "G " << network.getName() << endl;
     return file.good();
@@ -129,9 +173,9 @@ bool ANNExporter::writeNetworkHeader(ofstream& file, const Network& network) {
 //【参数】file：文件流，network：网络引用
 //【返回值】bool，是否写入成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 偏置按writeValue写出，训练后的值不再被舍入
 //-------------------------------------------------------------
-bool ANNExporter::writeLayerInformation(ofstream& file, const Network& network) {
+bool ANNExporter::writeLayerInformation(ostream& file, const Network& network) {
     writeComment(file, "Six Neurons: zero bias, without activation function");
     
     // First, write all neurons
@@ -149,7 +193,9 @@ bool ANNExporter::writeLayerInformation(ofstream& file, const Network& network)
             }
             
             // Write neuron: N bias activation_type
-            file << "N " << fixed << setprecision(1) << pNeuron->getBias() << " ";
+            file << "N ";
+            writeValue(file, pNeuron->getBias(), 1);
+            file << " ";
             
             // Determine activation type based on function name
             const ActivationFunction* pActivationFunc = pNeuron->getActivationFunction();
@@ -204,7 +250,7 @@ bool ANNExporter::writeLayerInformation(ofstream& file, const Network& network)
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-bool ANNExporter::writeNeuronInformation(ofstream& file, const Layer& layer) {
+bool ANNExporter::writeNeuronInformation(ostream& file, const Layer& layer) {
     for (int iNeuronIdx = 0; iNeuronIdx < layer.getNeuronCount(); ++iNeuronIdx) {
         const Neuron* neuron = layer.getNeuron(iNeuronIdx);
         if (!neuron) {
@@ -230,9 +276,10 @@ bool ANNExporter::writeNeuronInformation(ofstream& file, const Layer& layer) {
 //【参数】file：文件流，network：网络引用
 //【返回值】bool，是否写入成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 全连接层对改为输出稠密块
+//           2026-10-18 权重按writeValue写出，训练后的值不再被舍入
 //-------------------------------------------------------------
-bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
+bool ANNExporter::writeConnections(ostream& file, const Network& network) {
     // First write input connections (from external input to first layer)
     const Layer* firstLayer = network.getLayer(0);
     if (firstLayer) {
@@ -244,8 +291,9 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
                 for (int iSynapseIdx = 0; iSynapseIdx < neuron->getInputSynapseCount(); ++iSynapseIdx) {
                     const Synapse* synapse = neuron->getInputSynapse(iSynapseIdx);
                     if (synapse && synapse->getSourceNeuron() == nullptr) {
-                        file << "S -1 " << iNeuronIdx << " " << fixed << setprecision(1) 
-                             << synapse->getWeight() << endl;
+                        file << "S -1 " << iNeuronIdx << " ";
+                        writeValue(file, synapse->getWeight(), 1);
+                        file << endl;
                         break;
                     }
                 }
@@ -273,8 +321,9 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
                 for (int iSynapseIdx = 0; iSynapseIdx < neuron->getOutputSynapseCount(); ++iSynapseIdx) {
                     const Synapse* synapse = neuron->getOutputSynapse(iSynapseIdx);
                     if (synapse && synapse->getTargetNeuron() == nullptr) {
-                        file << "S " << (iLastLayerStart + iNeuronIdx) << " -1 " << fixed << setprecision(1) 
-                             << synapse->getWeight() << endl;
+                        file << "S " << (iLastLayerStart + iNeuronIdx) << " -1 ";
+                        writeValue(file, synapse->getWeight(), 1);
+                        file << endl;
                         break;
                     }
                 }
@@ -288,6 +337,18 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
         const Layer* layer = network.getLayer(iLayerIndex);
         if (!layer) continue;
         
+        // A layer fully connected to the next one is written as a single dense block
+        if (m_bDenseBlocksEnabled && iLayerIndex < network.getLayerCount() - 1) {
+            const Layer* nextLayer = network.getLayer(iLayerIndex + 1);
+            if (nextLayer && isDenselyConnected(*layer, *nextLayer)) {
+                if (!writeDenseBlock(file, *layer, *nextLayer, iLayerIndex, iCurrentNeuronOffset)) {
+                    return false;
+                }
+                iCurrentNeuronOffset += layer->getNeuronCount();
+                continue;
+            }
+        }
+        
         for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
             const Neuron* pNeuron = layer->getNeuron(iNeuronIdx);
             if (!pNeuron) continue;
@@ -330,9 +391,9 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
                             }
                         }
                         
-                        file << "S " << iGlobalNeuronIndex << " " << iTargetGlobalIndex 
-                             << " " << fixed << setprecision(4) << rConnectionWeight 
-                             << endl;
+                        file << "S " << iGlobalNeuronIndex << " " << iTargetGlobalIndex << " ";
+                        writeValue(file, rConnectionWeight, 4);
+                        file << endl;
                     }
                 }
             }
@@ -344,6 +405,130 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
     return file.good();
 }
 
+//-------------------------------------------------------------
+//【函数名称】isDenselyConnected
+//【函数功能】判断源层是否与目标层全连接（connectToLayer方式，每对神经元恰好一条连接）
+//【参数】sourceLayer：源层，targetLayer：目标层
+//【返回值】bool，是否全连接
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNExporter::isDenselyConnected(const Layer& sourceLayer, const Layer& targetLayer) const {
+    int iTargetCount = targetLayer.getNeuronCount();
+    if (sourceLayer.getNeuronCount() == 0 || iTargetCount == 0) {
+        return false;
+    }
+    
+    map<const Neuron*, int> targetIndices;
+    for (int iTargetIdx = 0; iTargetIdx < iTargetCount; ++iTargetIdx) {
+        targetIndices[targetLayer.getNeuron(iTargetIdx)] = iTargetIdx;
+    }
+    
+    for (int iNeuronIdx = 0; iNeuronIdx < sourceLayer.getNeuronCount(); ++iNeuronIdx) {
+        const Neuron* pNeuron = sourceLayer.getNeuron(iNeuronIdx);
+        if (!pNeuron) {
+            return false;
+        }
+        
+        // Every axon must reach a distinct neuron of the target layer (external outputs are written separately)
+        vector<bool> reached(iTargetCount, false);
+        int iReachedCount = 0;
+        for (int iSynapseIdx = 0; iSynapseIdx < pNeuron->getOutputSynapseCount(); ++iSynapseIdx) {
+            const Synapse* pSynapse = pNeuron->getOutputSynapse(iSynapseIdx);
+            if (!pSynapse || !pSynapse->getTargetNeuron()) continue;
+            
+            auto it = targetIndices.find(pSynapse->getTargetNeuron());
+            if (it == targetIndices.end() || reached[it->second]) {
+                return false;
+            }
+            reached[it->second] = true;
+            iReachedCount++;
+        }
+        if (iReachedCount != iTargetCount) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeDenseBlock
+//【函数功能】写入稠密块：D 源层 目标层，随后每个源神经元一行权重
+//【参数】file：文件流，sourceLayer：源层，targetLayer：目标层，
+//         sourceLayerIndex：源层索引，sourceOffset：源层首个神经元的全局索引
+//【返回值】bool，是否写入成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 权重按writeValue写出，训练后的值不再被舍入
+//-------------------------------------------------------------
+bool ANNExporter::writeDenseBlock(ostream& file, const Layer& sourceLayer, const Layer& targetLayer,
+                                  int sourceLayerIndex, int sourceOffset) {
+    int iRowCount = sourceLayer.getNeuronCount();
+    int iColumnCount = targetLayer.getNeuronCount();
+    
+    map<const Neuron*, int> sourceIndices;
+    for (int iNeuronIdx = 0; iNeuronIdx < iRowCount; ++iNeuronIdx) {
+        sourceIndices[sourceLayer.getNeuron(iNeuronIdx)] = iNeuronIdx;
+    }
+    
+    // 实际连接权重存储在目标神经元的树突中，每个目标神经元只需扫描一次
+    vector<double> weights(static_cast<size_t>(iRowCount) * iColumnCount, 1.0);
+    vector<bool> found(weights.size(), false);
+    for (int iTargetIdx = 0; iTargetIdx < iColumnCount; ++iTargetIdx) {
+        const Neuron* pTargetNeuron = targetLayer.getNeuron(iTargetIdx);
+        for (int iInputIdx = 0; iInputIdx < pTargetNeuron->getInputSynapseCount(); ++iInputIdx) {
+            const Synapse* pInputSynapse = pTargetNeuron->getInputSynapse(iInputIdx);
+            if (!pInputSynapse) continue;
+            
+            auto it = sourceIndices.find(pInputSynapse->getSourceNeuron());
+            if (it == sourceIndices.end()) continue;
+            
+            size_t uCell = static_cast<size_t>(it->second) * iColumnCount + iTargetIdx;
+            if (!found[uCell]) {
+                weights[uCell] = pInputSynapse->getWeight();
+                found[uCell] = true;
+            }
+        }
+    }
+    
+    int iTargetOffset = sourceOffset + iRowCount;
+    writeComment(file, "Dense block from Neuron " + to_string(sourceOffset) + "~" +
+                to_string(sourceOffset + iRowCount - 1) + " to Neuron " + to_string(iTargetOffset) + "~" +
+                to_string(iTargetOffset + iColumnCount - 1) + " (one row per source neuron)");
+    file << "D " << sourceLayerIndex << " " << (sourceLayerIndex + 1) << "\n";
+    
+    for (int iRow = 0; iRow < iRowCount; ++iRow) {
+        const double* pRow = &weights[static_cast<size_t>(iRow) * iColumnCount];
+        for (int iColumn = 0; iColumn < iColumnCount; ++iColumn) {
+            if (iColumn > 0) {
+                file << ' ';
+            }
+            writeValue(file, pRow[iColumn], 4);
+        }
+        file << '\n';
+    }
+    
+    return file.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeValue
+//【函数功能】写出偏置或权重：定点precision位能精确表示时沿用原格式（手写模型的文件不变），
+//           否则以17位有效数字写出，训练得到的参数读回后逐位相同
+//【参数】file：输出流，value：数值，precision：定点小数位数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNExporter::writeValue(ostream& file, double value, int precision) const {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+    if (strtod(buffer, nullptr) != value) {
+        snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    file << buffer;
+}
+
 //-------------------------------------------------------------
 //【函数名称】writeComment
 //【函数功能】写入注释
@@ -352,7 +537,7 @@ bool ANNExporter::writeConnections(ofstream& file, const Network& network) {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-void ANNExporter::writeComment(ofstream& file, const string& comment) {
+void ANNExporter::writeComment(ostream& file, const string& comment) {
     file << "# " << comment << endl;
 }
 
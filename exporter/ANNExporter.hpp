@@ -11,6 +11,7 @@
 #include "BaseExporter.hpp"
 #include "../model/activation_functions/ActivationFunction.hpp"
 #include <fstream>
+#include <ostream>
 
 using namespace std;
 
@@ -19,48 +20,78 @@ using namespace std;
 //【功能】ANN文件格式导出器，序列化神经网络结构
 //【说明】支持ANN文件的网络、层、神经元、突触导出
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 偏置和权重按能原样读回的精度写出（writeValue）
 //-------------------------------------------------------------
 class ANNExporter : public BaseExporter {
 private:
+    bool m_bDenseBlocksEnabled;  ///< Write fully connected layer pairs as D blocks
+    
     /**
      * @brief Write network header information
-     * @param file Output file stream
+     * @param file Output stream
      * @param network Network to export
      * @return True if header written successfully
      */
-    bool writeNetworkHeader(ofstream& file, const Network& network);
+    bool writeNetworkHeader(ostream& file, const Network& network);
     
     /**
      * @brief Write layer information
-     * @param file Output file stream
+     * @param file Output stream
      * @param network Network to export
      * @return True if layers written successfully
      */
-    bool writeLayerInformation(ofstream& file, const Network& network);
+    bool writeLayerInformation(ostream& file, const Network& network);
     
     /**
      * @brief Write neuron information for a layer
-     * @param file Output file stream
+     * @param file Output stream
      * @param layer Layer to export
      * @return True if neurons written successfully
      */
-    bool writeNeuronInformation(ofstream& file, const Layer& layer);
+    bool writeNeuronInformation(ostream& file, const Layer& layer);
     
     /**
      * @brief Write synapse connections
-     * @param file Output file stream
+     * @param file Output stream
      * @param network Network to export
      * @return True if connections written successfully
      */
-    bool writeConnections(ofstream& file, const Network& network);
+    bool writeConnections(ostream& file, const Network& network);
+    
+    /**
+     * @brief Check whether every source neuron connects exactly once to every target neuron
+     * @param sourceLayer Source layer
+     * @param targetLayer Target layer
+     * @return True if the pair can be written as a dense block
+     */
+    bool isDenselyConnected(const Layer& sourceLayer, const Layer& targetLayer) const;
+    
+    /**
+     * @brief Write a "D from_layer to_layer" record followed by one weight row per source neuron
+     * @param file Output stream
+     * @param sourceLayer Source layer
+     * @param targetLayer Target layer (the layer after the source)
+     * @param sourceLayerIndex Index of the source layer
+     * @param sourceOffset Global index of the first source neuron
+     * @return True if the block was written successfully
+     */
+    bool writeDenseBlock(ostream& file, const Layer& sourceLayer, const Layer& targetLayer,
+                         int sourceLayerIndex, int sourceOffset);
+    
+    /**
+     * @brief Write a bias or weight so that importing it gives back the same double
+     * @param file Output stream
+     * @param value Value to write
+     * @param precision Fixed-point digits used when they already represent the value exactly
+     */
+    void writeValue(ostream& file, double value, int precision) const;
     
     /**
      * @brief Write comment to file
-     * @param file Output file stream
+     * @param file Output stream
      * @param comment Comment text
      */
-    void writeComment(ofstream& file, const string& comment);
+    void writeComment(ostream& file, const string& comment);
     
     /**
      * @brief Get activation function name
@@ -116,6 +147,14 @@ public:
      */
     bool exportNetwork(const Network& network, const string& filename) override;
     
+    /**
+     * @brief Export neural network in ANN format to an output stream
+     * @param network Network to export
+     * @param stream Destination stream; its formatting flags are restored afterwards
+     * @return True if export successful
+     */
+    bool exportNetwork(const Network& network, ostream& stream) override;
+    
     /**
      * @brief Get supported file extensions
      * @return ".ann"
@@ -127,6 +166,26 @@ public:
      * @return "ANN Exporter"
      */
     string getExporterName() const override;
+    
+    //-------------------------------------------------------------
+    //【函数名称】setDenseBlocksEnabled
+    //【函数功能】设置是否对全连接层对输出稠密块（D记录）
+    //【参数】enabled：true输出稠密块（默认），false全部按S记录逐条输出以兼容旧版读取器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setDenseBlocksEnabled(bool enabled);
+    
+    //-------------------------------------------------------------
+    //【函数名称】isDenseBlocksEnabled
+    //【函数功能】查询是否输出稠密块
+    //【参数】无
+    //【返回值】bool，是否输出稠密块
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isDenseBlocksEnabled() const;
 };
 
 #endif // AnnExporter_hpp
@@ -0,0 +1,368 @@
+//-------------------------------------------------------------
+//【文件名】ANNHeaderExporter.cpp
+//【功能模块和目的】独立C++头文件代码生成导出器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ANNHeaderExporter.hpp"
+#include "../model/inference_engine/CompiledNetwork.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】ANNHeaderExporter
+//【函数功能】构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ANNHeaderExporter::ANNHeaderExporter()
+    : m_namespaceName("generated_network"), m_iUnrollLimit(DEFAULT_UNROLL_LIMIT) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetwork
+//【函数功能】生成独立C++头文件
+//【参数】network：网络引用，filename：文件名
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNHeaderExporter::exportNetwork(const Network& network, const string& filename) {
+    if (!isFormatSupported(filename)) {
+        return false;
+    }
+
+    ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    if (!exportNetwork(network, file)) {
+        return false;
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportNetwork
+//【函数功能】生成独立C++头文件到输出流
+//【参数】network：网络引用，stream：输出流
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNHeaderExporter::exportNetwork(const Network& network, ostream& stream) {
+    if (!stream.good() || !validateNetworkForExport(network)) {
+        return false;
+    }
+
+    CompiledNetwork compiled;
+    if (!compiled.compile(network)) {
+        return false;
+    }
+    for (int iLayerIdx = 0; iLayerIdx < compiled.getLayerCount(); ++iLayerIdx) {
+        const CompiledLayer* pLayer = compiled.getLayer(iLayerIdx);
+        for (double rWeight : pLayer->getWeights()) {
+            if (!isfinite(rWeight)) {
+                return false;
+            }
+        }
+        for (double rBias : pLayer->getBiases()) {
+            if (!isfinite(rBias)) {
+                return false;
+            }
+        }
+    }
+
+    // Build the text first so that a failure never leaves half a header behind
+    ostringstream code;
+    string guard = m_namespaceName + "_hpp";
+    for (char& c : guard) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    int iLayerCount = compiled.getLayerCount();
+
+    code << "// Generated by " << getExporterName() << ". Do not edit.\n";
+    code << "// Topology:";
+    for (int iLayerIdx = 0; iLayerIdx < iLayerCount; ++iLayerIdx) {
+        code << (iLayerIdx == 0 ? " " : "-") << compiled.getLayer(iLayerIdx)->getWidth();
+    }
+    code << ". Standalone: depends only on <cmath>.\n\n";
+    code << "#ifndef " << guard << "\n#define " << guard << "\n\n#include <cmath>\n\n";
+    code << "namespace " << m_namespaceName << " {\n\n";
+    code << "static constexpr int kInputSize = " << compiled.getInputSize() << ";\n";
+    code << "static constexpr int kOutputSize = " << compiled.getOutputSize() << ";\n\n";
+
+    code << "static inline double activateLinear(double x) { return x; }\n";
+    code << "static inline double activateSigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }\n";
+    code << "static inline double activateTanh(double x) {\n"
+         << "    double ex = std::exp(x);\n"
+         << "    double enx = std::exp(-x);\n"
+         << "    return (ex - enx) / (ex + enx);\n"
+         << "}\n";
+    code << "static inline double activateReLU(double x) { return x > 0.0 ? x : 0.0; }\n";
+    code << "static inline double activate(int code, double x) {\n"
+         << "    switch (code) {\n"
+         << "        case 1: return activateSigmoid(x);\n"
+         << "        case 2: return activateTanh(x);\n"
+         << "        case 3: return activateReLU(x);\n"
+         << "        default: return activateLinear(x);\n"
+         << "    }\n"
+         << "}\n\n";
+
+    for (int iLayerIdx = 0; iLayerIdx < iLayerCount; ++iLayerIdx) {
+        writeLayer(code, *compiled.getLayer(iLayerIdx), iLayerIdx);
+    }
+
+    // Intermediate activations live on the stack; the last layer writes the caller's buffer
+    code << "// input: kInputSize values, output: kOutputSize values\n";
+    code << "static inline void predict(const double* input, double* output) {\n";
+    for (int iLayerIdx = 0; iLayerIdx + 1 < iLayerCount; ++iLayerIdx) {
+        code << "    double layer" << iLayerIdx << "Out[" << compiled.getLayer(iLayerIdx)->getWidth() << "];\n";
+    }
+    for (int iLayerIdx = 0; iLayerIdx < iLayerCount; ++iLayerIdx) {
+        code << "    layer" << iLayerIdx << "("
+             << (iLayerIdx == 0 ? string("input") : "layer" + to_string(iLayerIdx - 1) + "Out") << ", "
+             << (iLayerIdx + 1 == iLayerCount ? string("output") : "layer" + to_string(iLayerIdx) + "Out")
+             << ");\n";
+    }
+    code << "}\n\n";
+    code << "}  // namespace " << m_namespaceName << "\n\n#endif  // " << guard << "\n";
+
+    stream << code.str();
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeLayer
+//【函数功能】写出一层的constexpr常量表及前向函数
+//【参数】stream：输出流，layer：编译后的层，layerIndex：层索引
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNHeaderExporter::writeLayer(ostream& stream, const CompiledLayer& layer, int layerIndex) const {
+    const int64_t iWidth = layer.getWidth();
+    const int64_t iInputWidth = layer.getInputWidth();
+    const bool bElementwise = layer.isElementwise();
+    const vector<double>& weights = layer.getWeights();
+    const vector<double>& biases = layer.getBiases();
+    const vector<int32_t>& codes = layer.getActivationCodes();
+    const string prefix = "kLayer" + to_string(layerIndex);
+
+    bool bUniform = true;
+    for (int32_t iCode : codes) {
+        bUniform = bUniform && iCode == codes.front();
+    }
+    bool bUnrolled = static_cast<int64_t>(weights.size()) <= m_iUnrollLimit;
+
+    stream << "// Layer " << layerIndex << ": " << iWidth << " neurons"
+           << (bElementwise ? ", elementwise input" : ", " + to_string(iInputWidth) + " inputs each") << "\n";
+    stream << "static constexpr double " << prefix << "Bias[" << iWidth << "] = {";
+    for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+        stream << (iNeuronIdx == 0 ? "" : ", ") << formatLiteral(biases[iNeuronIdx]);
+    }
+    stream << "};\n";
+
+    if (bElementwise) {
+        stream << "static constexpr double " << prefix << "Weight[" << iWidth << "] = {";
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            stream << (iNeuronIdx == 0 ? "" : ", ") << formatLiteral(weights[iNeuronIdx]);
+        }
+        stream << "};\n";
+    } else if (iInputWidth > 0) {
+        stream << "static constexpr double " << prefix << "Weight[" << iWidth << "][" << iInputWidth << "] = {\n";
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            stream << "    {";
+            for (int64_t iInputIdx = 0; iInputIdx < iInputWidth; ++iInputIdx) {
+                stream << (iInputIdx == 0 ? "" : ", ") << formatLiteral(weights[iNeuronIdx * iInputWidth + iInputIdx]);
+            }
+            stream << "}" << (iNeuronIdx + 1 < iWidth ? "," : "") << "\n";
+        }
+        stream << "};\n";
+    }
+    if (!bUniform && !bUnrolled) {
+        stream << "static constexpr int " << prefix << "Activation[" << iWidth << "] = {";
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            stream << (iNeuronIdx == 0 ? "" : ", ") << codes[iNeuronIdx];
+        }
+        stream << "};\n";
+    }
+
+    stream << "static inline void layer" << layerIndex << "(const double* in, double* out) {\n";
+    if (bUnrolled) {
+        // One expression per neuron; left-to-right addition keeps the bias-first order
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            stream << "    out[" << iNeuronIdx << "] = " << getActivationHelperName(codes[iNeuronIdx]) << "("
+                   << prefix << "Bias[" << iNeuronIdx << "]";
+            if (bElementwise) {
+                stream << " + in[" << iNeuronIdx << "] * " << prefix << "Weight[" << iNeuronIdx << "]";
+            } else {
+                for (int64_t iInputIdx = 0; iInputIdx < iInputWidth; ++iInputIdx) {
+                    stream << " + in[" << iInputIdx << "] * " << prefix << "Weight[" << iNeuronIdx << "][" << iInputIdx << "]";
+                }
+            }
+            stream << ");\n";
+        }
+    } else {
+        string activation = bUniform ? getActivationHelperName(codes.front()) + "(sum)"
+                                     : "activate(" + prefix + "Activation[j], sum)";
+        stream << "    for (int j = 0; j < " << iWidth << "; ++j) {\n";
+        if (bElementwise) {
+            stream << "        double sum = " << prefix << "Bias[j] + in[j] * " << prefix << "Weight[j];\n";
+        } else {
+            stream << "        double sum = " << prefix << "Bias[j];\n";
+            if (iInputWidth > 0) {
+                stream << "        for (int k = 0; k < " << iInputWidth << "; ++k) {\n"
+                       << "            sum += in[k] * " << prefix << "Weight[j][k];\n"
+                       << "        }\n";
+            }
+        }
+        stream << "        out[j] = " << activation << ";\n";
+        stream << "    }\n";
+    }
+    if (iInputWidth == 0) {
+        stream << "    (void)in;\n";
+    }
+    stream << "}\n\n";
+}
+
+//-------------------------------------------------------------
+//【函数名称】formatLiteral
+//【函数功能】把double格式化为可精确读回的最短字面量
+//【参数】value：有限值
+//【返回值】string，字面量文本
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNHeaderExporter::formatLiteral(double value) {
+    // Shortest of 15-17 significant digits that reads back to the same double
+    string literal;
+    for (int iPrecision = 15; iPrecision <= 17; ++iPrecision) {
+        ostringstream text;
+        text << setprecision(iPrecision) << value;
+        literal = text.str();
+        if (strtod(literal.c_str(), nullptr) == value) {
+            break;
+        }
+    }
+    // "1" or "-0" would be integer literals; -0 would also lose its sign
+    if (literal.find_first_of(".e") == string::npos) {
+        literal += ".0";
+    }
+    return literal;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getActivationHelperName
+//【函数功能】获取激活函数代码对应的生成函数名
+//【参数】code：激活函数代码
+//【返回值】string，函数名
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNHeaderExporter::getActivationHelperName(int32_t code) {
+    switch (code) {
+        case 1:
+            return "activateSigmoid";
+        case 2:
+            return "activateTanh";
+        case 3:
+            return "activateReLU";
+        default:
+            return "activateLinear";
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】setNamespaceName
+//【函数功能】设置生成代码的命名空间
+//【参数】name：C++标识符
+//【返回值】bool，名称合法返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNHeaderExporter::setNamespaceName(const string& name) {
+    if (name.empty() || isdigit(static_cast<unsigned char>(name[0]))) {
+        return false;
+    }
+    for (char c : name) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            return false;
+        }
+    }
+    m_namespaceName = name;
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getNamespaceName
+//【函数功能】获取生成代码的命名空间
+//【参数】无
+//【返回值】const string&，命名空间名
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const string& ANNHeaderExporter::getNamespaceName() const {
+    return m_namespaceName;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setUnrollLimit
+//【函数功能】设置完全展开的每层权重数上限
+//【参数】limit：权重数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNHeaderExporter::setUnrollLimit(int64_t limit) {
+    m_iUnrollLimit = limit;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getUnrollLimit
+//【函数功能】获取完全展开的每层权重数上限
+//【参数】无
+//【返回值】int64_t，权重数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ANNHeaderExporter::getUnrollLimit() const {
+    return m_iUnrollLimit;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getSupportedExtensions
+//【函数功能】获取支持的文件扩展名
+//【参数】无
+//【返回值】string，扩展名
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNHeaderExporter::getSupportedExtensions() const {
+    return ".hpp .h";
+}
+
+//-------------------------------------------------------------
+//【函数名称】getExporterName
+//【函数功能】获取导出器名称
+//【参数】无
+//【返回值】string，导出器名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNHeaderExporter::getExporterName() const {
+    return "ANN Header Exporter";
+}
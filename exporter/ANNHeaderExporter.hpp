@@ -0,0 +1,146 @@
+//-------------------------------------------------------------
+//【文件名】ANNHeaderExporter.hpp
+//【功能模块和目的】独立C++头文件代码生成导出器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef AnnHeaderExporter_hpp
+#define AnnHeaderExporter_hpp
+
+#include "BaseExporter.hpp"
+#include "../model/inference_engine/CompiledLayer.hpp"
+#include <ostream>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ANNHeaderExporter
+//【功能】把网络生成为只依赖<cmath>的独立C++头文件，权重以constexpr数组编入代码
+//【说明】每层生成一个static inline函数，循环次数为编译期常量；权重数不超过展开上限的层
+//       完全展开为逐神经元表达式。求和顺序（偏置在先、按树突顺序累加）和激活函数公式
+//       与Network::predict相同。生成的predict(const double* input, double* output)
+//       及kInputSize/kOutputSize位于指定命名空间内，所有符号均为内部链接，
+//       可被多个翻译单元同时包含。适用于小而稳定的模型。编译生成代码时若允许浮点乘加融合
+//       （如GCC配合-mfma/-march=native），结果可能在最后一位上与predict不同，需要逐位一致时使用-ffp-contract=off
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class ANNHeaderExporter : public BaseExporter {
+private:
+    string m_namespaceName;   // Namespace wrapping the generated code
+    int64_t m_iUnrollLimit;   // Layers with at most this many weights are fully unrolled
+
+    /**
+     * @brief Write one layer's constexpr tables and its forward function
+     * @param stream Output stream
+     * @param layer Compiled layer
+     * @param layerIndex Index used in generated names
+     */
+    void writeLayer(ostream& stream, const CompiledLayer& layer, int layerIndex) const;
+
+    /**
+     * @brief Format a double as a literal that reads back to the same value
+     * @param value Finite value
+     * @return Shortest literal of 15 to 17 significant digits
+     */
+    static string formatLiteral(double value);
+
+    /**
+     * @brief Name of the generated activation helper for a code
+     * @param code Activation code as in CompiledLayer
+     * @return Function name such as "activateSigmoid"
+     */
+    static string getActivationHelperName(int32_t code);
+
+public:
+    static const int64_t DEFAULT_UNROLL_LIMIT = 64;  // 默认展开上限（每层权重数）
+
+    /**
+     * @brief Constructor
+     */
+    ANNHeaderExporter();
+
+    //-------------------------------------------------------------
+    //【函数名称】ANNHeaderExporter（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的导出器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNHeaderExporter(const ANNHeaderExporter& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源导出器
+    //【返回值】ANNHeaderExporter&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNHeaderExporter& operator=(const ANNHeaderExporter& other) = default;
+
+    /**
+     * @brief Destructor
+     */
+    ~ANNHeaderExporter() = default;
+
+    /**
+     * @brief Generate a standalone C++ header file
+     * @param network Network to export
+     * @param filename Path to output file (.hpp or .h)
+     * @return True if export successful
+     */
+    bool exportNetwork(const Network& network, const string& filename) override;
+
+    /**
+     * @brief Generate a standalone C++ header into a stream
+     * @param network Network to export
+     * @param stream Destination stream
+     * @return True if export successful, false if the network cannot be run by predict()
+     *         or holds a non-finite weight or bias
+     */
+    bool exportNetwork(const Network& network, ostream& stream) override;
+
+    /**
+     * @brief Set the namespace of the generated code (also used for the include guard)
+     * @param name C++ identifier
+     * @return True if the name is a valid identifier
+     */
+    bool setNamespaceName(const string& name);
+
+    /**
+     * @brief Get the namespace of the generated code
+     * @return Namespace name, "generated_network" by default
+     */
+    const string& getNamespaceName() const;
+
+    /**
+     * @brief Set the largest per-layer weight count that is fully unrolled
+     * @param limit Weight count; 0 keeps every layer as constant-bound loops
+     */
+    void setUnrollLimit(int64_t limit);
+
+    /**
+     * @brief Get the per-layer unroll limit
+     * @return Weight count
+     */
+    int64_t getUnrollLimit() const;
+
+    /**
+     * @brief Get supported file extensions
+     * @return ".hpp .h"
+     */
+    string getSupportedExtensions() const override;
+
+    /**
+     * @brief Get exporter name
+     * @return Exporter name
+     */
+    string getExporterName() const override;
+};
+
+#endif // AnnHeaderExporter_hpp
@@ -0,0 +1,245 @@
+//-------------------------------------------------------------
+//【文件名】ANNPatchExporter.cpp
+//【功能模块和目的】网络差异补丁（.annp）导出器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ANNPatchExporter.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】ANNPatchExporter
+//【函数功能】构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ANNPatchExporter::ANNPatchExporter() : m_iLastChangeCount(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~ANNPatchExporter
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ANNPatchExporter::~ANNPatchExporter() = default;
+
+//-------------------------------------------------------------
+//【函数名称】exportPatch
+//【函数功能】将基准网络到目标网络的差异写入输出流
+//【参数】base：基准网络，target：修改后网络，stream：输出流
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 写出基准网络的参数指纹
+//-------------------------------------------------------------
+bool ANNPatchExporter::exportPatch(const Network& base, const Network& target, ostream& stream) {
+    m_iLastChangeCount = 0;
+    if (!stream.good() || base.getLayerCount() == 0 || base.getLayerCount() != target.getLayerCount()) {
+        return false;
+    }
+    for (int iLayerIdx = 0; iLayerIdx < base.getLayerCount(); ++iLayerIdx) {
+        if (base.getLayerNeuronCount(iLayerIdx) != target.getLayerNeuronCount(iLayerIdx)) {
+            return false;
+        }
+    }
+    
+    // Weights must survive the round trip exactly
+    ios_base::fmtflags savedFlags = stream.flags();
+    streamsize savedPrecision = stream.precision();
+    stream.unsetf(ios_base::floatfield);
+    stream << setprecision(17);
+    
+    stream << "# ANN Patch File" << endl;
+    stream << "P " << hex << base.getTopologyFingerprint() << dec;
+    for (int iLayerIdx = 0; iLayerIdx < base.getLayerCount(); ++iLayerIdx) {
+        stream << " " << base.getLayerNeuronCount(iLayerIdx);
+    }
+    stream << endl;
+    stream << "H " << hex << base.getParameterFingerprint() << dec << endl;
+    
+    map<const Neuron*, int> baseIndex = buildGlobalIndexMap(base);
+    map<const Neuron*, int> targetIndex = buildGlobalIndexMap(target);
+    int iGlobalIndex = 0;
+    for (int iLayerIdx = 0; iLayerIdx < base.getLayerCount(); ++iLayerIdx) {
+        const Layer* pBaseLayer = base.getLayer(iLayerIdx);
+        const Layer* pTargetLayer = target.getLayer(iLayerIdx);
+        for (int iNeuronIdx = 0; iNeuronIdx < pBaseLayer->getNeuronCount(); ++iNeuronIdx) {
+            writeNeuronDiff(stream, iGlobalIndex++, *pBaseLayer->getNeuron(iNeuronIdx),
+                            *pTargetLayer->getNeuron(iNeuronIdx), baseIndex, targetIndex);
+        }
+    }
+    
+    stream.flags(savedFlags);
+    stream.precision(savedPrecision);
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportPatch
+//【函数功能】将差异补丁写入文件
+//【参数】base：基准网络，target：修改后网络，filename：文件名
+//【返回值】bool，是否导出成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNPatchExporter::exportPatch(const Network& base, const Network& target, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    if (!exportPatch(base, target, file)) {
+        return false;
+    }
+    
+    file.close();
+    return !file.fail();
+}
+
+//-------------------------------------------------------------
+//【函数名称】exportPatchToString
+//【函数功能】将差异补丁写入内存字符串
+//【参数】base：基准网络，target：修改后网络
+//【返回值】string，补丁内容，失败返回空字符串
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNPatchExporter::exportPatchToString(const Network& base, const Network& target) {
+    ostringstream stream;
+    if (!exportPatch(base, target, stream)) {
+        return "";
+    }
+    return stream.str();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLastChangeCount
+//【函数功能】获取上次导出的变更记录数
+//【参数】无
+//【返回值】int，记录数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int ANNPatchExporter::getLastChangeCount() const {
+    return m_iLastChangeCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】buildGlobalIndexMap
+//【函数功能】建立神经元指针到全局索引的映射
+//【参数】network：网络引用
+//【返回值】map<const Neuron*, int>，映射表
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+map<const Neuron*, int> ANNPatchExporter::buildGlobalIndexMap(const Network& network) const {
+    map<const Neuron*, int> globalIndex;
+    int iNextIndex = 0;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        const Layer* pLayer = network.getLayer(iLayerIdx);
+        for (int iNeuronIdx = 0; iNeuronIdx < pLayer->getNeuronCount(); ++iNeuronIdx) {
+            globalIndex[pLayer->getNeuron(iNeuronIdx)] = iNextIndex++;
+        }
+    }
+    return globalIndex;
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeNeuronDiff
+//【函数功能】写出单个神经元的变更记录：按顺序匹配树突来源，未匹配的旧树突删除，
+//           剩余的新树突追加，匹配上的树突只在权重不同时写W记录
+//【参数】stream：输出流，globalIndex：全局索引，base/target：新旧神经元，baseIndex/targetIndex：索引映射
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNPatchExporter::writeNeuronDiff(ostream& stream, int globalIndex, const Neuron& base, const Neuron& target,
+                                       const map<const Neuron*, int>& baseIndex,
+                                       const map<const Neuron*, int>& targetIndex) {
+    auto sourceOf = [](const Synapse* synapse, const map<const Neuron*, int>& index) {
+        auto found = index.find(synapse->getSourceNeuron());
+        return found == index.end() ? -1 : found->second;
+    };
+    
+    // Greedy in-order match: kept dendrites become the prefix of the target's list
+    vector<int> removed;
+    vector<int> keptFrom;  // Base dendrite index for each matched target dendrite
+    int iTargetCount = target.getInputSynapseCount();
+    for (int iBaseIdx = 0; iBaseIdx < base.getInputSynapseCount(); ++iBaseIdx) {
+        int iMatched = static_cast<int>(keptFrom.size());
+        if (iMatched < iTargetCount &&
+            sourceOf(base.getInputSynapse(iBaseIdx), baseIndex) ==
+            sourceOf(target.getInputSynapse(iMatched), targetIndex)) {
+            keptFrom.push_back(iBaseIdx);
+        } else {
+            removed.push_back(iBaseIdx);
+        }
+    }
+    
+    // Highest index first so earlier removals do not shift later ones
+    for (auto it = removed.rbegin(); it != removed.rend(); ++it) {
+        stream << "X " << globalIndex << " " << *it << endl;
+        ++m_iLastChangeCount;
+    }
+    for (size_t uKeptIdx = 0; uKeptIdx < keptFrom.size(); ++uKeptIdx) {
+        double rOld = base.getInputSynapse(keptFrom[uKeptIdx])->getWeight();
+        double rNew = target.getInputSynapse(static_cast<int>(uKeptIdx))->getWeight();
+        if (rOld != rNew) {
+            stream << "W " << globalIndex << " " << uKeptIdx << " " << rNew << endl;
+            ++m_iLastChangeCount;
+        }
+    }
+    for (int iTargetIdx = static_cast<int>(keptFrom.size()); iTargetIdx < iTargetCount; ++iTargetIdx) {
+        const Synapse* pSynapse = target.getInputSynapse(iTargetIdx);
+        stream << "E " << sourceOf(pSynapse, targetIndex) << " " << globalIndex << " "
+               << pSynapse->getWeight() << endl;
+        ++m_iLastChangeCount;
+    }
+    
+    if (base.getBias() != target.getBias()) {
+        stream << "B " << globalIndex << " " << target.getBias() << endl;
+        ++m_iLastChangeCount;
+    }
+    
+    // A missing activation function behaves as Linear
+    string baseActivation = base.getActivationFunction() ? base.getActivationFunction()->getName() : "Linear";
+    string targetActivation = target.getActivationFunction() ? target.getActivationFunction()->getName() : "Linear";
+    if (baseActivation != targetActivation) {
+        stream << "A " << globalIndex << " " << targetActivation << endl;
+        ++m_iLastChangeCount;
+    }
+    
+    int iTargetOutputs = countExternalOutputs(target);
+    if (countExternalOutputs(base) != iTargetOutputs) {
+        stream << "O " << globalIndex << " " << iTargetOutputs << endl;
+        ++m_iLastChangeCount;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】countExternalOutputs
+//【函数功能】统计指向外部输出的轴突数量
+//【参数】neuron：神经元
+//【返回值】int，数量
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int ANNPatchExporter::countExternalOutputs(const Neuron& neuron) const {
+    int iCount = 0;
+    for (int iSynapseIdx = 0; iSynapseIdx < neuron.getOutputSynapseCount(); ++iSynapseIdx) {
+        if (neuron.getOutputSynapse(iSynapseIdx)->getTargetNeuron() == nullptr) {
+            ++iCount;
+        }
+    }
+    return iCount;
+}
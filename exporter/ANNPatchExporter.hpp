@@ -0,0 +1,131 @@
+//-------------------------------------------------------------
+//【文件名】ANNPatchExporter.hpp
+//【功能模块和目的】网络差异补丁（.annp）导出器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef AnnPatchExporter_hpp
+#define AnnPatchExporter_hpp
+
+#include "../model/neural_components/Network.hpp"
+#include <string>
+#include <ostream>
+#include <map>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ANNPatchExporter
+//【功能】比较基准网络与修改后网络，只写出变化部分的文本补丁
+//【说明】两个网络的层数和各层神经元数必须相同（增删层或神经元需完整导出）。
+//       补丁格式（神经元使用与ANN文件相同的全局索引）：
+//         P fingerprint n0 n1 ...   基准网络的拓扑指纹（十六进制）与各层宽度
+//         H fingerprint             基准网络的参数指纹（十六进制，偏置、权重和激活函数）
+//         X neuron dendrite         删除树突（同时删除来源神经元的对应轴突）
+//         W neuron dendrite weight  修改树突权重（索引为删除之后的位置）
+//         E from neuron weight      追加连接，from为-1表示外部输入
+//         B neuron bias             修改偏置
+//         A neuron name             修改激活函数
+//         O neuron count            设置外部输出轴突数量
+//       同一神经元的记录按X（索引降序）、W、E的顺序写出，应用后树突顺序与目标网络一致，
+//       因此推理结果相同。补丁只能应用到拓扑和参数指纹都相符的网络上，
+//       应用后参数已经改变，因此同一补丁不能重复应用（没有变更记录的空补丁除外）
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 文件头增加基准网络的参数指纹（H记录）
+//-------------------------------------------------------------
+class ANNPatchExporter {
+private:
+    int m_iLastChangeCount;  ///< Change records written by the last export
+    
+    /**
+     * @brief Map every neuron of a network to its global index
+     * @param network Network to index
+     * @return Neuron pointer to global index
+     */
+    map<const Neuron*, int> buildGlobalIndexMap(const Network& network) const;
+    
+    /**
+     * @brief Write the records that turn one neuron into its counterpart
+     * @param stream Output stream
+     * @param globalIndex Global index of the neuron
+     * @param base Neuron in the base network
+     * @param target Neuron in the modified network
+     * @param baseIndex Global index map of the base network
+     * @param targetIndex Global index map of the modified network
+     */
+    void writeNeuronDiff(ostream& stream, int globalIndex, const Neuron& base, const Neuron& target,
+                         const map<const Neuron*, int>& baseIndex, const map<const Neuron*, int>& targetIndex);
+    
+    /**
+     * @brief Count axons of a neuron that lead to the external output
+     * @param neuron Neuron to inspect
+     * @return Number of external output axons
+     */
+    int countExternalOutputs(const Neuron& neuron) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    ANNPatchExporter();
+    
+    //-------------------------------------------------------------
+    //【函数名称】ANNPatchExporter（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的补丁导出器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNPatchExporter(const ANNPatchExporter& other) = default;
+    
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源补丁导出器
+    //【返回值】ANNPatchExporter&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNPatchExporter& operator=(const ANNPatchExporter& other) = default;
+    
+    /**
+     * @brief Destructor
+     */
+    ~ANNPatchExporter();
+    
+    /**
+     * @brief Write the patch that turns base into target to a stream
+     * @param base Network the patch will be applied to
+     * @param target Network after the edits
+     * @param stream Destination stream; its formatting flags are restored afterwards
+     * @return True if written, false if the layer shapes differ
+     */
+    bool exportPatch(const Network& base, const Network& target, ostream& stream);
+    
+    /**
+     * @brief Write the patch that turns base into target to a file
+     * @param base Network the patch will be applied to
+     * @param target Network after the edits
+     * @param filename Path to output patch file
+     * @return True if export successful
+     */
+    bool exportPatch(const Network& base, const Network& target, const string& filename);
+    
+    /**
+     * @brief Write the patch to an in-memory string
+     * @param base Network the patch will be applied to
+     * @param target Network after the edits
+     * @return Patch text, empty on failure
+     */
+    string exportPatchToString(const Network& base, const Network& target);
+    
+    /**
+     * @brief Get the number of change records written by the last export
+     * @return Record count, excluding the P and H headers (0 means the networks are identical)
+     */
+    int getLastChangeCount() const;
+};
+
+#endif // AnnPatchExporter_hpp
@@ -8,6 +8,7 @@
 #include "BaseExporter.hpp"
 #include "../utils/FileUtils.hpp"
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 
@@ -30,6 +31,22 @@ bool BaseExporter::isFormatSupported(const string& filename) const {
     return supportedExts.find(extension) != string::npos;
 }
 
+//-------------------------------------------------------------
+//【函数名称】exportNetworkToString
+//【函数功能】导出神经网络到内存字符串
+//【参数】network：网络引用
+//【返回值】string，序列化内容，失败返回空字符串
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string BaseExporter::exportNetworkToString(const Network& network) {
+    ostringstream stream;
+    if (!exportNetwork(network, stream)) {
+        return "";
+    }
+    return stream.str();
+}
+
 //-------------------------------------------------------------
 //【函数名称】getFileExtension
 //【函数功能】获取文件扩展名
@@ -10,6 +10,7 @@
 
 #include "../model/neural_components/Network.hpp"
 #include <string>
+#include <ostream>
 
 using namespace std;
 
@@ -74,6 +75,29 @@ public:
     //-------------------------------------------------------------
     virtual bool exportNetwork(const Network& network, const string& filename) = 0;
     
+    //-------------------------------------------------------------
+    //【函数名称】exportNetwork
+    //【函数功能】导出神经网络到输出流（管道、内存缓冲区等）
+    //【参数】
+    //  const Network& network - 要导出的网络
+    //  ostream& stream - 目标输出流
+    //【返回值】导出成功返回true，失败返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool exportNetwork(const Network& network, ostream& stream) = 0;
+    
+    //-------------------------------------------------------------
+    //【函数名称】exportNetworkToString
+    //【函数功能】导出神经网络到内存字符串
+    //【参数】
+    //  const Network& network - 要导出的网络
+    //【返回值】序列化后的模型内容，导出失败返回空字符串
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string exportNetworkToString(const Network& network);
+    
     //-------------------------------------------------------------
     //【函数名称】getSupportedExtensions
     //【函数功能】获取支持的文件扩展名
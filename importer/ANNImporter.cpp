@@ -16,10 +16,14 @@
 #include "../model/activation_functions/TanhFunction.hpp"
 #include "../model/activation_functions/ActivationFunction.hpp"
 #include "../utils/FileUtils.hpp"
+#include "../utils/MemoryStreamBuffer.hpp"
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <cstdint>
 
 using namespace std;
 
@@ -31,7 +35,7 @@ using namespace std;
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-ANNImporter::ANNImporter() {
+ANNImporter::ANNImporter() : m_contentStart(0), m_bLazyLoading(false) {
 }
 
 //-------------------------------------------------------------
@@ -50,33 +54,61 @@ ANNImporter::~ANNImporter() = default;
 //【参数】filename：文件名
 //【返回值】unique_ptr<Network>，导入的网络指针
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 解析逻辑移至流版本，本函数只负责打开文件；支持延迟加载模式
 //-------------------------------------------------------------
 unique_ptr<Network> ANNImporter::importNetwork(const string& filename) {
     if (!isFormatSupported(filename)) {
         return nullptr;
     }
     
+    if (m_bLazyLoading) {
+        return importNetworkLazily(filename);
+    }
+    
     ifstream file(filename);
     if (!file.is_open()) {
         return nullptr;
     }
     
+    return importNetwork(file);
+}
+
+//-------------------------------------------------------------
+//【函数名称】importNetwork
+//【函数功能】从输入流导入神经网络
+//【参数】stream：输入流
+//【返回值】unique_ptr<Network>，导入的网络指针
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+unique_ptr<Network> ANNImporter::importNetwork(istream& stream) {
+    // The parser makes several passes over the input, so it needs a seekable stream.
+    // Pipes and sockets are drained once into memory and parsed from there.
+    if (stream.tellg() == streampos(-1)) {
+        stream.clear();
+        string content((istreambuf_iterator<char>(stream)), istreambuf_iterator<char>());
+        MemoryStreamBuffer buffer(content.data(), content.size());
+        istream memoryStream(&buffer);
+        return importNetwork(memoryStream);
+    }
+    
+    // Later passes rewind to here, so content may start mid-stream
+    m_contentStart = stream.tellg();
     auto network = unique_ptr<Network>(new Network());
     
     try {
         // Parse network header
-        if (!parseNetworkHeader(file, *network)) {
+        if (!parseNetworkHeader(stream, *network)) {
             return nullptr;
         }
         
         // Parse layer information
-        if (!parseLayerInformation(file, *network)) {
+        if (!parseLayerInformation(stream, *network)) {
             return nullptr;
         }
         
         // Parse connections
-        if (!parseConnections(file, *network)) {
+        if (!parseConnections(stream, *network)) {
             return nullptr;
         }
         
@@ -92,6 +124,39 @@ unique_ptr<Network> ANNImporter::importNetwork(const string& filename) {
     }
 }
 
+//-------------------------------------------------------------
+//【函数名称】isContentSupported
+//【函数功能】检查首条非注释记录是否为ANN记录
+//【参数】stream：输入流
+//【返回值】bool，是否为ANN格式
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNImporter::isContentSupported(istream& stream) const {
+    streampos start = stream.tellg();
+    if (start == streampos(-1)) {
+        return false; // Cannot sniff without consuming a non-seekable stream
+    }
+    
+    bool bSupported = false;
+    string line;
+    while (getline(stream, line)) {
+        size_t uFirst = line.find_first_not_of(" \t\r");
+        if (uFirst == string::npos || line[uFirst] == '#') {
+            continue;
+        }
+        
+        char cPrefix = line[uFirst];
+        bSupported = (cPrefix == 'G' || cPrefix == 'N' || cPrefix == 'L' ||
+                      cPrefix == 'S' || cPrefix == 'D');
+        break;
+    }
+    
+    stream.clear();
+    stream.seekg(start);
+    return bSupported;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getSupportedExtensions
 //【函数功能】获取支持的文件扩展名
@@ -116,6 +181,30 @@ string ANNImporter::getImporterName() const {
     return "ANN Importer";
 }
 
+//-------------------------------------------------------------
+//【函数名称】setLazyLoading
+//【函数功能】设置从文件导入时是否延迟加载各层权重
+//【参数】enabled：是否延迟加载
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNImporter::setLazyLoading(bool enabled) {
+    m_bLazyLoading = enabled;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isLazyLoading
+//【函数功能】查询是否延迟加载
+//【参数】无
+//【返回值】bool，是否延迟加载
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNImporter::isLazyLoading() const {
+    return m_bLazyLoading;
+}
+
 //-------------------------------------------------------------
 //【函数名称】parseNetworkHeader
 //【函数功能】解析网络头部信息
@@ -124,7 +213,7 @@ string ANNImporter::getImporterName() const {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-bool ANNImporter::parseNetworkHeader(ifstream& file, Network& network) {
+bool ANNImporter::parseNetworkHeader(istream& file, Network& network) {
     string line;
     
     // Read lines until we find the network name or end of file
@@ -159,16 +248,16 @@ bool ANNImporter::parseNetworkHeader(ifstream& file, Network& network) {
 //【参数】file：文件流，network：网络对象
 //【返回值】解析成功返回true，失败返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 改为读取istream，从内容起始位置重新扫描
 //-------------------------------------------------------------
-bool ANNImporter::parseLayerInformation(ifstream& file, Network& network) {
+bool ANNImporter::parseLayerInformation(istream& file, Network& network) {
     string line;
     vector<pair<double, int>> neurons; // bias, activation function type
     vector<pair<int, int>> layers; // start neuron, end neuron
     
-    // Reset file position to beginning
+    // Reset position to the beginning of the model content
     file.clear();
-    file.seekg(0, ios::beg);
+    file.seekg(m_contentStart);
     
     // First pass: collect neuron and layer information
     while (getline(file, line)) {
@@ -223,7 +312,7 @@ bool ANNImporter::parseLayerInformation(ifstream& file, Network& network) {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-bool ANNImporter::parseNeuronInformation(ifstream& file, Layer& layer, int neuronCount) {
+bool ANNImporter::parseNeuronInformation(istream& file, Layer& layer, int neuronCount) {
     for (int iNeuronIdx = 0; iNeuronIdx < neuronCount; ++iNeuronIdx) {
         skipWhitespaceAndComments(file);
         
@@ -264,17 +353,21 @@ bool ANNImporter::parseNeuronInformation(ifstream& file, Layer& layer, int neuro
 //【参数】file：文件流，network：网络对象
 //【返回值】解析成功返回true，失败返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 支持稠密块（D）记录，神经元查找改为索引表；改为读取istream
 //-------------------------------------------------------------
-bool ANNImporter::parseConnections(ifstream& file, Network& network) {
+bool ANNImporter::parseConnections(istream& file, Network& network) {
     string line;
     vector<string> invalidAxonConnections; // Track invalid axon weights
     
-    // Reset file position to beginning  
+    // Resolve global neuron indices through a table instead of a linear search per record
+    vector<Neuron*> neuronTable = buildNeuronTable(network);
+    
+    // Reset position to the beginning of the model content
     file.clear();
-    file.seekg(0, ios::beg);
+    file.seekg(m_contentStart);
     
     // Parse synapse connections with format: S from_neuron to_neuron weight
+    // and dense blocks with format: D from_layer to_layer, followed by the weight rows
     while (getline(file, line)) {
         if (line.empty() || line[0] == '#') {
             continue;
@@ -284,69 +377,166 @@ bool ANNImporter::parseConnections(ifstream& file, Network& network) {
         char cPrefix;
         iss >> cPrefix;
         
+        if (cPrefix == 'D') {
+            int iFromLayer;
+            int iToLayer;
+            if (!(iss >> iFromLayer >> iToLayer) || iFromLayer == iToLayer) {
+                return false;
+            }
+            Layer* pSourceLayer = network.getLayer(iFromLayer);
+            Layer* pTargetLayer = network.getLayer(iToLayer);
+            if (!pSourceLayer || !pTargetLayer || !parseDenseBlock(file, *pSourceLayer, *pTargetLayer)) {
+                return false;
+            }
+            continue;
+        }
+        
         if (cPrefix == 'S') {
             int iFromNeuron;
             int iToNeuron;
             double rWeight;
             
             if (iss >> iFromNeuron >> iToNeuron >> rWeight) {
-                // Handle external input connections (from -1)
-                if (iFromNeuron == -1 && iToNeuron >= 0) {
-                    // This is a dendrite (input synapse) - weight can be any value
-                    Neuron* pTargetNeuron = findNeuronByGlobalIndex(network, iToNeuron);
-                    if (pTargetNeuron) {
-                        unique_ptr<Synapse> synapse(new Synapse(rWeight, nullptr, pTargetNeuron, false));
-                        pTargetNeuron->addInputSynapse(move(synapse));
-                    }
-                    continue;
-                }
-                
-                // Handle external output connections (to -1)
-                if (iToNeuron == -1 && iFromNeuron >= 0) {
-                    // This is an axon (output synapse) - weight MUST be 1.0 per specification
-                    if (rWeight != 1.0) {
-                        // Record invalid axon weight but continue importing with corrected weight
-                        ostringstream oss;
-                        oss << "Invalid axon weight " << rWeight << " for connection from neuron " 
-                            << iFromNeuron << " to output (should be 1.0)";
-                        invalidAxonConnections.push_back(oss.str());
-                    }
-                    Neuron* pSourceNeuron = findNeuronByGlobalIndex(network, iFromNeuron);
-                    if (pSourceNeuron) {
-                        // Create synapse with corrected weight (constructor will force 1.0 anyway)
-                        unique_ptr<Synapse> synapse(new Synapse(1.0, pSourceNeuron, nullptr, true));
-                        pSourceNeuron->addOutputSynapse(move(synapse));
-                    }
-                    continue;
-                }
-                
-                // Handle inter-neuron connections
-                if (iFromNeuron >= 0 && iToNeuron >= 0) {
-                    // For inter-neuron connections, connectTo() will create both axon (weight 1.0) 
-                    // and dendrite (weight from file). The actual connection weight goes to the dendrite.
-                    Neuron* pSourceNeuron = findNeuronByGlobalIndex(network, iFromNeuron);
-                    Neuron* pTargetNeuron = findNeuronByGlobalIndex(network, iToNeuron);
-                    
-                    if (pSourceNeuron && pTargetNeuron) {
-                        pSourceNeuron->connectTo(*pTargetNeuron, rWeight);
-                    }
-                }
+                applySynapseRecord(iFromNeuron, iToNeuron, rWeight, neuronTable, invalidAxonConnections);
             }
         }
     }
     
-    // If we found invalid axon weights, cache the error information
-    if (!invalidAxonConnections.empty()) {
-        ostringstream errorMsg;
-        errorMsg << "File contains invalid axon weights (axon weights must be 1.0 per specification):\n";
-        for (const auto& error : invalidAxonConnections) {
-            errorMsg << "  - " << error << "\n";
+    recordInvalidAxonWeights(network, invalidAxonConnections);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】applySynapseRecord
+//【函数功能】按一条S记录创建突触
+//【参数】fromNeuron：源神经元全局索引（-1为外部输入），toNeuron：目标神经元全局索引（-1为外部输出），
+//       weight：权重，neuronTable：神经元查找表，invalidAxons：收集非法轴突权重的说明
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNImporter::applySynapseRecord(int fromNeuron, int toNeuron, double weight,
+                                     const vector<Neuron*>& neuronTable, vector<string>& invalidAxons) {
+    // Handle external input connections (from -1)
+    if (fromNeuron == -1 && toNeuron >= 0) {
+        // This is a dendrite (input synapse) - weight can be any value
+        Neuron* pTargetNeuron = lookupNeuron(neuronTable, toNeuron);
+        if (pTargetNeuron) {
+            unique_ptr<Synapse> synapse(new Synapse(weight, nullptr, pTargetNeuron, false));
+            pTargetNeuron->addInputSynapse(move(synapse));
         }
-        errorMsg << "Network has been imported with corrected weights, but original file is non-compliant.";
-        network.setImportError(errorMsg.str());
+        return;
     }
     
-    return true;
+    // Handle external output connections (to -1)
+    if (toNeuron == -1 && fromNeuron >= 0) {
+        // This is an axon (output synapse) - weight MUST be 1.0 per specification
+        if (weight != 1.0) {
+            // Record invalid axon weight but continue importing with corrected weight
+            invalidAxons.push_back(describeInvalidAxonWeight(fromNeuron, weight));
+        }
+        Neuron* pSourceNeuron = lookupNeuron(neuronTable, fromNeuron);
+        if (pSourceNeuron) {
+            // Create synapse with corrected weight (constructor will force 1.0 anyway)
+            unique_ptr<Synapse> synapse(new Synapse(1.0, pSourceNeuron, nullptr, true));
+            pSourceNeuron->addOutputSynapse(move(synapse));
+        }
+        return;
+    }
+    
+    // Handle inter-neuron connections
+    if (fromNeuron >= 0 && toNeuron >= 0) {
+        // For inter-neuron connections, connectTo() will create both axon (weight 1.0) 
+        // and dendrite (weight from file). The actual connection weight goes to the dendrite.
+        Neuron* pSourceNeuron = lookupNeuron(neuronTable, fromNeuron);
+        Neuron* pTargetNeuron = lookupNeuron(neuronTable, toNeuron);
+        
+        if (pSourceNeuron && pTargetNeuron) {
+            pSourceNeuron->connectTo(*pTargetNeuron, weight);
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】describeInvalidAxonWeight
+//【函数功能】生成非法轴突权重的说明文字
+//【参数】fromNeuron：源神经元全局索引，weight：文件中的权重
+//【返回值】string，说明文字
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string ANNImporter::describeInvalidAxonWeight(int fromNeuron, double weight) {
+    ostringstream oss;
+    oss << "Invalid axon weight " << weight << " for connection from neuron " 
+        << fromNeuron << " to output (should be 1.0)";
+    return oss.str();
+}
+
+//-------------------------------------------------------------
+//【函数名称】recordInvalidAxonWeights
+//【函数功能】将非法轴突权重汇总为网络的导入错误
+//【参数】network：网络对象，invalidAxons：非法轴突权重说明
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNImporter::recordInvalidAxonWeights(Network& network, const vector<string>& invalidAxons) {
+    if (invalidAxons.empty()) {
+        return;
+    }
+    
+    ostringstream errorMsg;
+    errorMsg << "File contains invalid axon weights (axon weights must be 1.0 per specification):\n";
+    for (const auto& error : invalidAxons) {
+        errorMsg << "  - " << error << "\n";
+    }
+    errorMsg << "Network has been imported with corrected weights, but original file is non-compliant.";
+    network.setImportError(errorMsg.str());
+}
+
+//-------------------------------------------------------------
+//【函数名称】parseDenseBlock
+//【函数功能】解析稠密块：源层每个神经元一行，按目标层神经元顺序给出权重
+//【参数】file：文件流，sourceLayer：源层，targetLayer：目标层
+//【返回值】解析成功返回true，权重行不完整或多出内容返回false
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 权重之后还有非空白内容的行视为格式错误
+//-------------------------------------------------------------
+bool ANNImporter::parseDenseBlock(istream& file, Layer& sourceLayer, Layer& targetLayer) {
+    int iRowCount = sourceLayer.getNeuronCount();
+    int iColumnCount = targetLayer.getNeuronCount();
+    string line;
+    int iRow = 0;
+    
+    while (iRow < iRowCount && getline(file, line)) {
+        size_t uFirst = line.find_first_not_of(" \t\r");
+        if (uFirst == string::npos || line[uFirst] == '#') {
+            continue;
+        }
+        
+        // Row-major: row = source neuron, column = target neuron (same order as connectToLayer)
+        Neuron* pSourceNeuron = sourceLayer.getNeuron(iRow);
+        const char* pCursor = line.c_str() + uFirst;
+        for (int iColumn = 0; iColumn < iColumnCount; ++iColumn) {
+            char* pEnd = nullptr;
+            double rWeight = strtod(pCursor, &pEnd);
+            if (pEnd == pCursor) {
+                return false; // Missing or malformed weight
+            }
+            pSourceNeuron->connectTo(*targetLayer.getNeuron(iColumn), rWeight);
+            pCursor = pEnd;
+        }
+        // A longer row means the block does not match the layer widths
+        while (isspace(static_cast<unsigned char>(*pCursor))) {
+            ++pCursor;
+        }
+        if (*pCursor != '\0') {
+            return false;
+        }
+        ++iRow;
+    }
+    
+    return iRow == iRowCount;
 }
 
 //-------------------------------------------------------------
@@ -357,7 +547,7 @@ bool ANNImporter::parseConnections(ifstream& file, Network& network) {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-void ANNImporter::skipWhitespaceAndComments(ifstream& file) {
+void ANNImporter::skipWhitespaceAndComments(istream& file) {
     char ch;
     while (file.get(ch)) {
         if (isspace(ch)) {
@@ -384,7 +574,7 @@ void ANNImporter::skipWhitespaceAndComments(ifstream& file) {
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-string ANNImporter::readToken(ifstream& file) {
+string ANNImporter::readToken(istream& file) {
     skipWhitespaceAndComments(file);
     
     string token;
@@ -452,27 +642,475 @@ unique_ptr<Neuron> ANNImporter::createNeuronWithActivation(double bias, int acti
 }
 
 //-------------------------------------------------------------
-//【函数名称】findNeuronByGlobalIndex
-//【函数功能】根据全局索引查找神经元
-//【参数】network：网络引用，globalIndex：全局索引
-//【返回值】Neuron*，找到的神经元指针，未找到返回nullptr
-//【开发者及日期】林钲凯 2025-07-27
+//【函数名称】buildNeuronTable
+//【函数功能】按全局索引顺序建立神经元查找表
+//【参数】network：网络引用
+//【返回值】vector<Neuron*>，下标即全局索引
+//【开发者及日期】林钲凯 2026-10-18
 //【更改记录】
 //-------------------------------------------------------------
-Neuron* ANNImporter::findNeuronByGlobalIndex(Network& network, int globalIndex) {
-    int iCurrentIndex = 0;
+vector<Neuron*> ANNImporter::buildNeuronTable(Network& network) {
+    vector<Neuron*> neuronTable;
+    neuronTable.reserve(network.getNeuronCount());
     
     for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
         Layer* layer = network.getLayer(iLayerIdx);
         if (!layer) continue;
         
         for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
-            if (iCurrentIndex == globalIndex) {
-                return layer->getNeuron(iNeuronIdx);
-            }
-            iCurrentIndex++;
+            neuronTable.push_back(layer->getNeuron(iNeuronIdx));
         }
     }
     
+    return neuronTable;
+}
+
+//-------------------------------------------------------------
+//【函数名称】lookupNeuron
+//【函数功能】根据全局索引查找神经元
+//【参数】neuronTable：神经元查找表，globalIndex：全局索引
+//【返回值】Neuron*，找到的神经元指针，未找到返回nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Neuron* ANNImporter::lookupNeuron(const vector<Neuron*>& neuronTable, int globalIndex) {
+    if (globalIndex >= 0 && globalIndex < static_cast<int>(neuronTable.size())) {
+        return neuronTable[globalIndex];
+    }
     return nullptr;
 }
+
+//-------------------------------------------------------------
+//【类名】ANNImporter::LazyLayerLoader
+//【功能】ANN文件的按层权重加载器
+//【说明】导入时扫描一遍S/D记录，按"拥有层"（目标神经元所在层；外部输出按源神经元所在层）
+//       记录连续的字节区间，并统计突触数量、神经元参与情况和是否严格前馈。
+//       加载某层时只定位并解析该层的区间。文件以二进制方式打开，偏移量与字节一一对应
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 索引时记录每个区间内容的FNV-1a散列，加载时先读入整个区间并核对散列，
+//           文件在索引后被改写（即使大小不变）时加载失败，而不是解析出另一组权重
+//-------------------------------------------------------------
+class ANNImporter::LazyLayerLoader : public LayerWeightLoader {
+private:
+    // [begin, end) of consecutive records and the hash of those bytes when indexed
+    struct ByteSpan {
+        streamoff begin;
+        streamoff end;
+        uint64_t hash;
+    };
+    
+    static const uint64_t HASH_BASIS = 14695981039346656037ULL; // FNV-1a offset basis
+    
+    ANNImporter m_parser;                  // Record parsing helpers
+    ifstream m_file;                       // Kept open for the lifetime of the network
+    vector<Neuron*> m_neuronTable;         // Global neuron index -> neuron
+    vector<Layer*> m_layers;               // Layer index -> layer
+    vector<int> m_layerStart;              // Global index of each layer's first neuron, plus total
+    vector<vector<ByteSpan>> m_spans;      // Record spans owned by each layer
+    vector<int64_t> m_synapseCounts;       // Synapses each layer owns once loaded
+    vector<vector<int>> m_targetLayers;    // Layers receiving connections from each layer
+    vector<bool> m_neuronConnected;        // Whether each neuron will have any synapse
+    bool m_bFeedForward;                   // All inter-neuron records point to a later layer
+    
+public:
+    //-------------------------------------------------------------
+    //【函数名称】LazyLayerLoader
+    //【函数功能】构造函数，以二进制方式打开文件
+    //【参数】filename：ANN文件路径
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit LazyLayerLoader(const string& filename)
+        : m_file(filename.c_str(), ios::in | ios::binary), m_bFeedForward(true) {
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】getStream
+    //【函数功能】获取底层文件流（用于解析拓扑）
+    //【参数】无
+    //【返回值】istream&，文件流，未打开时处于失败状态
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    istream& getStream() {
+        return m_file;
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】buildIndex
+    //【函数功能】扫描全部连接记录，建立按层字节区间索引和结构统计
+    //【参数】network：已建好层与神经元、尚无突触的网络，invalidAxons：收集非法轴突权重说明
+    //【返回值】bool，D记录非法或权重行不足时返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 同时散列各区间的字节；末行没有换行符时不计入换行
+    //-------------------------------------------------------------
+    bool buildIndex(Network& network, vector<string>& invalidAxons) {
+        int iLayerCount = network.getLayerCount();
+        m_neuronTable = m_parser.buildNeuronTable(network);
+        m_layerStart.assign(1, 0);
+        for (int iLayerIdx = 0; iLayerIdx < iLayerCount; ++iLayerIdx) {
+            m_layers.push_back(network.getLayer(iLayerIdx));
+            m_layerStart.push_back(m_layerStart.back() + m_layers.back()->getNeuronCount());
+        }
+        m_spans.assign(iLayerCount, vector<ByteSpan>());
+        m_synapseCounts.assign(iLayerCount, 0);
+        m_targetLayers.assign(iLayerCount, vector<int>());
+        m_neuronConnected.assign(m_neuronTable.size(), false);
+        
+        int iNeuronTotal = static_cast<int>(m_neuronTable.size());
+        string line;
+        streamoff iOffset = 0;
+        m_file.clear();
+        m_file.seekg(0, ios::beg);
+        
+        while (getline(m_file, line)) {
+            streamoff iLineStart = iOffset;
+            bool bNewline = !m_file.eof();
+            iOffset += static_cast<streamoff>(line.size()) + (bNewline ? 1 : 0);
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            
+            const char* pCursor = line.c_str();
+            while (isspace(static_cast<unsigned char>(*pCursor))) {
+                ++pCursor;
+            }
+            char cPrefix = *pCursor++;
+            char* pEnd = nullptr;
+            
+            if (cPrefix == 'D') {
+                long iFromLayer = strtol(pCursor, &pEnd, 10);
+                bool bParsed = pEnd != pCursor;
+                pCursor = pEnd;
+                long iToLayer = strtol(pCursor, &pEnd, 10);
+                bParsed = bParsed && pEnd != pCursor;
+                if (!bParsed || iFromLayer == iToLayer || iFromLayer < 0 || iToLayer < 0 ||
+                    iFromLayer >= iLayerCount || iToLayer >= iLayerCount) {
+                    return false;
+                }
+                
+                // Skip the weight rows; they are parsed when the target layer is loaded
+                appendToSpan(static_cast<int>(iToLayer), iLineStart, line, bNewline);
+                int iRowCount = m_layers[iFromLayer]->getNeuronCount();
+                int iRow = 0;
+                while (iRow < iRowCount && getline(m_file, line)) {
+                    streamoff iRowStart = iOffset;
+                    bNewline = !m_file.eof();
+                    iOffset += static_cast<streamoff>(line.size()) + (bNewline ? 1 : 0);
+                    appendToSpan(static_cast<int>(iToLayer), iRowStart, line, bNewline);
+                    size_t uFirst = line.find_first_not_of(" \t\r");
+                    if (uFirst != string::npos && line[uFirst] != '#') {
+                        ++iRow;
+                    }
+                }
+                if (iRow < iRowCount) {
+                    return false;
+                }
+                
+                int iColumnCount = m_layers[iToLayer]->getNeuronCount();
+                m_synapseCounts[iToLayer] += static_cast<int64_t>(iRowCount) * iColumnCount;
+                if (iRowCount > 0 && iColumnCount > 0) {
+                    markLayerConnected(static_cast<int>(iFromLayer));
+                    markLayerConnected(static_cast<int>(iToLayer));
+                    addConnection(static_cast<int>(iFromLayer), static_cast<int>(iToLayer));
+                }
+                continue;
+            }
+            
+            if (cPrefix != 'S') {
+                continue;
+            }
+            
+            long iFromNeuron = strtol(pCursor, &pEnd, 10);
+            if (pEnd == pCursor) {
+                continue;
+            }
+            pCursor = pEnd;
+            long iToNeuron = strtol(pCursor, &pEnd, 10);
+            if (pEnd == pCursor) {
+                continue;
+            }
+            pCursor = pEnd;
+            double rWeight = strtod(pCursor, &pEnd);
+            if (pEnd == pCursor) {
+                continue;
+            }
+            
+            // Same acceptance rules as applySynapseRecord
+            int iOwnerLayer = -1;
+            if (iFromNeuron == -1 && iToNeuron >= 0) {
+                if (iToNeuron < iNeuronTotal) {
+                    iOwnerLayer = layerOfNeuron(static_cast<int>(iToNeuron));
+                    m_neuronConnected[iToNeuron] = true;
+                }
+            }
+            else if (iToNeuron == -1 && iFromNeuron >= 0) {
+                if (rWeight != 1.0) {
+                    invalidAxons.push_back(m_parser.describeInvalidAxonWeight(static_cast<int>(iFromNeuron), rWeight));
+                }
+                if (iFromNeuron < iNeuronTotal) {
+                    iOwnerLayer = layerOfNeuron(static_cast<int>(iFromNeuron));
+                    m_neuronConnected[iFromNeuron] = true;
+                }
+            }
+            else if (iFromNeuron >= 0 && iToNeuron >= 0 && iFromNeuron < iNeuronTotal && iToNeuron < iNeuronTotal) {
+                iOwnerLayer = layerOfNeuron(static_cast<int>(iToNeuron));
+                m_neuronConnected[iFromNeuron] = true;
+                m_neuronConnected[iToNeuron] = true;
+                addConnection(layerOfNeuron(static_cast<int>(iFromNeuron)), iOwnerLayer);
+            }
+            
+            if (iOwnerLayer >= 0) {
+                m_synapseCounts[iOwnerLayer]++;
+                appendToSpan(iOwnerLayer, iLineStart, line, bNewline);
+            }
+        }
+        
+        return true;
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】loadLayerWeights
+    //【函数功能】重新定位到该层的各字节区间并生成突触
+    //【参数】network：目标网络（突触通过索引时保存的神经元指针生成），layerIndex：层索引
+    //【返回值】bool，加载成功返回true，文件不可读或内容已变化返回false
+    //【说明】每个区间先整体读入并与索引时的散列比较，不一致时不解析其中任何记录；
+    //       散列只覆盖该层的区间，其他层的内容变化在那些层加载时发现
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 以区间散列代替只检查文件是否变短
+    //-------------------------------------------------------------
+    bool loadLayerWeights(Network& network, int layerIndex) override {
+        (void)network;
+        if (layerIndex < 0 || layerIndex >= static_cast<int>(m_spans.size())) {
+            return false;
+        }
+        
+        vector<string> invalidAxons; // Already reported while indexing
+        string line;
+        for (const ByteSpan& span : m_spans[layerIndex]) {
+            string bytes(static_cast<size_t>(span.end - span.begin), '\0');
+            m_file.clear();
+            m_file.seekg(span.begin, ios::beg);
+            m_file.read(&bytes[0], static_cast<streamsize>(bytes.size()));
+            if (m_file.gcount() != static_cast<streamsize>(bytes.size()) ||
+                hashBytes(HASH_BASIS, bytes.data(), bytes.size()) != span.hash) {
+                return false; // File changed since it was indexed
+            }
+            
+            MemoryStreamBuffer buffer(bytes.data(), bytes.size());
+            istream records(&buffer);
+            while (getline(records, line)) {
+                istringstream iss(line);
+                char cPrefix = 0;
+                iss >> cPrefix;
+                
+                if (cPrefix == 'S') {
+                    int iFromNeuron;
+                    int iToNeuron;
+                    double rWeight;
+                    if (iss >> iFromNeuron >> iToNeuron >> rWeight) {
+                        m_parser.applySynapseRecord(iFromNeuron, iToNeuron, rWeight, m_neuronTable, invalidAxons);
+                    }
+                }
+                else if (cPrefix == 'D') {
+                    int iFromLayer;
+                    int iToLayer;
+                    if (!(iss >> iFromLayer >> iToLayer) ||
+                        !m_parser.parseDenseBlock(records, *m_layers[iFromLayer], *m_layers[iToLayer])) {
+                        return false;
+                    }
+                }
+            }
+        }
+        
+        return true;
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】getTargetLayers
+    //【函数功能】获取接收指定层连接的层
+    //【参数】layerIndex：层索引
+    //【返回值】vector<int>，目标层索引
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<int> getTargetLayers(int layerIndex) const override {
+        if (layerIndex < 0 || layerIndex >= static_cast<int>(m_targetLayers.size())) {
+            return vector<int>();
+        }
+        return m_targetLayers[layerIndex];
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】getLayerSynapseCount
+    //【函数功能】获取指定层加载后的突触数量
+    //【参数】layerIndex：层索引
+    //【返回值】int64_t，突触数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getLayerSynapseCount(int layerIndex) const override {
+        if (layerIndex < 0 || layerIndex >= static_cast<int>(m_synapseCounts.size())) {
+            return 0;
+        }
+        return m_synapseCounts[layerIndex];
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】isNeuronConnected
+    //【函数功能】判断神经元加载后是否有任何突触
+    //【参数】layerIndex：层索引，neuronIndex：层内神经元索引
+    //【返回值】bool，有连接返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isNeuronConnected(int layerIndex, int neuronIndex) const override {
+        if (layerIndex < 0 || layerIndex + 1 >= static_cast<int>(m_layerStart.size())) {
+            return false;
+        }
+        int iGlobalIndex = m_layerStart[layerIndex] + neuronIndex;
+        return neuronIndex >= 0 && iGlobalIndex < m_layerStart[layerIndex + 1] && m_neuronConnected[iGlobalIndex];
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】isFeedForward
+    //【函数功能】判断所有神经元间连接是否都指向更靠后的层
+    //【参数】无
+    //【返回值】bool，严格前馈返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isFeedForward() const override {
+        return m_bFeedForward;
+    }
+
+private:
+    //-------------------------------------------------------------
+    //【函数名称】layerOfNeuron
+    //【函数功能】根据全局索引求神经元所在层
+    //【参数】globalIndex：有效的全局神经元索引
+    //【返回值】int，层索引
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int layerOfNeuron(int globalIndex) const {
+        return static_cast<int>(upper_bound(m_layerStart.begin(), m_layerStart.end(), globalIndex)
+                                - m_layerStart.begin()) - 1;
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】appendToSpan
+    //【函数功能】把一行记录的字节加入所属层的区间并更新散列，与上一区间相邻时合并
+    //【参数】layerIndex：所属层，begin：该行起始偏移，line：行内容（不含换行符），
+    //       newline：该行在文件中是否以换行符结束
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 由addSpan改为逐行追加，同时维护区间散列
+    //-------------------------------------------------------------
+    void appendToSpan(int layerIndex, streamoff begin, const string& line, bool newline) {
+        vector<ByteSpan>& spans = m_spans[layerIndex];
+        if (spans.empty() || spans.back().end != begin) {
+            ByteSpan span = {begin, begin, HASH_BASIS};
+            spans.push_back(span);
+        }
+        ByteSpan& span = spans.back();
+        span.hash = hashBytes(span.hash, line.data(), line.size());
+        if (newline) {
+            span.hash = hashBytes(span.hash, "\n", 1);
+        }
+        span.end = begin + static_cast<streamoff>(line.size()) + (newline ? 1 : 0);
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】hashBytes
+    //【函数功能】以FNV-1a继续散列一段字节
+    //【参数】hash：当前散列值，data：字节首地址，size：字节数
+    //【返回值】uint64_t，新的散列值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static uint64_t hashBytes(uint64_t hash, const char* data, size_t size) {
+        for (size_t uIdx = 0; uIdx < size; ++uIdx) {
+            hash ^= static_cast<unsigned char>(data[uIdx]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】addConnection
+    //【函数功能】记录层间连接，更新目标层列表和前馈标志
+    //【参数】fromLayer：源层，toLayer：目标层
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void addConnection(int fromLayer, int toLayer) {
+        if (toLayer <= fromLayer) {
+            m_bFeedForward = false;
+        }
+        vector<int>& targets = m_targetLayers[fromLayer];
+        if (find(targets.begin(), targets.end(), toLayer) == targets.end()) {
+            targets.push_back(toLayer);
+        }
+    }
+    
+    //-------------------------------------------------------------
+    //【函数名称】markLayerConnected
+    //【函数功能】将一层的所有神经元标记为有连接
+    //【参数】layerIndex：层索引
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void markLayerConnected(int layerIndex) {
+        for (int iGlobal = m_layerStart[layerIndex]; iGlobal < m_layerStart[layerIndex + 1]; ++iGlobal) {
+            m_neuronConnected[iGlobal] = true;
+        }
+    }
+};
+
+//-------------------------------------------------------------
+//【函数名称】importNetworkLazily
+//【函数功能】延迟加载模式导入：解析拓扑并建立索引，权重在各层首次访问时加载
+//【参数】filename：ANN文件路径
+//【返回值】unique_ptr<Network>，导入的网络指针
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+unique_ptr<Network> ANNImporter::importNetworkLazily(const string& filename) {
+    unique_ptr<LazyLayerLoader> loader(new LazyLayerLoader(filename));
+    istream& file = loader->getStream();
+    if (!file) {
+        return nullptr;
+    }
+    
+    auto network = unique_ptr<Network>(new Network());
+    
+    try {
+        // Topology is read eagerly
+        m_contentStart = 0;
+        if (!parseNetworkHeader(file, *network) || !parseLayerInformation(file, *network)) {
+            return nullptr;
+        }
+        
+        // One scan over the connection records replaces materializing them
+        vector<string> invalidAxonConnections;
+        if (!loader->buildIndex(*network, invalidAxonConnections)) {
+            return nullptr;
+        }
+        recordInvalidAxonWeights(*network, invalidAxonConnections);
+        network->setWeightLoader(move(loader));
+        
+        // Validation answers from the index without loading any layer
+        if (!validateImportedNetwork(network.get())) {
+            return nullptr;
+        }
+        
+        return network;
+    }
+    catch (const exception&) {
+        return nullptr;
+    }
+}
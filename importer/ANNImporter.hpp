@@ -11,6 +11,7 @@
 #include "BaseImporter.hpp"
 #include "../model/activation_functions/ActivationFunction.hpp"
 #include <fstream>
+#include <istream>
 #include <vector>
 
 using namespace std;
@@ -20,69 +21,74 @@ using namespace std;
 //【功能】ANN文件格式导入器，解析神经网络结构
 //【说明】支持ANN文件的网络、层、神经元、突触解析
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 增加延迟加载模式：只解析拓扑并建立按层的字节区间索引，权重按需加载
 //-------------------------------------------------------------
 class ANNImporter : public BaseImporter {
 private:
+    streampos m_contentStart;  // 模型内容在输入流中的起始位置，各遍解析从此处重新开始
+    bool m_bLazyLoading;       // 从文件导入时是否延迟加载各层权重
+    
+    class LazyLayerLoader;     // 按层字节区间索引，按需生成突触（定义见ANNImporter.cpp）
+    
     //-------------------------------------------------------------
     //【函数名称】parseNetworkHeader
     //【函数功能】解析网络头部信息
-    //【参数】file：输入文件流，network：要填充的网络对象
+    //【参数】file：输入流，network：要填充的网络对象
     //【返回值】bool，成功解析返回true
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    bool parseNetworkHeader(ifstream& file, Network& network);
+    bool parseNetworkHeader(istream& file, Network& network);
     
     //-------------------------------------------------------------
     //【函数名称】parseLayerInformation
     //【函数功能】解析层信息
-    //【参数】file：输入文件流，network：要填充的网络对象
+    //【参数】file：输入流，network：要填充的网络对象
     //【返回值】bool，成功解析返回true
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    bool parseLayerInformation(ifstream& file, Network& network);
+    bool parseLayerInformation(istream& file, Network& network);
     
     //-------------------------------------------------------------
     //【函数名称】parseNeuronInformation
     //【函数功能】解析神经元信息
-    //【参数】file：输入文件流，layer：要填充的层对象，neuronCount：神经元数量
+    //【参数】file：输入流，layer：要填充的层对象，neuronCount：神经元数量
     //【返回值】bool，成功解析返回true
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    bool parseNeuronInformation(ifstream& file, Layer& layer, int neuronCount);
+    bool parseNeuronInformation(istream& file, Layer& layer, int neuronCount);
     
     //-------------------------------------------------------------
     //【函数名称】parseConnections
     //【函数功能】解析突触连接信息
-    //【参数】file：输入文件流，network：要更新连接的网络对象
+    //【参数】file：输入流，network：要更新连接的网络对象
     //【返回值】bool，成功解析返回true
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    bool parseConnections(ifstream& file, Network& network);
+    bool parseConnections(istream& file, Network& network);
     
     //-------------------------------------------------------------
     //【函数名称】skipWhitespaceAndComments
     //【函数功能】跳过文件中的空白符和注释
-    //【参数】file：输入文件流
+    //【参数】file：输入流
     //【返回值】无
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    void skipWhitespaceAndComments(ifstream& file);
+    void skipWhitespaceAndComments(istream& file);
     
     //-------------------------------------------------------------
     //【函数名称】readToken
     //【函数功能】从文件中读取下一个标记
-    //【参数】file：输入文件流
+    //【参数】file：输入流
     //【返回值】string，读取的标记字符串
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
-    string readToken(ifstream& file);
+    string readToken(istream& file);
     
     //-------------------------------------------------------------
     //【函数名称】parseActivationFunction
@@ -105,14 +111,76 @@ private:
     unique_ptr<Neuron> createNeuronWithActivation(double bias, int activationType);
     
     //-------------------------------------------------------------
-    //【函数名称】findNeuronByGlobalIndex
+    //【函数名称】parseDenseBlock
+    //【函数功能】解析稠密块（D记录）后的行主序权重矩阵
+    //【参数】file：输入流，sourceLayer：源层，targetLayer：目标层
+    //【返回值】bool，成功解析返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool parseDenseBlock(istream& file, Layer& sourceLayer, Layer& targetLayer);
+    
+    //-------------------------------------------------------------
+    //【函数名称】applySynapseRecord
+    //【函数功能】按一条S记录创建突触
+    //【参数】fromNeuron：源神经元全局索引（-1为外部输入），toNeuron：目标神经元全局索引（-1为外部输出），
+    //       weight：权重，neuronTable：神经元查找表，invalidAxons：收集非法轴突权重的说明
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void applySynapseRecord(int fromNeuron, int toNeuron, double weight,
+                            const vector<Neuron*>& neuronTable, vector<string>& invalidAxons);
+    
+    //-------------------------------------------------------------
+    //【函数名称】describeInvalidAxonWeight
+    //【函数功能】生成非法轴突权重的说明文字
+    //【参数】fromNeuron：源神经元全局索引，weight：文件中的权重
+    //【返回值】string，说明文字
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string describeInvalidAxonWeight(int fromNeuron, double weight);
+    
+    //-------------------------------------------------------------
+    //【函数名称】recordInvalidAxonWeights
+    //【函数功能】将非法轴突权重汇总为网络的导入错误
+    //【参数】network：网络对象，invalidAxons：非法轴突权重说明
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void recordInvalidAxonWeights(Network& network, const vector<string>& invalidAxons);
+    
+    //-------------------------------------------------------------
+    //【函数名称】importNetworkLazily
+    //【函数功能】延迟加载模式导入：解析拓扑、建立索引，权重留待按需加载
+    //【参数】filename：ANN文件路径，加载器在网络生命周期内保持该文件打开
+    //【返回值】unique_ptr<Network>，导入的网络对象指针
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    unique_ptr<Network> importNetworkLazily(const string& filename);
+    
+    //-------------------------------------------------------------
+    //【函数名称】buildNeuronTable
+    //【函数功能】按全局索引顺序建立神经元查找表
+    //【参数】network：网络引用
+    //【返回值】vector<Neuron*>，下标即全局索引
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<Neuron*> buildNeuronTable(Network& network);
+    
+    //-------------------------------------------------------------
+    //【函数名称】lookupNeuron
     //【函数功能】根据全局索引查找神经元
-    //【参数】network：网络引用，globalIndex：全局索引
+    //【参数】neuronTable：神经元查找表，globalIndex：全局索引
     //【返回值】Neuron*，找到的神经元指针，未找到返回nullptr
-    //【开发者及日期】林钲凯 2025-07-27
+    //【开发者及日期】林钲凯 2026-10-18
     //【更改记录】
     //-------------------------------------------------------------
-    Neuron* findNeuronByGlobalIndex(Network& network, int globalIndex);
+    Neuron* lookupNeuron(const vector<Neuron*>& neuronTable, int globalIndex);
 
 public:
     //-------------------------------------------------------------
@@ -163,8 +231,30 @@ public:
     //【开发者及日期】林钲凯 2025-07-27
     //【更改记录】
     //-------------------------------------------------------------
+    using BaseImporter::importNetwork;
+    
     unique_ptr<Network> importNetwork(const string& filename) override;
     
+    //-------------------------------------------------------------
+    //【函数名称】importNetwork
+    //【函数功能】从输入流导入ANN格式神经网络
+    //【参数】stream：输入流，不可定位的流（如管道）先读入内存再解析
+    //【返回值】unique_ptr<Network>，导入的网络对象指针
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    unique_ptr<Network> importNetwork(istream& stream) override;
+    
+    //-------------------------------------------------------------
+    //【函数名称】isContentSupported
+    //【函数功能】检查流内容的首条记录是否为ANN记录（G/N/L/S/D）
+    //【参数】stream：输入流，检查后读取位置恢复
+    //【返回值】bool，内容为ANN格式返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isContentSupported(istream& stream) const override;
+    
     //-------------------------------------------------------------
     //【函数名称】getSupportedExtensions
     //【函数功能】获取支持的文件扩展名
@@ -184,6 +274,26 @@ public:
     //【更改记录】
     //-------------------------------------------------------------
     string getImporterName() const override;
+    
+    //-------------------------------------------------------------
+    //【函数名称】setLazyLoading
+    //【函数功能】设置从文件导入时是否延迟加载各层权重
+    //【参数】enabled：true时只读取拓扑，各层突触在首次访问该层时生成；流和内存导入不受影响
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setLazyLoading(bool enabled);
+    
+    //-------------------------------------------------------------
+    //【函数名称】isLazyLoading
+    //【函数功能】查询是否延迟加载
+    //【参数】无
+    //【返回值】bool，是否延迟加载
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isLazyLoading() const;
 };
 
 #endif // AnnImporter_hpp
@@ -0,0 +1,330 @@
+//-------------------------------------------------------------
+//【文件名】ANNPatchApplier.cpp
+//【功能模块和目的】网络差异补丁（.annp）应用器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ANNPatchApplier.hpp"
+#include "../model/activation_functions/ActivationFunction.hpp"
+#include "../utils/MemoryStreamBuffer.hpp"
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】ANNPatchApplier
+//【函数功能】构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ANNPatchApplier::ANNPatchApplier() : m_iLastAppliedCount(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~ANNPatchApplier
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ANNPatchApplier::~ANNPatchApplier() = default;
+
+//-------------------------------------------------------------
+//【函数名称】applyPatch
+//【函数功能】从输入流读取补丁并原地应用
+//【参数】network：目标网络，stream：输入流
+//【返回值】bool，是否应用成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 核对参数指纹，只改权重的补丁不能重复应用
+//-------------------------------------------------------------
+bool ANNPatchApplier::applyPatch(Network& network, istream& stream) {
+    uint64_t uFingerprint = 0;
+    uint64_t uParameterFingerprint = 0;
+    vector<int> widths;
+    vector<PatchRecord> records;
+    if (!parsePatch(stream, uFingerprint, uParameterFingerprint, widths, records)) {
+        return false;
+    }
+    
+    // The patch only makes sense against the exact base it was diffed from
+    if (static_cast<int>(widths.size()) != network.getLayerCount()) {
+        return false;
+    }
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        if (network.getLayerNeuronCount(iLayerIdx) != widths[iLayerIdx]) {
+            return false;
+        }
+    }
+    if (network.getTopologyFingerprint() != uFingerprint ||
+        network.getParameterFingerprint() != uParameterFingerprint) {
+        return false;
+    }
+    
+    vector<Neuron*> neuronTable;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        Layer* pLayer = network.getLayer(iLayerIdx);
+        for (int iNeuronIdx = 0; iNeuronIdx < pLayer->getNeuronCount(); ++iNeuronIdx) {
+            neuronTable.push_back(pLayer->getNeuron(iNeuronIdx));
+        }
+    }
+    
+    if (!validateRecords(neuronTable, records)) {
+        return false;
+    }
+    
+    for (const PatchRecord& record : records) {
+        applyRecord(neuronTable, record);
+    }
+    network.invalidateValidationCache();
+    m_iLastAppliedCount = static_cast<int>(records.size());
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyPatch
+//【函数功能】从文件读取补丁并原地应用
+//【参数】network：目标网络，filename：补丁文件路径
+//【返回值】bool，是否应用成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNPatchApplier::applyPatch(Network& network, const string& filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    return applyPatch(network, file);
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyPatch
+//【函数功能】从内存缓冲区读取补丁并原地应用
+//【参数】network：目标网络，data：补丁内容首地址，size：字节数
+//【返回值】bool，是否应用成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNPatchApplier::applyPatch(Network& network, const char* data, size_t size) {
+    if (!data) {
+        return false;
+    }
+    
+    MemoryStreamBuffer buffer(data, size);
+    istream stream(&buffer);
+    return applyPatch(network, stream);
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLastAppliedCount
+//【函数功能】获取上次成功应用的变更记录数
+//【参数】无
+//【返回值】int，记录数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int ANNPatchApplier::getLastAppliedCount() const {
+    return m_iLastAppliedCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】parsePatch
+//【函数功能】解析补丁文本
+//【参数】stream：输入流，fingerprint/parameterFingerprint/widths：文件头，records：记录列表
+//【返回值】bool，格式是否正确
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 读取H记录中的参数指纹
+//-------------------------------------------------------------
+bool ANNPatchApplier::parsePatch(istream& stream, uint64_t& fingerprint, uint64_t& parameterFingerprint,
+                                 vector<int>& widths, vector<PatchRecord>& records) {
+    bool bHasHeader = false;
+    bool bHasParameters = false;
+    string line;
+    while (getline(stream, line)) {
+        istringstream iss(line);
+        string type;
+        if (!(iss >> type) || type[0] == '#') {
+            continue; // Blank line or comment
+        }
+        
+        if (type == "P") {
+            int iWidth = 0;
+            if (bHasHeader || !(iss >> hex >> fingerprint >> dec)) {
+                return false;
+            }
+            while (iss >> iWidth) {
+                widths.push_back(iWidth);
+            }
+            bHasHeader = !widths.empty();
+            if (!bHasHeader) {
+                return false;
+            }
+            continue;
+        }
+        if (type == "H") {
+            if (!bHasHeader || bHasParameters || !(iss >> hex >> parameterFingerprint >> dec)) {
+                return false;
+            }
+            bHasParameters = true;
+            continue;
+        }
+        
+        // Every change record follows the header
+        PatchRecord record = {type[0], 0, 0, 0.0, ""};
+        bool bParsed = bHasParameters && type.size() == 1;
+        switch (record.cType) {
+            case 'X':
+                bParsed = bParsed && static_cast<bool>(iss >> record.iNeuron >> record.iIndex);
+                break;
+            case 'W':
+                bParsed = bParsed && static_cast<bool>(iss >> record.iNeuron >> record.iIndex >> record.rValue);
+                break;
+            case 'E':
+                // E from to weight: the changed neuron is the target
+                bParsed = bParsed && static_cast<bool>(iss >> record.iIndex >> record.iNeuron >> record.rValue);
+                break;
+            case 'B':
+                bParsed = bParsed && static_cast<bool>(iss >> record.iNeuron >> record.rValue);
+                break;
+            case 'A':
+                bParsed = bParsed && static_cast<bool>(iss >> record.iNeuron >> record.name);
+                break;
+            case 'O':
+                bParsed = bParsed && static_cast<bool>(iss >> record.iNeuron >> record.iIndex);
+                break;
+            default:
+                bParsed = false;
+                break;
+        }
+        if (!bParsed) {
+            return false;
+        }
+        records.push_back(record);
+    }
+    
+    return bHasParameters;
+}
+
+//-------------------------------------------------------------
+//【函数名称】validateRecords
+//【函数功能】检查所有记录在按顺序应用时都有效
+//【参数】neuronTable：全局索引查找表，records：记录列表
+//【返回值】bool，是否全部有效
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool ANNPatchApplier::validateRecords(const vector<Neuron*>& neuronTable, const vector<PatchRecord>& records) const {
+    int iNeuronCount = static_cast<int>(neuronTable.size());
+    vector<int> dendriteCounts;
+    for (const Neuron* pNeuron : neuronTable) {
+        dendriteCounts.push_back(pNeuron->getInputSynapseCount());
+    }
+    
+    for (const PatchRecord& record : records) {
+        if (record.iNeuron < 0 || record.iNeuron >= iNeuronCount) {
+            return false;
+        }
+        int& iDendrites = dendriteCounts[record.iNeuron];
+        switch (record.cType) {
+            case 'X':
+                if (record.iIndex < 0 || record.iIndex >= iDendrites) {
+                    return false;
+                }
+                --iDendrites;
+                break;
+            case 'W':
+                if (record.iIndex < 0 || record.iIndex >= iDendrites) {
+                    return false;
+                }
+                break;
+            case 'E':
+                if (record.iIndex < -1 || record.iIndex >= iNeuronCount) {
+                    return false;
+                }
+                ++iDendrites;
+                break;
+            case 'A':
+                if (!createActivationFunction(record.name)) {
+                    return false;
+                }
+                break;
+            case 'O':
+                if (record.iIndex < 0) {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyRecord
+//【函数功能】应用一条已校验的记录
+//【参数】neuronTable：全局索引查找表，record：记录
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ANNPatchApplier::applyRecord(const vector<Neuron*>& neuronTable, const PatchRecord& record) {
+    Neuron* pNeuron = neuronTable[record.iNeuron];
+    switch (record.cType) {
+        case 'X': {
+            // Drop the matching axon on the source side as well
+            Neuron* pSource = pNeuron->getInputSynapse(record.iIndex)->getSourceNeuron();
+            pNeuron->removeInputSynapse(record.iIndex);
+            if (pSource) {
+                for (int iSynapseIdx = 0; iSynapseIdx < pSource->getOutputSynapseCount(); ++iSynapseIdx) {
+                    if (pSource->getOutputSynapse(iSynapseIdx)->getTargetNeuron() == pNeuron) {
+                        pSource->removeOutputSynapse(iSynapseIdx);
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        case 'W':
+            pNeuron->setInputSynapseWeight(record.iIndex, record.rValue);
+            break;
+        case 'E':
+            if (record.iIndex == -1) {
+                unique_ptr<Synapse> synapse(new Synapse(record.rValue, nullptr, pNeuron, false));
+                pNeuron->addInputSynapse(move(synapse));
+            } else {
+                neuronTable[record.iIndex]->connectTo(*pNeuron, record.rValue);
+            }
+            break;
+        case 'B':
+            pNeuron->setBias(record.rValue);
+            break;
+        case 'A':
+            pNeuron->setActivationFunction(createActivationFunction(record.name));
+            break;
+        case 'O': {
+            int iExternal = 0;
+            for (int iSynapseIdx = pNeuron->getOutputSynapseCount() - 1; iSynapseIdx >= 0; --iSynapseIdx) {
+                if (pNeuron->getOutputSynapse(iSynapseIdx)->getTargetNeuron() != nullptr) {
+                    continue;
+                }
+                if (iExternal < record.iIndex) {
+                    ++iExternal;
+                } else {
+                    pNeuron->removeOutputSynapse(iSynapseIdx);
+                }
+            }
+            for (; iExternal < record.iIndex; ++iExternal) {
+                unique_ptr<Synapse> synapse(new Synapse(1.0, pNeuron, nullptr, true));
+                pNeuron->addOutputSynapse(move(synapse));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
@@ -0,0 +1,161 @@
+//-------------------------------------------------------------
+//【文件名】ANNPatchApplier.hpp
+//【功能模块和目的】网络差异补丁（.annp）应用器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef AnnPatchApplier_hpp
+#define AnnPatchApplier_hpp
+
+#include "../model/neural_components/Network.hpp"
+#include <string>
+#include <istream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ANNPatchApplier
+//【功能】将ANNPatchExporter生成的补丁直接应用到已加载的网络，无需重新导入
+//【说明】先完整解析并校验补丁（层宽度、拓扑指纹、参数指纹、所有索引），全部通过后才修改网络，
+//       因此失败时网络保持不变。参数指纹使只修改权重或偏置的补丁也不能重复应用。
+//       记录格式见ANNPatchExporter
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 核对基准网络的参数指纹
+//-------------------------------------------------------------
+class ANNPatchApplier {
+private:
+    //-------------------------------------------------------------
+    //【类名】PatchRecord
+    //【功能】一条已解析的变更记录
+    //【说明】iIndex对X/W为树突索引，对E为来源神经元，对O为外部输出数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    struct PatchRecord {
+        char cType;        // X, W, E, B, A or O
+        int iNeuron;       // Global index of the neuron being changed
+        int iIndex;        // Dendrite index, source neuron or output count
+        double rValue;     // Weight or bias
+        string name;       // Activation function name
+    };
+    
+    int m_iLastAppliedCount;  // Records applied by the last successful call
+    
+    //-------------------------------------------------------------
+    //【函数名称】parsePatch
+    //【函数功能】解析补丁文本为记录列表，并读取文件头
+    //【参数】stream：输入流，fingerprint/parameterFingerprint/widths：输出文件头，records：输出记录
+    //【返回值】bool，格式正确且P、H文件头各出现一次时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 读取参数指纹
+    //-------------------------------------------------------------
+    bool parsePatch(istream& stream, uint64_t& fingerprint, uint64_t& parameterFingerprint, vector<int>& widths,
+                    vector<PatchRecord>& records);
+    
+    //-------------------------------------------------------------
+    //【函数名称】validateRecords
+    //【函数功能】按顺序模拟各神经元的树突数量，检查所有索引在应用时都有效
+    //【参数】neuronTable：全局索引查找表，records：记录列表
+    //【返回值】bool，全部有效返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool validateRecords(const vector<Neuron*>& neuronTable, const vector<PatchRecord>& records) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】applyRecord
+    //【函数功能】应用一条已校验的记录
+    //【参数】neuronTable：全局索引查找表，record：记录
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void applyRecord(const vector<Neuron*>& neuronTable, const PatchRecord& record);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】ANNPatchApplier
+    //【函数功能】构造函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNPatchApplier();
+    
+    //-------------------------------------------------------------
+    //【函数名称】ANNPatchApplier（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的补丁应用器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNPatchApplier(const ANNPatchApplier& other) = default;
+    
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源补丁应用器
+    //【返回值】ANNPatchApplier&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ANNPatchApplier& operator=(const ANNPatchApplier& other) = default;
+    
+    //-------------------------------------------------------------
+    //【函数名称】~ANNPatchApplier
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~ANNPatchApplier();
+    
+    //-------------------------------------------------------------
+    //【函数名称】applyPatch
+    //【函数功能】从输入流读取补丁并原地应用到网络
+    //【参数】network：目标网络（须为补丁的基准网络），stream：输入流
+    //【返回值】bool，应用成功返回true；格式错误、基准不符或索引越界时返回false且网络不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool applyPatch(Network& network, istream& stream);
+    
+    //-------------------------------------------------------------
+    //【函数名称】applyPatch
+    //【函数功能】从文件读取补丁并原地应用到网络
+    //【参数】network：目标网络，filename：补丁文件路径
+    //【返回值】bool，应用成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool applyPatch(Network& network, const string& filename);
+    
+    //-------------------------------------------------------------
+    //【函数名称】applyPatch
+    //【函数功能】从内存缓冲区读取补丁并原地应用到网络（不复制缓冲区）
+    //【参数】network：目标网络，data：补丁内容首地址，size：字节数
+    //【返回值】bool，应用成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool applyPatch(Network& network, const char* data, size_t size);
+    
+    //-------------------------------------------------------------
+    //【函数名称】getLastAppliedCount
+    //【函数功能】获取上次成功应用的变更记录数
+    //【参数】无
+    //【返回值】int，记录数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getLastAppliedCount() const;
+};
+
+#endif // AnnPatchApplier_hpp
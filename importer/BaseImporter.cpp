@@ -7,6 +7,7 @@
 
 #include "BaseImporter.hpp"
 #include "../utils/FileUtils.hpp"
+#include "../utils/MemoryStreamBuffer.hpp"
 #include <algorithm>
 
 using namespace std;
@@ -30,6 +31,24 @@ bool BaseImporter::isFormatSupported(const string& filename) const {
     return supportedExts.find(extension) != string::npos;
 }
 
+//-------------------------------------------------------------
+//【函数名称】importNetwork
+//【函数功能】从调用者内存区域导入网络，流直接读取该内存，不做复制
+//【参数】data：内容首地址，size：字节数
+//【返回值】unique_ptr<Network>，导入的网络指针，失败返回nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+unique_ptr<Network> BaseImporter::importNetwork(const char* data, size_t size) {
+    if (!data) {
+        return nullptr;
+    }
+    
+    MemoryStreamBuffer buffer(data, size);
+    istream stream(&buffer);
+    return importNetwork(stream);
+}
+
 //-------------------------------------------------------------
 //【函数名称】getFileExtension
 //【函数功能】获取文件扩展名
@@ -48,7 +67,7 @@ string BaseImporter::getFileExtension(const string& filename) const {
 //【参数】network：网络指针
 //【返回值】bool，是否合法
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 只读取神经元数量，不触发延迟加载
 //-------------------------------------------------------------
 bool BaseImporter::validateImportedNetwork(const Network* network) const {
     if (!network) {
@@ -61,9 +80,9 @@ bool BaseImporter::validateImportedNetwork(const Network* network) const {
     }
     
     // Check that each layer has at least one neuron
+    // Neuron counts only, so that lazily loaded networks stay unloaded
     for (int iLayerIdx = 0; iLayerIdx < network->getLayerCount(); ++iLayerIdx) {
-        const Layer* layer = network->getLayer(iLayerIdx);
-        if (!layer || layer->getNeuronCount() == 0) {
+        if (network->getLayerNeuronCount(iLayerIdx) <= 0) {
             return false;
         }
     }
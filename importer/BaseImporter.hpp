@@ -11,6 +11,8 @@
 #include "../model/neural_components/Network.hpp"
 #include <memory>
 #include <string>
+#include <istream>
+#include <cstddef>
 
 using namespace std;
 
@@ -75,6 +77,31 @@ public:
     //-------------------------------------------------------------
     virtual unique_ptr<Network> importNetwork(const string& filename) = 0;
     
+    //-------------------------------------------------------------
+    //【函数名称】importNetwork
+    //【函数功能】从输入流导入神经网络（管道、套接字、内存等）
+    //【参数】
+    //  - istream& stream：模型内容所在的输入流
+    //【返回值】
+    //  - unique_ptr<Network>：导入的网络的唯一指针，导入失败时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual unique_ptr<Network> importNetwork(istream& stream) = 0;
+    
+    //-------------------------------------------------------------
+    //【函数名称】importNetwork
+    //【函数功能】直接从调用者内存区域导入神经网络（零拷贝）
+    //【参数】
+    //  - const char* data：模型内容首地址，导入期间须保持有效
+    //  - size_t size：内容字节数
+    //【返回值】
+    //  - unique_ptr<Network>：导入的网络的唯一指针，导入失败时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    unique_ptr<Network> importNetwork(const char* data, size_t size);
+    
     //-------------------------------------------------------------
     //【函数名称】getSupportedExtensions
     //【函数功能】获取支持的文件扩展名
@@ -106,6 +133,18 @@ public:
     //【更改记录】
     //-------------------------------------------------------------
     virtual bool isFormatSupported(const string& filename) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】isContentSupported
+    //【函数功能】根据流内容（而非扩展名）判断格式是否受支持
+    //【参数】
+    //  - istream& stream：要检查的输入流，检查后读取位置恢复
+    //【返回值】
+    //  - bool：内容格式是否受支持
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool isContentSupported(istream& stream) const = 0;
 
 protected:
     //-------------------------------------------------------------
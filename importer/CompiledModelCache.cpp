@@ -0,0 +1,232 @@
+//-------------------------------------------------------------
+//【文件名】CompiledModelCache.cpp
+//【功能模块和目的】按文件内容寻址的编译模型缓存实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "CompiledModelCache.hpp"
+#include "ANNImporter.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+static const char CACHE_MAGIC[4] = {'A', 'N', 'N', 'C'};
+
+// Distinguishes temporary files written concurrently by this process
+static atomic<uint64_t> s_uTempCounter(0);
+
+//-------------------------------------------------------------
+//【函数名称】CompiledModelCache
+//【函数功能】构造函数
+//【参数】cacheDirectory：缓存目录
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledModelCache::CompiledModelCache(const string& cacheDirectory)
+    : m_cacheDirectory(cacheDirectory), m_iHitCount(0), m_iMissCount(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~CompiledModelCache
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledModelCache::~CompiledModelCache() = default;
+
+//-------------------------------------------------------------
+//【函数名称】load
+//【函数功能】加载ANN文件的编译模型
+//【参数】sourcePath：ANN文件路径
+//【返回值】shared_ptr<const CompiledNetwork>，失败为空
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+shared_ptr<const CompiledNetwork> CompiledModelCache::load(const string& sourcePath) {
+    // Hashing the raw bytes is far cheaper than tokenizing and validating them
+    ifstream source(sourcePath, ios::in | ios::binary);
+    if (!source.is_open()) {
+        return nullptr;
+    }
+    string content((istreambuf_iterator<char>(source)), istreambuf_iterator<char>());
+    source.close();
+    uint64_t uHash = hashContent(content.data(), content.size());
+    uint64_t uSize = static_cast<uint64_t>(content.size());
+    string cachePath = getCachePath(sourcePath, uHash);
+
+    shared_ptr<CompiledNetwork> model(new CompiledNetwork());
+    if (readCacheFile(cachePath, uHash, uSize, *model)) {
+        ++m_iHitCount;
+        return model;
+    }
+
+    ++m_iMissCount;
+    try {
+        ANNImporter importer;
+        unique_ptr<Network> network = importer.importNetwork(content.data(), content.size());
+        if (!network || !model->compile(*network)) {
+            return nullptr;
+        }
+    }
+    catch (const exception&) {
+        return nullptr;
+    }
+    // A read-only cache location only costs the next load a re-parse
+    writeCacheFile(cachePath, uHash, uSize, *model);
+    return model;
+}
+
+//-------------------------------------------------------------
+//【函数名称】readCacheFile
+//【函数功能】读取并校验缓存文件
+//【参数】cachePath：缓存文件路径，hash/size：源文件内容哈希和字节数，model：输出模型
+//【返回值】bool，是否命中
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledModelCache::readCacheFile(const string& cachePath, uint64_t hash, uint64_t size,
+                                       CompiledNetwork& model) {
+    ifstream file(cachePath, ios::in | ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4] = {0, 0, 0, 0};
+    uint32_t uVersion = 0;
+    uint64_t uHash = 0;
+    uint64_t uSize = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&uVersion), sizeof(uVersion));
+    file.read(reinterpret_cast<char*>(&uHash), sizeof(uHash));
+    file.read(reinterpret_cast<char*>(&uSize), sizeof(uSize));
+    if (!file || memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 || uVersion != VERSION ||
+        uHash != hash || uSize != size) {
+        return false;
+    }
+    return model.readFrom(file);
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeCacheFile
+//【函数功能】写出缓存文件
+//【参数】cachePath：缓存文件路径，hash/size：源文件内容哈希和字节数，model：编译模型
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledModelCache::writeCacheFile(const string& cachePath, uint64_t hash, uint64_t size,
+                                        const CompiledNetwork& model) {
+    string tempPath = cachePath + ".tmp" + to_string(++s_uTempCounter);
+    {
+        ofstream file(tempPath, ios::out | ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        uint32_t uVersion = VERSION;
+        file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        file.write(reinterpret_cast<const char*>(&uVersion), sizeof(uVersion));
+        file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        bool bWritten = model.writeTo(file);
+        file.close();
+        if (!bWritten || file.fail()) {
+            remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    // rename() replaces the target atomically on POSIX; Windows needs the old file gone first
+    if (rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        remove(cachePath.c_str());
+        if (rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+            remove(tempPath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getCachePath
+//【函数功能】计算缓存文件路径
+//【参数】sourcePath：源文件路径，hash：内容哈希
+//【返回值】string，缓存文件路径
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string CompiledModelCache::getCachePath(const string& sourcePath, uint64_t hash) const {
+    if (m_cacheDirectory.empty()) {
+        return sourcePath + ".annc";
+    }
+
+    ostringstream path;
+    path << m_cacheDirectory;
+    char cLast = m_cacheDirectory[m_cacheDirectory.size() - 1];
+    if (cLast != '/' && cLast != '\\') {
+        path << '/';
+    }
+    path << hex << setw(16) << setfill('0') << hash << ".annc";
+    return path.str();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getCacheDirectory
+//【函数功能】获取缓存目录
+//【参数】无
+//【返回值】const string&，缓存目录
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const string& CompiledModelCache::getCacheDirectory() const {
+    return m_cacheDirectory;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getHitCount
+//【函数功能】获取从缓存文件加载的次数
+//【参数】无
+//【返回值】int64_t，次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledModelCache::getHitCount() const {
+    return m_iHitCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getMissCount
+//【函数功能】获取需要解析源文件的次数
+//【参数】无
+//【返回值】int64_t，次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledModelCache::getMissCount() const {
+    return m_iMissCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】hashContent
+//【函数功能】计算内容的64位FNV-1a哈希
+//【参数】data：内容首地址，size：字节数
+//【返回值】uint64_t，哈希值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+uint64_t CompiledModelCache::hashContent(const char* data, size_t size) {
+    uint64_t uHash = 14695981039346656037ULL;
+    for (size_t uIdx = 0; uIdx < size; ++uIdx) {
+        uHash ^= static_cast<unsigned char>(data[uIdx]);
+        uHash *= 1099511628211ULL;
+    }
+    return uHash;
+}
@@ -0,0 +1,164 @@
+//-------------------------------------------------------------
+//【文件名】CompiledModelCache.hpp
+//【功能模块和目的】按文件内容寻址的编译模型缓存声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef CompiledModelCache_hpp
+#define CompiledModelCache_hpp
+
+#include "../model/inference_engine/CompiledNetwork.hpp"
+#include <memory>
+#include <string>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】CompiledModelCache
+//【功能】导入ANN文件时按内容哈希查找已编译的二进制模型，命中时跳过文本解析、验证和编译
+//【说明】缓存文件（.annc）布局：魔数"ANNC"、uint32版本号、uint64源文件内容哈希（FNV-1a）、
+//       uint64源文件字节数，随后是CompiledNetwork::writeTo写出的.annb映像。
+//       未设置缓存目录时缓存文件与源文件并列（"<源文件>.annc"）；设置后存放在目录中，
+//       以内容哈希命名（"<16位十六进制哈希>.annc"），内容相同的文件共享同一缓存。
+//       源文件内容变化后哈希不再匹配，缓存在下次加载时重建；缓存先写入临时文件再改名替换，
+//       其他进程不会读到写了一半的缓存。load可在多个线程中同时调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class CompiledModelCache {
+public:
+    static const uint32_t VERSION = 1;  // 当前缓存格式版本
+
+private:
+    string m_cacheDirectory;      // Empty: sidecar next to the source file
+    atomic<int64_t> m_iHitCount;  // Loads served from a cache file
+    atomic<int64_t> m_iMissCount; // Loads that had to parse the source
+
+    //-------------------------------------------------------------
+    //【函数名称】readCacheFile
+    //【函数功能】读取缓存文件，校验文件头记录的哈希和长度
+    //【参数】cachePath：缓存文件路径，hash/size：源文件内容哈希和字节数，model：输出模型
+    //【返回值】bool，缓存有效且读取成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool readCacheFile(const string& cachePath, uint64_t hash, uint64_t size, CompiledNetwork& model);
+
+    //-------------------------------------------------------------
+    //【函数名称】writeCacheFile
+    //【函数功能】写出缓存文件（先写临时文件再改名替换）
+    //【参数】cachePath：缓存文件路径，hash/size：源文件内容哈希和字节数，model：编译模型
+    //【返回值】bool，写入成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool writeCacheFile(const string& cachePath, uint64_t hash, uint64_t size, const CompiledNetwork& model);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】CompiledModelCache
+    //【函数功能】构造函数
+    //【参数】cacheDirectory：缓存目录，为空时使用源文件旁的缓存文件
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit CompiledModelCache(const string& cacheDirectory = "");
+
+    //-------------------------------------------------------------
+    //【函数名称】CompiledModelCache（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用）
+    //【参数】other：被拷贝的缓存
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledModelCache(const CompiledModelCache& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源缓存
+    //【返回值】CompiledModelCache&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledModelCache& operator=(const CompiledModelCache& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~CompiledModelCache
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~CompiledModelCache();
+
+    //-------------------------------------------------------------
+    //【函数名称】load
+    //【函数功能】加载ANN文件的编译模型：缓存有效时直接读取，否则解析、编译并重建缓存
+    //【参数】sourcePath：ANN文件路径
+    //【返回值】shared_ptr<const CompiledNetwork>，源文件无法读取、解析或编译时为空
+    //           （缓存写入失败不影响返回结果）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    shared_ptr<const CompiledNetwork> load(const string& sourcePath);
+
+    //-------------------------------------------------------------
+    //【函数名称】getCachePath
+    //【函数功能】计算给定源文件和内容哈希对应的缓存文件路径
+    //【参数】sourcePath：源文件路径，hash：内容哈希
+    //【返回值】string，缓存文件路径
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string getCachePath(const string& sourcePath, uint64_t hash) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getCacheDirectory
+    //【函数功能】获取缓存目录
+    //【参数】无
+    //【返回值】const string&，缓存目录，空字符串表示使用源文件旁的缓存文件
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const string& getCacheDirectory() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getHitCount
+    //【函数功能】获取从缓存文件加载的次数
+    //【参数】无
+    //【返回值】int64_t，次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getHitCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getMissCount
+    //【函数功能】获取需要解析源文件的次数
+    //【参数】无
+    //【返回值】int64_t，次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getMissCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】hashContent
+    //【函数功能】计算内容的64位FNV-1a哈希
+    //【参数】data：内容首地址，size：字节数
+    //【返回值】uint64_t，哈希值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static uint64_t hashContent(const char* data, size_t size);
+};
+
+#endif // CompiledModelCache_hpp
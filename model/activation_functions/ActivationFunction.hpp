@@ -18,7 +18,7 @@ using namespace std;
 //【功能】激活函数抽象基类，定义接口
 //【说明】支持多种非线性变换
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 增加derivative，供训练器反向传播
 //-------------------------------------------------------------
 class ActivationFunction {
 public:
@@ -72,6 +72,17 @@ public:
     //-------------------------------------------------------------
     virtual double activate(double x) const = 0;
     
+    //-------------------------------------------------------------
+    //【函数名称】derivative
+    //【函数功能】由激活值计算导数（反向传播只保存各层输出，训练器经CompiledLayer::applyDerivative
+    //           调用此函数，因此每个激活函数的导数只在这里定义一次）
+    //【参数】output：activate(x)的结果
+    //【返回值】double，f'(x)
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 只用激活值表示，去掉参数x
+    //-------------------------------------------------------------
+    virtual double derivative(double output) const = 0;
+    
     //-------------------------------------------------------------
     //【函数名称】getName
     //【函数功能】获取激活函数名称
@@ -21,6 +21,19 @@ double LinearFunction::activate(double x) const {
     return x;
 }
 
+//-------------------------------------------------------------
+//【函数名称】derivative
+//【函数功能】Linear 导数
+//【参数】output：activate(x)的结果
+//【返回值】double，导数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 只用激活值计算
+//-------------------------------------------------------------
+double LinearFunction::derivative(double output) const {
+    (void)output;
+    return 1.0;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getName
 //【函数功能】获取函数名称
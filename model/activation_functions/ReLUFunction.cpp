@@ -22,6 +22,19 @@ double ReLUFunction::activate(double x) const {
     return max(0.0, x);
 }
 
+//-------------------------------------------------------------
+//【函数名称】derivative
+//【函数功能】ReLU 导数
+//【参数】output：activate(x)的结果
+//【返回值】double，导数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 只用激活值计算
+//-------------------------------------------------------------
+double ReLUFunction::derivative(double output) const {
+    // ReLU outputs are positive exactly where x is
+    return output > 0.0 ? 1.0 : 0.0;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getName
 //【函数功能】获取函数名称
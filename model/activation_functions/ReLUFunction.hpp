@@ -71,6 +71,16 @@ public:
     //-------------------------------------------------------------
     double activate(double x) const override;
     
+    //-------------------------------------------------------------
+    //【函数名称】derivative
+    //【函数功能】ReLU 导数
+    //【参数】output：activate(x)的结果
+    //【返回值】double，output大于0（即x大于0）时为1，否则为0（x=0处取0）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 只用激活值计算
+    //-------------------------------------------------------------
+    double derivative(double output) const override;
+    
     //-------------------------------------------------------------
     //【函数名称】getName
     //【函数功能】获取函数名称
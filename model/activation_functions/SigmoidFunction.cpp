@@ -22,6 +22,18 @@ double SigmoidFunction::activate(double x) const {
     return 1.0 / (1.0 + exp(-x));
 }
 
+//-------------------------------------------------------------
+//【函数名称】derivative
+//【函数功能】Sigmoid 导数
+//【参数】output：activate(x)的结果
+//【返回值】double，导数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 只用激活值计算
+//-------------------------------------------------------------
+double SigmoidFunction::derivative(double output) const {
+    return output * (1.0 - output);
+}
+
 //-------------------------------------------------------------
 //【函数名称】getName
 //【函数功能】获取函数名称
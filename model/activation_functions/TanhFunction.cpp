@@ -25,6 +25,18 @@ double TanhFunction::activate(double x) const {
     return (rEx - rE_neg_x) / (rEx + rE_neg_x);
 }
 
+//-------------------------------------------------------------
+//【函数名称】derivative
+//【函数功能】Tanh 导数
+//【参数】output：activate(x)的结果
+//【返回值】double，导数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 只用激活值计算
+//-------------------------------------------------------------
+double TanhFunction::derivative(double output) const {
+    return 1.0 - output * output;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getName
 //【函数功能】获取函数名称
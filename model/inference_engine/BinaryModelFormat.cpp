@@ -0,0 +1,96 @@
+//-------------------------------------------------------------
+//【文件名】BinaryModelFormat.cpp
+//【功能模块和目的】编译后二进制模型文件（.annb）的文件头读写实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "BinaryModelFormat.hpp"
+#include "CompiledLayer.hpp"
+#include <cstring>
+
+using namespace std;
+
+static const char BINARY_MAGIC[4] = {'A', 'N', 'N', 'B'};
+
+//-------------------------------------------------------------
+//【函数名称】writeHeader
+//【函数功能】写出文件头及层表，块偏移按各层尺寸累加得到
+//【参数】stream：输出流，widths：各层宽度，inputWidths：各层行长度
+//【返回值】bool，写入成功返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool BinaryModelFormat::writeHeader(ostream& stream, const vector<int64_t>& widths,
+                                    const vector<int64_t>& inputWidths) {
+    if (widths.size() != inputWidths.size()) {
+        return false;
+    }
+
+    uint32_t uVersion = VERSION;
+    int64_t iLayerCount = static_cast<int64_t>(widths.size());
+    stream.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    stream.write(reinterpret_cast<const char*>(&uVersion), sizeof(uVersion));
+    stream.write(reinterpret_cast<const char*>(&iLayerCount), sizeof(iLayerCount));
+
+    int64_t iOffset = getHeaderSize(iLayerCount);
+    for (size_t uLayerIdx = 0; uLayerIdx < widths.size(); ++uLayerIdx) {
+        int64_t entry[3] = {iOffset, widths[uLayerIdx], inputWidths[uLayerIdx]};
+        stream.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        iOffset += CompiledLayer::getBlockSize(widths[uLayerIdx], inputWidths[uLayerIdx]);
+    }
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】readHeader
+//【函数功能】读取并校验文件头及层表
+//【参数】stream：输入流，offsets/widths/inputWidths：输出参数
+//【返回值】bool，文件头合法返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool BinaryModelFormat::readHeader(istream& stream, vector<int64_t>& offsets,
+                                   vector<int64_t>& widths, vector<int64_t>& inputWidths) {
+    char magic[4] = {0, 0, 0, 0};
+    uint32_t uVersion = 0;
+    int64_t iLayerCount = 0;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&uVersion), sizeof(uVersion));
+    stream.read(reinterpret_cast<char*>(&iLayerCount), sizeof(iLayerCount));
+    if (!stream || memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 || uVersion != VERSION || iLayerCount <= 0) {
+        return false;
+    }
+
+    offsets.clear();
+    widths.clear();
+    inputWidths.clear();
+    for (int64_t iLayerIdx = 0; iLayerIdx < iLayerCount; ++iLayerIdx) {
+        int64_t entry[3] = {0, 0, 0};
+        stream.read(reinterpret_cast<char*>(entry), sizeof(entry));
+        if (!stream || entry[0] <= 0 || entry[1] <= 0 || entry[2] < 0) {
+            return false;
+        }
+        // Each layer consumes the previous layer's outputs; the input layer is elementwise
+        if (iLayerIdx == 0 ? entry[2] != 1 : entry[2] != widths.back()) {
+            return false;
+        }
+        offsets.push_back(entry[0]);
+        widths.push_back(entry[1]);
+        inputWidths.push_back(entry[2]);
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getHeaderSize
+//【函数功能】计算文件头字节数
+//【参数】layerCount：层数
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t BinaryModelFormat::getHeaderSize(int64_t layerCount) {
+    return static_cast<int64_t>(sizeof(BINARY_MAGIC) + sizeof(uint32_t) + sizeof(int64_t)) +
+           layerCount * 3 * static_cast<int64_t>(sizeof(int64_t));
+}
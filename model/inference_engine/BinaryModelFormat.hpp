@@ -0,0 +1,74 @@
+//-------------------------------------------------------------
+//【文件名】BinaryModelFormat.hpp
+//【功能模块和目的】编译后二进制模型文件（.annb）的文件头读写声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef BinaryModelFormat_hpp
+#define BinaryModelFormat_hpp
+
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】BinaryModelFormat
+//【功能】.annb文件头的读写，所有整数为本机字节序
+//【说明】布局：魔数"ANNB"、uint32版本号、int64层数，随后每层一项
+//       {int64块偏移, int64宽度, int64行长度}，之后依次为各层的CompiledLayer二进制块。
+//       块偏移可由各层尺寸直接算出，因此写出时无需回填，输出流不必可定位。
+//       所有方法均为静态方法，无需实例化
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class BinaryModelFormat {
+public:
+    static const uint32_t VERSION = 1;  // 当前格式版本
+
+    //-------------------------------------------------------------
+    //【函数名称】writeHeader
+    //【函数功能】写出文件头及层表
+    //【参数】stream：输出流，widths：各层宽度，inputWidths：各层行长度
+    //【返回值】bool，写入成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool writeHeader(ostream& stream, const vector<int64_t>& widths, const vector<int64_t>& inputWidths);
+
+    //-------------------------------------------------------------
+    //【函数名称】readHeader
+    //【函数功能】读取并校验文件头及层表
+    //【参数】stream：输入流，offsets/widths/inputWidths：输出各层块偏移、宽度、行长度
+    //【返回值】bool，魔数、版本和层表合法返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool readHeader(istream& stream, vector<int64_t>& offsets,
+                           vector<int64_t>& widths, vector<int64_t>& inputWidths);
+
+    //-------------------------------------------------------------
+    //【函数名称】getHeaderSize
+    //【函数功能】计算文件头（含层表）的字节数
+    //【参数】layerCount：层数
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int64_t getHeaderSize(int64_t layerCount);
+
+    //-------------------------------------------------------------
+    //【函数名称】BinaryModelFormat
+    //【函数功能】禁用构造（静态工具类）
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    BinaryModelFormat() = delete;
+};
+
+#endif // BinaryModelFormat_hpp
@@ -0,0 +1,431 @@
+//-------------------------------------------------------------
+//【文件名】CompiledLayer.cpp
+//【功能模块和目的】编译后的稠密层实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "CompiledLayer.hpp"
+#include "KernelDispatch.hpp"
+#include "PackedGemm.hpp"
+#include "../neural_components/Neuron.hpp"
+#include "../neural_components/Synapse.hpp"
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// Registered activation functions in code order (the N-record codes)
+const char* const ACTIVATION_NAMES[] = {"Linear", "Sigmoid", "Tanh", "ReLU"};
+const int32_t ACTIVATION_CODE_COUNT = 4;
+
+// One shared instance per code, built on first use and read-only afterwards; unknown codes act as Linear
+const ActivationFunction& functionForCode(int32_t code) {
+    static const vector<unique_ptr<ActivationFunction>> functions = [] {
+        vector<unique_ptr<ActivationFunction>> created;
+        for (const char* pName : ACTIVATION_NAMES) {
+            created.push_back(createActivationFunction(pName));
+        }
+        return created;
+    }();
+    return *functions[code >= 0 && code < ACTIVATION_CODE_COUNT ? code : 0];
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】CompiledLayer
+//【函数功能】默认构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledLayer::CompiledLayer() : m_iWidth(0), m_iInputWidth(0), m_bElementwise(false) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~CompiledLayer
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledLayer::~CompiledLayer() = default;
+
+//-------------------------------------------------------------
+//【函数名称】compile
+//【函数功能】从对象图中的一层生成稠密表示
+//【参数】layer：源层，previousWidth：上一层宽度，isInputLayer：是否为输入层
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 生成向量内核使用的面板
+//-------------------------------------------------------------
+bool CompiledLayer::compile(const Layer& layer, int64_t previousWidth, bool isInputLayer) {
+    m_iWidth = layer.getNeuronCount();
+    m_bElementwise = isInputLayer;
+    m_iInputWidth = isInputLayer ? 1 : previousWidth;
+    m_activationCodes.assign(static_cast<size_t>(m_iWidth), 0);
+    m_biases.assign(static_cast<size_t>(m_iWidth), 0.0);
+    m_weights.assign(static_cast<size_t>(m_iWidth * m_iInputWidth), 0.0);
+
+    for (int iNeuronIdx = 0; iNeuronIdx < layer.getNeuronCount(); ++iNeuronIdx) {
+        const Neuron* pNeuron = layer.getNeuron(iNeuronIdx);
+        if (!pNeuron) {
+            return false;
+        }
+        m_activationCodes[iNeuronIdx] = getActivationCode(pNeuron->getActivationFunction());
+        m_biases[iNeuronIdx] = pNeuron->getBias();
+
+        // Input neurons receive exactly one value through exactly one dendrite
+        int iDendrites = pNeuron->getInputSynapseCount();
+        if (isInputLayer && iDendrites != 1) {
+            return false;
+        }
+
+        // Dendrite k multiplies output k of the previous layer; surplus dendrites see 0
+        int64_t iUsed = min<int64_t>(iDendrites, m_iInputWidth);
+        double* pRow = m_weights.data() + iNeuronIdx * m_iInputWidth;
+        for (int64_t iSynapseIdx = 0; iSynapseIdx < iUsed; ++iSynapseIdx) {
+            pRow[iSynapseIdx] = pNeuron->getInputSynapse(static_cast<int>(iSynapseIdx))->getWeight();
+        }
+    }
+
+    packPanelsIfDense(true);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setParameters
+//【函数功能】替换全部偏置和权重
+//【参数】biases：偏置，weights：行主序权重
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void CompiledLayer::setParameters(const double* biases, const double* weights) {
+    copy(biases, biases + m_iWidth, m_biases.begin());
+    copy(weights, weights + m_iWidth * m_iInputWidth, m_weights.begin());
+    // Activations do not change, only the packed copy of the parameters
+    if (!m_panels.empty()) {
+        KernelDispatch::packPanels(m_weights, m_biases, m_iWidth, m_iInputWidth, m_panels);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】setNeuronParameters
+//【函数功能】替换一个神经元的偏置和权重
+//【参数】neuron：神经元下标，bias：偏置，weights：getInputWidth()个权重
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void CompiledLayer::setNeuronParameters(int64_t neuron, double bias, const double* weights) {
+    m_biases[neuron] = bias;
+    copy(weights, weights + m_iInputWidth, m_weights.begin() + neuron * m_iInputWidth);
+    // Only this neuron's lane of its panel changes (layout as in KernelDispatch::packPanels)
+    if (!m_panels.empty()) {
+        const int64_t iLanes = KernelDispatch::PANEL_WIDTH;
+        const int64_t iLane = neuron % iLanes;
+        double* pPanel = m_panels.data() + (neuron / iLanes) * (1 + m_iInputWidth) * iLanes;
+        pPanel[iLane] = bias;
+        for (int64_t iInputIdx = 0; iInputIdx < m_iInputWidth; ++iInputIdx) {
+            pPanel[(1 + iInputIdx) * iLanes + iLane] = weights[iInputIdx];
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】forward
+//【函数功能】计算本层输出，求和顺序与Neuron::computeOutput相同（偏置在先）
+//【参数】inputs：输入，outputs：输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 非输入层按运行时指令集分派到向量内核
+//           2026-10-18 激活函数融合进向量内核
+//-------------------------------------------------------------
+void CompiledLayer::forward(const double* inputs, double* outputs) const {
+    KernelIsa isa = KernelDispatch::getActiveIsa();
+    if (!m_panels.empty() && isa != KernelIsa::Scalar) {
+        KernelDispatch::denseForward(isa, m_panels.data(), m_panelActivations.data(), m_activationCodes.data(),
+                                     m_iWidth, m_iInputWidth, inputs, outputs);
+        return;
+    }
+
+    for (int64_t iNeuronIdx = 0; iNeuronIdx < m_iWidth; ++iNeuronIdx) {
+        double rSum = m_biases[iNeuronIdx];
+        if (m_bElementwise) {
+            rSum += inputs[iNeuronIdx] * m_weights[iNeuronIdx];
+        } else {
+            const double* pRow = m_weights.data() + iNeuronIdx * m_iInputWidth;
+            for (int64_t iInputIdx = 0; iInputIdx < m_iInputWidth; ++iInputIdx) {
+                rSum += inputs[iInputIdx] * pRow[iInputIdx];
+            }
+        }
+        outputs[iNeuronIdx] = applyActivation(m_activationCodes[iNeuronIdx], rSum);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】forwardBatch
+//【函数功能】计算一批样本经过本层的输出
+//【参数】inputs：输入，inputStride：输入跨度，rows：样本数，outputs：输出，outputStride：输出跨度
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 激活函数融合进矩阵乘分块
+//-------------------------------------------------------------
+void CompiledLayer::forwardBatch(const double* inputs, int64_t inputStride, int64_t rows,
+                                 double* outputs, int64_t outputStride) const {
+    KernelIsa isa = KernelDispatch::getActiveIsa();
+    if (m_panels.empty() || isa == KernelIsa::Scalar) {
+        for (int64_t iRow = 0; iRow < rows; ++iRow) {
+            forward(inputs + iRow * inputStride, outputs + iRow * outputStride);
+        }
+        return;
+    }
+
+    PackedGemm::multiply(isa, m_panels.data(), m_panelActivations.data(), m_activationCodes.data(),
+                         m_iWidth, m_iInputWidth, inputs, inputStride, rows, outputs, outputStride);
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeTo
+//【函数功能】以二进制块写出本层
+//【参数】stream：输出流
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledLayer::writeTo(ostream& stream) const {
+    stream.write(reinterpret_cast<const char*>(&m_iWidth), sizeof(m_iWidth));
+    stream.write(reinterpret_cast<const char*>(&m_iInputWidth), sizeof(m_iInputWidth));
+    if (m_iWidth > 0) {
+        stream.write(reinterpret_cast<const char*>(m_activationCodes.data()),
+                     static_cast<streamsize>(m_activationCodes.size() * sizeof(int32_t)));
+        stream.write(reinterpret_cast<const char*>(m_biases.data()),
+                     static_cast<streamsize>(m_biases.size() * sizeof(double)));
+        stream.write(reinterpret_cast<const char*>(m_weights.data()),
+                     static_cast<streamsize>(m_weights.size() * sizeof(double)));
+    }
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】readFrom
+//【函数功能】从二进制块读取本层
+//【参数】stream：输入流，isInputLayer：是否为输入层，packPanels：是否生成面板
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 读取后按需生成面板
+//-------------------------------------------------------------
+bool CompiledLayer::readFrom(istream& stream, bool isInputLayer, bool packPanels) {
+    int64_t iWidth = 0;
+    int64_t iInputWidth = 0;
+    stream.read(reinterpret_cast<char*>(&iWidth), sizeof(iWidth));
+    stream.read(reinterpret_cast<char*>(&iInputWidth), sizeof(iInputWidth));
+    if (!stream || iWidth <= 0 || iInputWidth < 0 || (isInputLayer && iInputWidth != 1)) {
+        return false;
+    }
+
+    m_iWidth = iWidth;
+    m_iInputWidth = iInputWidth;
+    m_bElementwise = isInputLayer;
+    // resize() keeps the capacity of a recycled buffer
+    m_activationCodes.resize(static_cast<size_t>(iWidth));
+    m_biases.resize(static_cast<size_t>(iWidth));
+    m_weights.resize(static_cast<size_t>(iWidth * iInputWidth));
+
+    stream.read(reinterpret_cast<char*>(m_activationCodes.data()),
+                static_cast<streamsize>(m_activationCodes.size() * sizeof(int32_t)));
+    stream.read(reinterpret_cast<char*>(m_biases.data()),
+                static_cast<streamsize>(m_biases.size() * sizeof(double)));
+    if (!m_weights.empty()) {
+        stream.read(reinterpret_cast<char*>(m_weights.data()),
+                    static_cast<streamsize>(m_weights.size() * sizeof(double)));
+    }
+    if (stream.fail()) {
+        return false;
+    }
+    packPanelsIfDense(packPanels);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】packPanelsIfDense
+//【函数功能】为非输入层生成向量内核使用的面板及激活分类，输入层清空两者
+//【参数】enabled：为false时只清空
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 同时生成面板激活分类
+//-------------------------------------------------------------
+void CompiledLayer::packPanelsIfDense(bool enabled) {
+    if (m_bElementwise || !enabled) {
+        m_panels.clear();
+        m_panelActivations.clear();
+    } else {
+        KernelDispatch::packPanels(m_weights, m_biases, m_iWidth, m_iInputWidth, m_panels);
+        KernelDispatch::describeActivations(m_activationCodes.data(), m_iWidth, m_panelActivations);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getWidth
+//【函数功能】获取神经元数量
+//【参数】无
+//【返回值】int64_t，神经元数量
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledLayer::getWidth() const {
+    return m_iWidth;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputWidth
+//【函数功能】获取每行权重数量
+//【参数】无
+//【返回值】int64_t，行长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledLayer::getInputWidth() const {
+    return m_iInputWidth;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isElementwise
+//【函数功能】是否为逐元素计算的输入层
+//【参数】无
+//【返回值】bool，输入层返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledLayer::isElementwise() const {
+    return m_bElementwise;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getWeights
+//【函数功能】获取行主序稠密权重
+//【参数】无
+//【返回值】const vector<double>&，权重
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<double>& CompiledLayer::getWeights() const {
+    return m_weights;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getBiases
+//【函数功能】获取各神经元偏置
+//【参数】无
+//【返回值】const vector<double>&，偏置
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<double>& CompiledLayer::getBiases() const {
+    return m_biases;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getActivationCodes
+//【函数功能】获取各神经元激活函数代码
+//【参数】无
+//【返回值】const vector<int32_t>&，激活函数代码
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<int32_t>& CompiledLayer::getActivationCodes() const {
+    return m_activationCodes;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResidentBytes
+//【函数功能】获取本层数据占用的内存字节数（按容量计）
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 计入打包后的面板及激活分类
+//-------------------------------------------------------------
+int64_t CompiledLayer::getResidentBytes() const {
+    return static_cast<int64_t>(m_activationCodes.capacity() * sizeof(int32_t) +
+                                m_panelActivations.capacity() * sizeof(PanelActivation) +
+                                (m_biases.capacity() + m_weights.capacity() + m_panels.capacity()) *
+                                sizeof(double));
+}
+
+//-------------------------------------------------------------
+//【函数名称】getBlockSize
+//【函数功能】计算二进制块的字节数
+//【参数】width：神经元数量，inputWidth：行长度
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledLayer::getBlockSize(int64_t width, int64_t inputWidth) {
+    return 2 * static_cast<int64_t>(sizeof(int64_t)) +
+           width * static_cast<int64_t>(sizeof(int32_t) + sizeof(double)) +
+           width * inputWidth * static_cast<int64_t>(sizeof(double));
+}
+
+//-------------------------------------------------------------
+//【函数名称】getActivationCode
+//【函数功能】将激活函数对象映射为代码
+//【参数】function：激活函数指针
+//【返回值】int32_t，激活函数代码
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 名称与代码的对应改为查表，与applyDerivative共用
+//-------------------------------------------------------------
+int32_t CompiledLayer::getActivationCode(const ActivationFunction* function) {
+    if (!function) {
+        return 0;
+    }
+    string name = function->getName();
+    for (int32_t iCode = 1; iCode < ACTIVATION_CODE_COUNT; ++iCode) {
+        if (name == ACTIVATION_NAMES[iCode]) {
+            return iCode;
+        }
+    }
+    return 0; // Linear and unknown functions
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyActivation
+//【函数功能】按代码计算激活值
+//【参数】code：激活函数代码，x：加权和
+//【返回值】double，激活值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double CompiledLayer::applyActivation(int32_t code, double x) {
+    switch (code) {
+        case 1:
+            return 1.0 / (1.0 + exp(-x));
+        case 2: {
+            // Same expression as TanhFunction so that results match bit for bit
+            double rEx = exp(x);
+            double rENegX = exp(-x);
+            return (rEx - rENegX) / (rEx + rENegX);
+        }
+        case 3:
+            return max(0.0, x);
+        default:
+            return x;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyDerivative
+//【函数功能】按代码由激活值计算导数
+//【参数】code：激活函数代码，output：激活值
+//【返回值】double，导数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 改为调用该代码对应的ActivationFunction::derivative，不再另写公式
+//-------------------------------------------------------------
+double CompiledLayer::applyDerivative(int32_t code, double output) {
+    return functionForCode(code).derivative(output);
+}
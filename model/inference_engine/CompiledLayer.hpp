@@ -0,0 +1,285 @@
+//-------------------------------------------------------------
+//【文件名】CompiledLayer.hpp
+//【功能模块和目的】编译后的稠密层（连续存储的权重、偏置和激活函数代码）声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef CompiledLayer_hpp
+#define CompiledLayer_hpp
+
+#include "../neural_components/Layer.hpp"
+#include "../activation_functions/ActivationFunction.hpp"
+#include "KernelDispatch.hpp"
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】CompiledLayer
+//【功能】将一层神经元压平为行主序稠密权重矩阵，用于不依赖对象图的推理
+//【说明】与Network::predict的语义一致：输入层逐元素计算（神经元j读取输入j）；
+//       其余层中神经元j的第k个树突与上一层第k个输出相乘，缺少的位置以0填充，
+//       超出上一层宽度的树突被忽略。激活函数代码：0 Linear，1 Sigmoid，2 Tanh，3 ReLU
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 另存一份按KernelDispatch面板打包的权重，非输入层按运行时指令集选择内核
+//           2026-10-18 向量内核融合激活函数，每层输出只写一次
+//           2026-10-18 支持训练器替换参数（setParameters）和按代码计算导数
+//           2026-10-18 支持只替换一个神经元的参数（setNeuronParameters）
+//-------------------------------------------------------------
+class CompiledLayer {
+private:
+    int64_t m_iWidth;                    // Number of neurons
+    int64_t m_iInputWidth;               // Row length: previous layer width, 1 for the input layer
+    bool m_bElementwise;                 // Input layer: neuron j reads input j
+    vector<int32_t> m_activationCodes;   // One code per neuron
+    vector<double> m_biases;             // One bias per neuron
+    vector<double> m_weights;            // m_iWidth x m_iInputWidth, row-major
+    vector<double> m_panels;             // Biases and weights repacked for the vector kernels
+    vector<PanelActivation> m_panelActivations;  // Activation lanes of each panel, fused into the kernels
+
+    //-------------------------------------------------------------
+    //【函数名称】packPanelsIfDense
+    //【函数功能】为非输入层生成向量内核使用的面板（KernelDispatch::packPanels）及各面板的
+    //           激活函数分类（KernelDispatch::describeActivations），输入层清空两者
+    //【参数】enabled：为false时只清空
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 同时生成面板激活分类
+    //-------------------------------------------------------------
+    void packPanelsIfDense(bool enabled);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】CompiledLayer
+    //【函数功能】默认构造函数，创建空层
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledLayer();
+
+    //-------------------------------------------------------------
+    //【函数名称】CompiledLayer（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的层
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledLayer(const CompiledLayer& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源层
+    //【返回值】CompiledLayer&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledLayer& operator=(const CompiledLayer& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】~CompiledLayer
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~CompiledLayer();
+
+    //-------------------------------------------------------------
+    //【函数名称】compile
+    //【函数功能】从对象图中的一层生成稠密表示
+    //【参数】layer：源层，previousWidth：上一层神经元数量（输入层忽略），isInputLayer：是否为输入层
+    //【返回值】bool，成功返回true；输入层神经元的树突数不为1时返回false（predict会因此失败）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool compile(const Layer& layer, int64_t previousWidth, bool isInputLayer);
+
+    //-------------------------------------------------------------
+    //【函数名称】setParameters
+    //【函数功能】替换全部偏置和权重（训练器每次更新后调用），已生成面板时重新打包面板
+    //【参数】biases：getWidth()个偏置，weights：getWidth()×getInputWidth()个行主序权重
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setParameters(const double* biases, const double* weights);
+
+    //-------------------------------------------------------------
+    //【函数名称】setNeuronParameters
+    //【函数功能】只替换一个神经元的偏置和权重（Hogwild训练刷新被其他线程改过的行），
+    //       已生成面板时只改写该神经元所在的面板通道，代价与行长度成正比
+    //【参数】neuron：神经元下标，bias：偏置，weights：getInputWidth()个权重
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setNeuronParameters(int64_t neuron, double bias, const double* weights);
+
+    //-------------------------------------------------------------
+    //【函数名称】forward
+    //【函数功能】计算本层输出，已生成面板的非输入层使用KernelDispatch::getActiveIsa()级别的内核，
+    //           激活函数在内核写回前计算
+    //【参数】inputs：输入（输入层为getWidth()个，其余为getInputWidth()个），outputs：getWidth()个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 按运行时检测的指令集分派
+    //           2026-10-18 融合激活函数
+    //-------------------------------------------------------------
+    void forward(const double* inputs, double* outputs) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】forwardBatch
+    //【函数功能】计算一批样本经过本层的输出，已生成面板的非输入层使用PackedGemm分块矩阵乘
+    //           （激活函数在分块写回前计算），每行结果与forward逐位一致
+    //【参数】inputs：rows行输入，inputStride：输入行跨度，rows：样本数，
+    //       outputs：rows行输出，outputStride：输出行跨度，不小于PackedGemm::getPaddedWidth(getWidth())
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void forwardBatch(const double* inputs, int64_t inputStride, int64_t rows,
+                      double* outputs, int64_t outputStride) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】writeTo
+    //【函数功能】以二进制块写出本层（宽度、行长度、激活代码、偏置、权重，本机字节序）
+    //【参数】stream：输出流
+    //【返回值】bool，写入成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool writeTo(ostream& stream) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】readFrom
+    //【函数功能】从二进制块读取本层，复用已有缓冲区容量
+    //【参数】stream：输入流（已定位到块起始处），isInputLayer：是否为输入层，
+    //       packPanels：是否生成向量内核的面板（不生成时forward使用标量内核，内存占用减半）
+    //【返回值】bool，读取成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加packPanels参数
+    //-------------------------------------------------------------
+    bool readFrom(istream& stream, bool isInputLayer, bool packPanels = true);
+
+    //-------------------------------------------------------------
+    //【函数名称】getWidth
+    //【函数功能】获取神经元数量
+    //【参数】无
+    //【返回值】int64_t，神经元数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getWidth() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputWidth
+    //【函数功能】获取每行权重数量
+    //【参数】无
+    //【返回值】int64_t，行长度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputWidth() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】isElementwise
+    //【函数功能】是否为逐元素计算的输入层
+    //【参数】无
+    //【返回值】bool，输入层返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isElementwise() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getWeights
+    //【函数功能】获取行主序稠密权重（getWidth()行，每行getInputWidth()个）
+    //【参数】无
+    //【返回值】const vector<double>&，权重
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<double>& getWeights() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getBiases
+    //【函数功能】获取各神经元偏置
+    //【参数】无
+    //【返回值】const vector<double>&，偏置
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<double>& getBiases() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getActivationCodes
+    //【函数功能】获取各神经元激活函数代码
+    //【参数】无
+    //【返回值】const vector<int32_t>&，激活函数代码
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<int32_t>& getActivationCodes() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getResidentBytes
+    //【函数功能】获取本层数据占用的内存字节数
+    //【参数】无
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 计入打包后的面板及激活分类
+    //-------------------------------------------------------------
+    int64_t getResidentBytes() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getBlockSize
+    //【函数功能】计算二进制块的字节数
+    //【参数】width：神经元数量，inputWidth：行长度
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int64_t getBlockSize(int64_t width, int64_t inputWidth);
+
+    //-------------------------------------------------------------
+    //【函数名称】getActivationCode
+    //【函数功能】将激活函数对象映射为代码（与ANN文件N记录一致，未知或空指针为0）
+    //【参数】function：激活函数指针
+    //【返回值】int32_t，激活函数代码
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int32_t getActivationCode(const ActivationFunction* function);
+
+    //-------------------------------------------------------------
+    //【函数名称】applyActivation
+    //【函数功能】按代码计算激活值，公式与各ActivationFunction子类相同
+    //【参数】code：激活函数代码，x：加权和
+    //【返回值】double，激活值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static double applyActivation(int32_t code, double x);
+
+    //-------------------------------------------------------------
+    //【函数名称】applyDerivative
+    //【函数功能】按代码由激活值计算导数：调用该代码对应的已注册激活函数（createActivationFunction
+    //           创建、只读共享的实例）的derivative，导数公式只在各ActivationFunction子类中定义
+    //【参数】code：激活函数代码（未知代码按Linear处理），output：激活值
+    //【返回值】double，导数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 改为调用ActivationFunction::derivative
+    //-------------------------------------------------------------
+    static double applyDerivative(int32_t code, double output);
+};
+
+#endif // CompiledLayer_hpp
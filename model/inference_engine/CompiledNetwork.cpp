@@ -0,0 +1,389 @@
+//-------------------------------------------------------------
+//【文件名】CompiledNetwork.cpp
+//【功能模块和目的】编译后的整网推理模型实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "CompiledNetwork.hpp"
+#include "BinaryModelFormat.hpp"
+#include "PackedGemm.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】CompiledNetwork
+//【函数功能】默认构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledNetwork::CompiledNetwork() = default;
+
+//-------------------------------------------------------------
+//【函数名称】~CompiledNetwork
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+CompiledNetwork::~CompiledNetwork() = default;
+
+//-------------------------------------------------------------
+//【函数名称】compile
+//【函数功能】编译网络的全部层
+//【参数】network：源网络
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 网络选择Jit引擎时尝试即时编译
+//-------------------------------------------------------------
+bool CompiledNetwork::compile(const Network& network) {
+    m_layers.clear();
+    m_jit.reset();
+    if (network.getLayerCount() == 0 || !network.isValid()) {
+        return false;
+    }
+
+    m_layers.resize(static_cast<size_t>(network.getLayerCount()));
+    int64_t iPreviousWidth = 0;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        const Layer* pLayer = network.getLayer(iLayerIdx);
+        if (!pLayer || pLayer->getNeuronCount() == 0 ||
+            !m_layers[iLayerIdx].compile(*pLayer, iPreviousWidth, iLayerIdx == 0)) {
+            m_layers.clear();
+            return false;
+        }
+        iPreviousWidth = pLayer->getNeuronCount();
+    }
+    if (network.getInferenceEngine() == InferenceEngine::Jit) {
+        compileJit();
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】predict
+//【函数功能】执行前向传播，两个局部缓冲区交替使用
+//【参数】inputs：输入向量
+//【返回值】vector<double>，输出层结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 已即时编译时执行生成的代码
+//-------------------------------------------------------------
+vector<double> CompiledNetwork::predict(const vector<double>& inputs) const {
+    if (m_layers.empty()) {
+        throw runtime_error("Network has no layers");
+    }
+    if (static_cast<int64_t>(inputs.size()) != m_layers[0].getWidth()) {
+        throw runtime_error("Input size mismatch with first layer neuron count");
+    }
+
+    if (m_jit) {
+        vector<double> outputs(static_cast<size_t>(m_jit->getOutputSize()));
+        vector<double> scratch(static_cast<size_t>(m_jit->getScratchSize()));
+        m_jit->run(inputs.data(), outputs.data(), scratch.data());
+        return outputs;
+    }
+    return predictWithLayers(inputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】predictBatch
+//【函数功能】对一批样本执行前向传播
+//【参数】inputs：输入矩阵，rows：样本数
+//【返回值】vector<double>，输出矩阵
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 逐层计算移到forwardRows
+//-------------------------------------------------------------
+vector<double> CompiledNetwork::predictBatch(const vector<double>& inputs, int64_t rows) const {
+    if (m_layers.empty()) {
+        throw runtime_error("Network has no layers");
+    }
+    if (rows < 0 || static_cast<int64_t>(inputs.size()) != rows * getInputSize()) {
+        throw runtime_error("Input size mismatch with first layer neuron count");
+    }
+
+    vector<double> outputs(static_cast<size_t>(rows * getOutputSize()));
+    forwardRows(inputs.data(), rows, outputs.data());
+    return outputs;
+}
+
+//-------------------------------------------------------------
+//【函数名称】predictBatch
+//【函数功能】在线程池上执行批量前向传播
+//【参数】inputs：输入矩阵，rows：样本数，pool：线程池
+//【返回值】vector<double>，输出矩阵
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> CompiledNetwork::predictBatch(const vector<double>& inputs, int64_t rows, ThreadPool& pool) const {
+    if (m_layers.empty()) {
+        throw runtime_error("Network has no layers");
+    }
+    if (rows < 0 || static_cast<int64_t>(inputs.size()) != rows * getInputSize()) {
+        throw runtime_error("Input size mismatch with first layer neuron count");
+    }
+
+    // Blocks depend only on the row count; rows never share a sum, so any split gives the same bits
+    vector<double> outputs(static_cast<size_t>(rows * getOutputSize()));
+    const int64_t iBlockRows = PackedGemm::BLOCK_ROWS;
+    const int64_t iBlocks = (rows + iBlockRows - 1) / iBlockRows;
+    pool.parallelFor(iBlocks, [&](int64_t iBlock, int) {
+        int64_t iFirst = iBlock * iBlockRows;
+        forwardRows(inputs.data() + iFirst * getInputSize(), min(iBlockRows, rows - iFirst),
+                    outputs.data() + iFirst * getOutputSize());
+    });
+    return outputs;
+}
+
+//-------------------------------------------------------------
+//【函数名称】forwardRows
+//【函数功能】逐层计算连续若干行样本，中间结果的行跨度按面板宽度对齐
+//【参数】inputs：输入，rows：样本数，outputs：输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void CompiledNetwork::forwardRows(const double* inputs, int64_t rows, double* outputs) const {
+    const int64_t iInputs = getInputSize();
+    vector<double> current(inputs, inputs + rows * iInputs);
+    vector<double> next;
+    int64_t iStride = iInputs;
+    for (const CompiledLayer& layer : m_layers) {
+        int64_t iNextStride = PackedGemm::getPaddedWidth(layer.getWidth());
+        next.assign(static_cast<size_t>(rows * iNextStride), 0.0);
+        layer.forwardBatch(current.data(), iStride, rows, next.data(), iNextStride);
+        current.swap(next);
+        iStride = iNextStride;
+    }
+
+    // Drop the padding columns of the last layer
+    const int64_t iOutputs = getOutputSize();
+    for (int64_t iRow = 0; iRow < rows; ++iRow) {
+        copy(current.begin() + iRow * iStride, current.begin() + iRow * iStride + iOutputs,
+             outputs + iRow * iOutputs);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】predictWithLayers
+//【函数功能】用各层的通用稠密内核执行前向传播
+//【参数】inputs：输入
+//【返回值】vector<double>，输出层结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> CompiledNetwork::predictWithLayers(const vector<double>& inputs) const {
+    vector<double> current(inputs);
+    vector<double> next;
+    for (const CompiledLayer& layer : m_layers) {
+        next.assign(static_cast<size_t>(layer.getWidth()), 0.0);
+        layer.forward(current.data(), next.data());
+        current.swap(next);
+    }
+    return current;
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeTo
+//【函数功能】以.annb格式写出整个模型
+//【参数】stream：输出流
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledNetwork::writeTo(ostream& stream) const {
+    if (m_layers.empty()) {
+        return false;
+    }
+
+    vector<int64_t> widths;
+    vector<int64_t> inputWidths;
+    for (const CompiledLayer& layer : m_layers) {
+        widths.push_back(layer.getWidth());
+        inputWidths.push_back(layer.getInputWidth());
+    }
+    if (!BinaryModelFormat::writeHeader(stream, widths, inputWidths)) {
+        return false;
+    }
+    for (const CompiledLayer& layer : m_layers) {
+        if (!layer.writeTo(stream)) {
+            return false;
+        }
+    }
+    return stream.good();
+}
+
+//-------------------------------------------------------------
+//【函数名称】readFrom
+//【函数功能】从.annb格式的流中顺序读取整个模型
+//【参数】stream：输入流
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledNetwork::readFrom(istream& stream) {
+    m_layers.clear();
+    m_jit.reset();
+    vector<int64_t> offsets;
+    vector<int64_t> widths;
+    vector<int64_t> inputWidths;
+    if (!BinaryModelFormat::readHeader(stream, offsets, widths, inputWidths)) {
+        return false;
+    }
+
+    // Blocks follow the layer table back to back, so no seeking is needed
+    vector<CompiledLayer> layers(widths.size());
+    for (size_t uLayerIdx = 0; uLayerIdx < layers.size(); ++uLayerIdx) {
+        if (!layers[uLayerIdx].readFrom(stream, uLayerIdx == 0) ||
+            layers[uLayerIdx].getWidth() != widths[uLayerIdx] ||
+            layers[uLayerIdx].getInputWidth() != inputWidths[uLayerIdx]) {
+            return false;
+        }
+    }
+    m_layers.swap(layers);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】compileJit
+//【函数功能】生成机器码并与稠密内核逐位比对
+//【参数】无
+//【返回值】bool，是否启用即时编译
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledNetwork::compileJit() {
+    m_jit.reset();
+    shared_ptr<JitKernel> kernel(new JitKernel());
+    if (m_layers.empty() || !kernel->compile(m_layers)) {
+        return false;
+    }
+
+    // Deterministic probes spanning the saturating ranges of sigmoid and tanh, plus all zeros
+    const size_t uInputs = static_cast<size_t>(getInputSize());
+    vector<double> probe(uInputs, 0.0);
+    vector<double> outputs(static_cast<size_t>(kernel->getOutputSize()));
+    vector<double> scratch(static_cast<size_t>(kernel->getScratchSize()));
+    uint64_t uState = 0x9E3779B97F4A7C15ULL;
+    for (int iProbe = 0; iProbe < 8; ++iProbe) {
+        kernel->run(probe.data(), outputs.data(), scratch.data());
+        vector<double> expected = predictWithLayers(probe);
+        if (memcmp(outputs.data(), expected.data(), outputs.size() * sizeof(double)) != 0) {
+            return false;
+        }
+        for (double& rValue : probe) {
+            uState = uState * 6364136223846793005ULL + 1442695040888963407ULL;
+            rValue = static_cast<double>(uState >> 11) / 9007199254740992.0 * 16.0 - 8.0;
+        }
+    }
+    m_jit = kernel;
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isJitActive
+//【函数功能】判断predict是否使用即时编译的代码
+//【参数】无
+//【返回值】bool，是否使用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledNetwork::isJitActive() const {
+    return m_jit != nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getJitCodeBytes
+//【函数功能】获取生成的机器码字节数
+//【参数】无
+//【返回值】size_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+size_t CompiledNetwork::getJitCodeBytes() const {
+    return m_jit ? m_jit->getCodeBytes() : 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isCompiled
+//【函数功能】判断是否已成功编译
+//【参数】无
+//【返回值】bool，已编译返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool CompiledNetwork::isCompiled() const {
+    return !m_layers.empty();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLayerCount
+//【函数功能】获取层数
+//【参数】无
+//【返回值】int，层数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int CompiledNetwork::getLayerCount() const {
+    return static_cast<int>(m_layers.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLayer
+//【函数功能】获取指定编译层
+//【参数】index：层索引
+//【返回值】const CompiledLayer*，索引无效时返回nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const CompiledLayer* CompiledNetwork::getLayer(int index) const {
+    if (index >= 0 && index < static_cast<int>(m_layers.size())) {
+        return &m_layers[index];
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取输入层宽度
+//【参数】无
+//【返回值】int64_t，输入长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledNetwork::getInputSize() const {
+    return m_layers.empty() ? 0 : m_layers.front().getWidth();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOutputSize
+//【函数功能】获取输出层宽度
+//【参数】无
+//【返回值】int64_t，输出长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t CompiledNetwork::getOutputSize() const {
+    return m_layers.empty() ? 0 : m_layers.back().getWidth();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getResidentBytes
+//【函数功能】获取全部层数据占用的内存字节数
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 计入即时编译生成的代码
+//-------------------------------------------------------------
+int64_t CompiledNetwork::getResidentBytes() const {
+    int64_t iTotal = 0;
+    for (const CompiledLayer& layer : m_layers) {
+        iTotal += layer.getResidentBytes();
+    }
+    return iTotal + static_cast<int64_t>(getJitCodeBytes());
+}
@@ -0,0 +1,251 @@
+//-------------------------------------------------------------
+//【文件名】CompiledNetwork.hpp
+//【功能模块和目的】编译后的整网推理模型声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef CompiledNetwork_hpp
+#define CompiledNetwork_hpp
+
+#include "CompiledLayer.hpp"
+#include "JitKernel.hpp"
+#include "../neural_components/Network.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】CompiledNetwork
+//【功能】由Network逐层编译得到的只读推理模型
+//【说明】predict为const且不修改任何成员，可被多个线程同时调用；
+//       编译后与源网络不再关联，源网络之后的修改不会反映到本对象
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 源网络选择InferenceEngine::Jit时生成JitKernel，校验通过后由predict使用
+//-------------------------------------------------------------
+class CompiledNetwork {
+private:
+    vector<CompiledLayer> m_layers;     // One dense layer per network layer
+    shared_ptr<const JitKernel> m_jit;  // Generated code, null when the dense kernels are used
+
+    //-------------------------------------------------------------
+    //【函数名称】predictWithLayers
+    //【函数功能】用各层的通用稠密内核执行前向传播
+    //【参数】inputs：输入，长度已校验
+    //【返回值】vector<double>，输出层结果
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predictWithLayers(const vector<double>& inputs) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】forwardRows
+    //【函数功能】用各层的forwardBatch计算连续若干行样本，结果写入输出矩阵的对应行
+    //【参数】inputs：rows行输入，rows：样本数，outputs：rows行输出（行跨度为输出层宽度）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void forwardRows(const double* inputs, int64_t rows, double* outputs) const;
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】CompiledNetwork
+    //【函数功能】默认构造函数，创建空模型
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledNetwork();
+
+    //-------------------------------------------------------------
+    //【函数名称】CompiledNetwork（拷贝构造）
+    //【函数功能】拷贝构造函数
+    //【参数】other：被拷贝的模型
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledNetwork(const CompiledNetwork& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符重载
+    //【参数】other：赋值来源模型
+    //【返回值】CompiledNetwork&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CompiledNetwork& operator=(const CompiledNetwork& other) = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】~CompiledNetwork
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~CompiledNetwork();
+
+    //-------------------------------------------------------------
+    //【函数名称】compile
+    //【函数功能】编译网络的全部层（延迟加载的网络会先加载全部层）
+    //【参数】network：源网络
+    //【返回值】bool，网络有效且各层均可编译时返回true，失败时模型被清空
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 网络选择Jit引擎时尝试即时编译，失败不影响返回值
+    //-------------------------------------------------------------
+    bool compile(const Network& network);
+
+    //-------------------------------------------------------------
+    //【函数名称】compileJit
+    //【函数功能】为已编译的各层生成机器码，并用一组固定的探测输入与稠密内核逐位比对
+    //【参数】无
+    //【返回值】bool，生成且校验通过返回true，之后predict使用生成的代码；否则继续使用稠密内核
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool compileJit();
+
+    //-------------------------------------------------------------
+    //【函数名称】isJitActive
+    //【函数功能】判断predict是否使用即时编译的代码
+    //【参数】无
+    //【返回值】bool，使用生成的代码返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isJitActive() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getJitCodeBytes
+    //【函数功能】获取生成的机器码字节数
+    //【参数】无
+    //【返回值】size_t，字节数，未使用即时编译时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    size_t getJitCodeBytes() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】执行前向传播，结果与Network::predict一致
+    //【参数】inputs：输入向量，长度须等于输入层宽度
+    //【返回值】vector<double>，输出层结果；未编译或输入长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predict(const vector<double>& inputs) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】predictBatch
+    //【函数功能】对一批样本执行前向传播，各层用CompiledLayer::forwardBatch（分块矩阵乘）整批计算，
+    //           每行结果与predict逐位一致；不使用即时编译的代码
+    //【参数】inputs：rows行输入，按行连续存放，rows：样本数
+    //【返回值】vector<double>，rows行输出，按行连续存放；未编译或输入长度不为rows×输入宽度时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predictBatch(const vector<double>& inputs, int64_t rows) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】predictBatch
+    //【函数功能】在线程池上执行批量前向传播：样本按PackedGemm::BLOCK_ROWS行分块，各块由不同
+    //           线程独立计算。并行只发生在样本之间，每个输出仍由单个线程按固定顺序求和，
+    //           因此结果与线程数无关，每行与predict逐位一致
+    //【参数】inputs：rows行输入，rows：样本数，pool：线程池
+    //【返回值】vector<double>，rows行输出；异常同单线程版本
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predictBatch(const vector<double>& inputs, int64_t rows, ThreadPool& pool) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】writeTo
+    //【函数功能】以.annb格式（BinaryModelFormat文件头加各层二进制块）写出整个模型
+    //【参数】stream：输出流
+    //【返回值】bool，模型已编译且写入成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool writeTo(ostream& stream) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】readFrom
+    //【函数功能】从.annb格式的流中顺序读取整个模型，无需解析文本或重建对象图
+    //【参数】stream：输入流（已定位到文件头）
+    //【返回值】bool，读取成功返回true；失败时模型为空
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool readFrom(istream& stream);
+
+    //-------------------------------------------------------------
+    //【函数名称】isCompiled
+    //【函数功能】判断是否已成功编译
+    //【参数】无
+    //【返回值】bool，已编译返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isCompiled() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getLayerCount
+    //【函数功能】获取层数
+    //【参数】无
+    //【返回值】int，层数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getLayerCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getLayer
+    //【函数功能】获取指定编译层
+    //【参数】index：层索引
+    //【返回值】const CompiledLayer*，索引无效时返回nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const CompiledLayer* getLayer(int index) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取输入层宽度
+    //【参数】无
+    //【返回值】int64_t，输入长度，未编译时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getOutputSize
+    //【函数功能】获取输出层宽度
+    //【参数】无
+    //【返回值】int64_t，输出长度，未编译时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getOutputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getResidentBytes
+    //【函数功能】获取全部层数据占用的内存字节数
+    //【参数】无
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getResidentBytes() const;
+};
+
+#endif // CompiledNetwork_hpp
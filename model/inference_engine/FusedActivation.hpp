@@ -0,0 +1,135 @@
+//-------------------------------------------------------------
+//【文件名】FusedActivation.hpp
+//【功能模块和目的】在寄存器中对一个面板的加权和计算激活函数（供各向量内核共用，仅头文件）
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef FusedActivation_hpp
+#define FusedActivation_hpp
+
+#include "KernelDispatch.hpp"
+#include "CompiledLayer.hpp"
+#include <cstdint>
+
+#ifdef ANN_KERNEL_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】FusedActivation
+//【功能】稠密内核和矩阵乘内核的收尾步骤：累加结束后、写回内存前，对寄存器中的
+//       PANEL_WIDTH个加权和按PanelActivation计算激活值
+//【说明】ReLU为maxpd(x, 0)，对NaN和-0.0与max(0.0, x)的结果相同；Sigmoid和Tanh通道
+//       暂存到栈上的8个元素后逐个调用CompiledLayer::applyActivation，与标量内核逐位一致。
+//       向量版本只在ANN_KERNEL_DISPATCH平台上提供，且只能在对应target的函数中调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class FusedActivation {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】applyLanes
+    //【函数功能】逐通道计算mask中各通道的激活值
+    //【参数】mask：通道位图，codes：本面板各神经元的激活函数代码，lanes：PANEL_WIDTH个值
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void applyLanes(uint8_t mask, const int32_t* codes, double* lanes) {
+        for (int iLane = 0; iLane < KernelDispatch::PANEL_WIDTH; ++iLane) {
+            if ((mask >> iLane) & 1) {
+                lanes[iLane] = CompiledLayer::applyActivation(codes[iLane], lanes[iLane]);
+            }
+        }
+    }
+
+#ifdef ANN_KERNEL_DISPATCH
+    //-------------------------------------------------------------
+    //【函数名称】applySSE2
+    //【函数功能】对4个xmm寄存器中的一个面板计算激活值
+    //【参数】activation：面板分类，codes：激活函数代码，acc：加权和，计算后为激活值
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void applySSE2(const PanelActivation& activation, const int32_t* codes, __m128d (&acc)[4]) {
+        if (activation.uReluLanes != 0) {
+            const __m128d zero = _mm_setzero_pd();
+            for (int iVec = 0; iVec < 4; ++iVec) {
+                __m128d relu = _mm_max_pd(acc[iVec], zero);
+                // SSE2 has no blend: select per lane with an all-ones mask
+                __m128d select = _mm_castsi128_pd(_mm_set_epi64x(
+                    -static_cast<int64_t>((activation.uReluLanes >> (2 * iVec + 1)) & 1),
+                    -static_cast<int64_t>((activation.uReluLanes >> (2 * iVec)) & 1)));
+                acc[iVec] = _mm_or_pd(_mm_and_pd(select, relu), _mm_andnot_pd(select, acc[iVec]));
+            }
+        }
+        if (activation.uScalarLanes != 0) {
+            double lanes[KernelDispatch::PANEL_WIDTH];
+            for (int iVec = 0; iVec < 4; ++iVec) {
+                _mm_storeu_pd(lanes + 2 * iVec, acc[iVec]);
+            }
+            applyLanes(activation.uScalarLanes, codes, lanes);
+            for (int iVec = 0; iVec < 4; ++iVec) {
+                acc[iVec] = _mm_loadu_pd(lanes + 2 * iVec);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】applyAVX2
+    //【函数功能】对2个ymm寄存器中的一个面板计算激活值
+    //【参数】activation：面板分类，codes：激活函数代码，acc：加权和，计算后为激活值
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    __attribute__((target("avx2")))
+    static void applyAVX2(const PanelActivation& activation, const int32_t* codes, __m256d (&acc)[2]) {
+        if (activation.uReluLanes != 0) {
+            const __m256d zero = _mm256_setzero_pd();
+            for (int iVec = 0; iVec < 2; ++iVec) {
+                int iBits = activation.uReluLanes >> (4 * iVec);
+                __m256d select = _mm256_castsi256_pd(_mm256_set_epi64x(
+                    -static_cast<int64_t>((iBits >> 3) & 1), -static_cast<int64_t>((iBits >> 2) & 1),
+                    -static_cast<int64_t>((iBits >> 1) & 1), -static_cast<int64_t>(iBits & 1)));
+                acc[iVec] = _mm256_blendv_pd(acc[iVec], _mm256_max_pd(acc[iVec], zero), select);
+            }
+        }
+        if (activation.uScalarLanes != 0) {
+            double lanes[KernelDispatch::PANEL_WIDTH];
+            _mm256_storeu_pd(lanes, acc[0]);
+            _mm256_storeu_pd(lanes + 4, acc[1]);
+            applyLanes(activation.uScalarLanes, codes, lanes);
+            acc[0] = _mm256_loadu_pd(lanes);
+            acc[1] = _mm256_loadu_pd(lanes + 4);
+        }
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】applyAVX512
+    //【函数功能】对1个zmm寄存器中的一个面板计算激活值
+    //【参数】activation：面板分类，codes：激活函数代码，acc：加权和，计算后为激活值
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    __attribute__((target("avx512f")))
+    static void applyAVX512(const PanelActivation& activation, const int32_t* codes, __m512d& acc) {
+        if (activation.uReluLanes != 0) {
+            acc = _mm512_mask_max_pd(acc, static_cast<__mmask8>(activation.uReluLanes), acc, _mm512_setzero_pd());
+        }
+        if (activation.uScalarLanes != 0) {
+            double lanes[KernelDispatch::PANEL_WIDTH];
+            _mm512_storeu_pd(lanes, acc);
+            applyLanes(activation.uScalarLanes, codes, lanes);
+            acc = _mm512_loadu_pd(lanes);
+        }
+    }
+#endif // ANN_KERNEL_DISPATCH
+};
+
+#endif // FusedActivation_hpp
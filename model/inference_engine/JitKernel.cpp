@@ -0,0 +1,460 @@
+//-------------------------------------------------------------
+//【文件名】JitKernel.cpp
+//【功能模块和目的】为单个编译网络生成x86-64机器码的即时编译内核实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "JitKernel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define ANN_JIT_AVAILABLE 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef ANN_JIT_AVAILABLE
+
+//-------------------------------------------------------------
+//【函数名称】jitSigmoid / jitTanh
+//【函数功能】供生成代码调用的激活函数，与CompiledLayer::applyActivation共用实现
+//【参数】x：加权和
+//【返回值】double，激活值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+static double jitSigmoid(double x) {
+    return CompiledLayer::applyActivation(1, x);
+}
+
+static double jitTanh(double x) {
+    return CompiledLayer::applyActivation(2, x);
+}
+
+// Neurons accumulated together in xmm0..xmm3, two per register
+static const int64_t GROUP_SIZE = 8;
+
+//-------------------------------------------------------------
+//【类名】CodeBuffer
+//【功能】按字节拼接x86-64指令
+//【说明】寄存器约定：rbx 本层输入，r12 本层输出，r13 临时缓冲区，r14 最终输出，r15 常量池，
+//       均为被调用者保存寄存器，调用激活函数后仍然有效；xmm0~xmm3 为累加器，xmm8 为广播的输入，xmm9 为乘积
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class CodeBuffer {
+private:
+    vector<uint8_t> m_bytes;  // Encoded instructions
+
+public:
+    void emit(initializer_list<uint8_t> bytes) {
+        m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+    }
+
+    void emit32(int32_t value) {
+        uint8_t raw[4];
+        memcpy(raw, &value, sizeof(raw));
+        m_bytes.insert(m_bytes.end(), raw, raw + sizeof(raw));
+    }
+
+    void emit64(uint64_t value) {
+        uint8_t raw[8];
+        memcpy(raw, &value, sizeof(raw));
+        m_bytes.insert(m_bytes.end(), raw, raw + sizeof(raw));
+    }
+
+    void reserve(size_t bytes) {
+        m_bytes.reserve(bytes);
+    }
+
+    // movsd xmm0, [r15 + disp32]
+    void loadConstantToSum(int32_t offset) {
+        emit({0xF2, 0x41, 0x0F, 0x10, 0x87});
+        emit32(offset);
+    }
+
+    // movsd xmm1, [rbx + disp32]
+    void loadInput(int32_t offset) {
+        emit({0xF2, 0x0F, 0x10, 0x8B});
+        emit32(offset);
+    }
+
+    // mulsd xmm1, [r15 + disp32]
+    void multiplyByConstant(int32_t offset) {
+        emit({0xF2, 0x41, 0x0F, 0x59, 0x8F});
+        emit32(offset);
+    }
+
+    // addsd xmm0, xmm1
+    void accumulate() {
+        emit({0xF2, 0x0F, 0x58, 0xC1});
+    }
+
+    // movupd xmm<sum>, [r15 + disp32] -- two biases start two accumulators
+    void loadConstantPair(int sum, int32_t offset) {
+        emit({0x66, 0x41, 0x0F, 0x10, static_cast<uint8_t>(0x87 | (sum << 3))});
+        emit32(offset);
+    }
+
+    // movsd xmm8, [rbx + disp32]; unpcklpd xmm8, xmm8 -- one input in both lanes
+    void broadcastInput(int32_t offset) {
+        emit({0xF2, 0x44, 0x0F, 0x10, 0x83});
+        emit32(offset);
+        emit({0x66, 0x45, 0x0F, 0x14, 0xC0});
+    }
+
+    // movupd xmm9, [r15 + disp32]; mulpd xmm9, xmm8; addpd xmm<sum>, xmm9
+    void accumulatePair(int sum, int32_t offset) {
+        emit({0x66, 0x45, 0x0F, 0x10, 0x8F});
+        emit32(offset);
+        emit({0x66, 0x45, 0x0F, 0x59, 0xC8});
+        emit({0x66, 0x41, 0x0F, 0x58, static_cast<uint8_t>(0xC1 | (sum << 3))});
+    }
+
+    // movlpd / movhpd [r12 + disp32], xmm<sum> -- store one lane
+    void storeLane(int sum, bool high, int32_t offset) {
+        emit({0x66, 0x41, 0x0F, static_cast<uint8_t>(high ? 0x17 : 0x13),
+              static_cast<uint8_t>(0x84 | (sum << 3)), 0x24});
+        emit32(offset);
+    }
+
+    // movsd xmm0, [r12 + disp32]
+    void loadOutput(int32_t offset) {
+        emit({0xF2, 0x41, 0x0F, 0x10, 0x84, 0x24});
+        emit32(offset);
+    }
+
+    // xorpd xmm2, xmm2; maxsd xmm0, xmm2 -- same result as max(0.0, x), including NaN and -0.0
+    void applyReLU() {
+        emit({0x66, 0x0F, 0x57, 0xD2});
+        emit({0xF2, 0x0F, 0x5F, 0xC2});
+    }
+
+    // mov rax, imm64; call rax -- argument and result in xmm0
+    void callFunction(double (*function)(double)) {
+        emit({0x48, 0xB8});
+        emit64(reinterpret_cast<uint64_t>(function));
+        emit({0xFF, 0xD0});
+    }
+
+    // movsd [r12 + disp32], xmm0
+    void storeOutput(int32_t offset) {
+        emit({0xF2, 0x41, 0x0F, 0x11, 0x84, 0x24});
+        emit32(offset);
+    }
+
+    // Activation of xmm0 by code; linear emits nothing
+    void applyActivation(int32_t code) {
+        switch (code) {
+            case 1:
+                callFunction(jitSigmoid);
+                break;
+            case 2:
+                callFunction(jitTanh);
+                break;
+            case 3:
+                applyReLU();
+                break;
+            default:
+                break;
+        }
+    }
+
+    const vector<uint8_t>& getBytes() const {
+        return m_bytes;
+    }
+};
+
+#endif // ANN_JIT_AVAILABLE
+
+//-------------------------------------------------------------
+//【函数名称】JitKernel
+//【函数功能】默认构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+JitKernel::JitKernel()
+    : m_pCode(nullptr), m_uCodeBytes(0), m_entry(nullptr),
+      m_iInputSize(0), m_iOutputSize(0), m_iScratchSize(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~JitKernel
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+JitKernel::~JitKernel() {
+    release();
+}
+
+//-------------------------------------------------------------
+//【函数名称】release
+//【函数功能】释放可执行内存并清空状态
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void JitKernel::release() {
+#ifdef ANN_JIT_AVAILABLE
+    if (m_pCode) {
+        munmap(m_pCode, m_uCodeBytes);
+    }
+#endif
+    m_pCode = nullptr;
+    m_uCodeBytes = 0;
+    m_entry = nullptr;
+    m_constants.clear();
+    m_iInputSize = 0;
+    m_iOutputSize = 0;
+    m_iScratchSize = 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】compile
+//【函数功能】为给定的各层生成机器码
+//【参数】layers：编译后的层
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool JitKernel::compile(const vector<CompiledLayer>& layers) {
+    release();
+#ifdef ANN_JIT_AVAILABLE
+    if (layers.empty()) {
+        return false;
+    }
+    int64_t iTotalWeights = 0;
+    int64_t iMaxWidth = 0;
+    for (const CompiledLayer& layer : layers) {
+        iTotalWeights += static_cast<int64_t>(layer.getWeights().size());
+        iMaxWidth = max(iMaxWidth, layer.getWidth());
+    }
+    if (iTotalWeights > MAX_WEIGHTS) {
+        return false;
+    }
+
+    // Constant pool: per layer and neuron group the biases, then the weights input by input
+    vector<double> constants;
+    CodeBuffer code;
+    code.reserve(static_cast<size_t>(iTotalWeights) * 24 + static_cast<size_t>(iMaxWidth) * layers.size() * 32 + 64);
+
+    // Prologue: save callee-saved registers (also aligns rsp to 16 for calls)
+    code.emit({0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57});
+    code.emit({0x48, 0x89, 0xFB});  // mov rbx, rdi   (inputs)
+    code.emit({0x49, 0x89, 0xF6});  // mov r14, rsi   (outputs)
+    code.emit({0x49, 0x89, 0xD5});  // mov r13, rdx   (scratch)
+    size_t uPoolImmediate = code.getBytes().size() + 2;
+    code.emit({0x49, 0xBF});        // mov r15, imm64 (constant pool, patched below)
+    code.emit64(0);
+
+    for (size_t uLayerIdx = 0; uLayerIdx < layers.size(); ++uLayerIdx) {
+        const CompiledLayer& layer = layers[uLayerIdx];
+        const int64_t iWidth = layer.getWidth();
+        const int64_t iInputWidth = layer.getInputWidth();
+        const int32_t iBiasBase = static_cast<int32_t>(constants.size() * sizeof(double));
+
+        // Destination: caller's output for the last layer, else alternating scratch halves
+        if (uLayerIdx + 1 == layers.size()) {
+            code.emit({0x4D, 0x89, 0xF4});  // mov r12, r14
+        } else {
+            code.emit({0x4D, 0x8D, 0xA5});  // lea r12, [r13 + disp32]
+            code.emit32(static_cast<int32_t>((uLayerIdx % 2) * iMaxWidth * sizeof(double)));
+        }
+
+        if (layer.isElementwise()) {
+            // Input layer: one product per neuron
+            constants.insert(constants.end(), layer.getBiases().begin(), layer.getBiases().end());
+            constants.insert(constants.end(), layer.getWeights().begin(), layer.getWeights().end());
+            const int32_t iWeightBase = iBiasBase + static_cast<int32_t>(iWidth * sizeof(double));
+            for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+                int32_t iOffset = static_cast<int32_t>(iNeuronIdx * sizeof(double));
+                code.loadConstantToSum(iBiasBase + iOffset);
+                code.loadInput(iOffset);
+                code.multiplyByConstant(iWeightBase + iOffset);
+                code.accumulate();
+                code.applyActivation(layer.getActivationCodes()[iNeuronIdx]);
+                code.storeOutput(iOffset);
+            }
+        } else {
+            // GROUP_SIZE neurons at a time in GROUP_SIZE/2 packed accumulators. Each lane still
+            // adds bias, then input 0, 1, ... in order, so every neuron's sum is unchanged; the
+            // independent accumulators only hide the add latency. Padded lanes are never stored.
+            for (int64_t iFirst = 0; iFirst < iWidth; iFirst += GROUP_SIZE) {
+                const int64_t iLanes = min<int64_t>(GROUP_SIZE, iWidth - iFirst);
+                const int iSums = static_cast<int>((iLanes + 1) / 2);
+                const int32_t iGroupBase = static_cast<int32_t>(constants.size() * sizeof(double));
+                for (int64_t iLane = 0; iLane < GROUP_SIZE; ++iLane) {
+                    constants.push_back(iLane < iLanes ? layer.getBiases()[iFirst + iLane] : 0.0);
+                }
+                for (int64_t iInputIdx = 0; iInputIdx < iInputWidth; ++iInputIdx) {
+                    for (int64_t iLane = 0; iLane < GROUP_SIZE; ++iLane) {
+                        constants.push_back(iLane < iLanes ?
+                            layer.getWeights()[(iFirst + iLane) * iInputWidth + iInputIdx] : 0.0);
+                    }
+                }
+
+                for (int iSum = 0; iSum < iSums; ++iSum) {
+                    code.loadConstantPair(iSum, iGroupBase + static_cast<int32_t>(iSum * 2 * sizeof(double)));
+                }
+                for (int64_t iInputIdx = 0; iInputIdx < iInputWidth; ++iInputIdx) {
+                    code.broadcastInput(static_cast<int32_t>(iInputIdx * sizeof(double)));
+                    int32_t iRowBase = iGroupBase + static_cast<int32_t>((1 + iInputIdx) * GROUP_SIZE * sizeof(double));
+                    for (int iSum = 0; iSum < iSums; ++iSum) {
+                        code.accumulatePair(iSum, iRowBase + static_cast<int32_t>(iSum * 2 * sizeof(double)));
+                    }
+                }
+                for (int64_t iLane = 0; iLane < iLanes; ++iLane) {
+                    code.storeLane(static_cast<int>(iLane / 2), iLane % 2 == 1,
+                                   static_cast<int32_t>((iFirst + iLane) * sizeof(double)));
+                }
+                // Activations in place; only non-linear neurons are revisited
+                for (int64_t iLane = 0; iLane < iLanes; ++iLane) {
+                    int32_t iCode = layer.getActivationCodes()[iFirst + iLane];
+                    if (iCode != 0) {
+                        int32_t iOffset = static_cast<int32_t>((iFirst + iLane) * sizeof(double));
+                        code.loadOutput(iOffset);
+                        code.applyActivation(iCode);
+                        code.storeOutput(iOffset);
+                    }
+                }
+            }
+        }
+
+        code.emit({0x4C, 0x89, 0xE3});  // mov rbx, r12 (next layer reads this one)
+    }
+
+    // Epilogue
+    code.emit({0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3});
+
+    // The pool must not move once its address is baked into the code
+    m_constants.swap(constants);
+    vector<uint8_t> bytes = code.getBytes();
+    uint64_t uPoolAddress = reinterpret_cast<uint64_t>(m_constants.data());
+    memcpy(bytes.data() + uPoolImmediate, &uPoolAddress, sizeof(uPoolAddress));
+
+    size_t uPage = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t uMapped = (bytes.size() + uPage - 1) / uPage * uPage;
+    void* pMemory = mmap(nullptr, uMapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pMemory == MAP_FAILED) {
+        m_constants.clear();
+        return false;
+    }
+    memcpy(pMemory, bytes.data(), bytes.size());
+    // Never writable and executable at the same time
+    if (mprotect(pMemory, uMapped, PROT_READ | PROT_EXEC) != 0) {
+        munmap(pMemory, uMapped);
+        m_constants.clear();
+        return false;
+    }
+
+    m_pCode = pMemory;
+    m_uCodeBytes = uMapped;
+    m_entry = reinterpret_cast<EntryPoint>(pMemory);
+    m_iInputSize = layers.front().getWidth();
+    m_iOutputSize = layers.back().getWidth();
+    m_iScratchSize = layers.size() > 1 ? 2 * iMaxWidth : 0;
+    return true;
+#else
+    (void)layers;
+    return false;
+#endif
+}
+
+//-------------------------------------------------------------
+//【函数名称】isReady
+//【函数功能】判断是否已生成可执行代码
+//【参数】无
+//【返回值】bool，已生成返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool JitKernel::isReady() const {
+    return m_entry != nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】run
+//【函数功能】执行生成的代码
+//【参数】inputs：输入，outputs：输出，scratch：临时缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void JitKernel::run(const double* inputs, double* outputs, double* scratch) const {
+    m_entry(inputs, outputs, scratch);
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取输入长度
+//【参数】无
+//【返回值】int64_t，输入长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t JitKernel::getInputSize() const {
+    return m_iInputSize;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOutputSize
+//【函数功能】获取输出长度
+//【参数】无
+//【返回值】int64_t，输出长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t JitKernel::getOutputSize() const {
+    return m_iOutputSize;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getScratchSize
+//【函数功能】获取run所需临时缓冲区的double个数
+//【参数】无
+//【返回值】int64_t，个数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t JitKernel::getScratchSize() const {
+    return m_iScratchSize;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getCodeBytes
+//【函数功能】获取生成的机器码所占字节数
+//【参数】无
+//【返回值】size_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+size_t JitKernel::getCodeBytes() const {
+    return m_uCodeBytes;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isSupported
+//【函数功能】判断当前平台是否支持即时编译
+//【参数】无
+//【返回值】bool，是否支持
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool JitKernel::isSupported() {
+#ifdef ANN_JIT_AVAILABLE
+    return true;
+#else
+    return false;
+#endif
+}
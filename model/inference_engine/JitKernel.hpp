@@ -0,0 +1,177 @@
+//-------------------------------------------------------------
+//【文件名】JitKernel.hpp
+//【功能模块和目的】为单个编译网络生成x86-64机器码的即时编译内核声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef JitKernel_hpp
+#define JitKernel_hpp
+
+#include "CompiledLayer.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】JitKernel
+//【功能】把整张网络展开为一段机器码：每个神经元、每个权重各对应固定的指令，
+//       偏置和权重按固定偏移从常量池读取，线性和ReLU激活内联，Sigmoid和Tanh调用共享实现
+//【说明】仅在Linux x86-64上可用（mmap得到可写内存，写入后改为只读可执行），其他平台compile返回false。
+//       只使用SSE2指令，每8个神经元在打包累加器中同时求和，各神经元仍按与CompiledLayer::forward相同的顺序累加，不做乘加融合，
+//       因此结果与Network::predict逐位一致。权重总数超过MAX_WEIGHTS时不生成代码。
+//       生成后代码与常量池只读，run可在多个线程中同时调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class JitKernel {
+public:
+    static const int64_t MAX_WEIGHTS = 1 << 20;  // 展开的权重数上限
+
+private:
+    typedef void (*EntryPoint)(const double* inputs, double* outputs, double* scratch);
+
+    void* m_pCode;             // Executable mapping, null until compiled
+    size_t m_uCodeBytes;       // Size of the mapping
+    EntryPoint m_entry;        // Start of the generated function
+    vector<double> m_constants;// Biases and weights addressed by fixed offsets
+    int64_t m_iInputSize;      // Width of the first layer
+    int64_t m_iOutputSize;     // Width of the last layer
+    int64_t m_iScratchSize;    // Doubles of scratch run() needs
+
+    //-------------------------------------------------------------
+    //【函数名称】release
+    //【函数功能】释放可执行内存并清空状态
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void release();
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】JitKernel
+    //【函数功能】默认构造函数，创建未编译的内核
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    JitKernel();
+
+    //-------------------------------------------------------------
+    //【函数名称】JitKernel（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，内核独占可执行内存）
+    //【参数】other：被拷贝的内核
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    JitKernel(const JitKernel& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源内核
+    //【返回值】JitKernel&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    JitKernel& operator=(const JitKernel& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~JitKernel
+    //【函数功能】析构函数，释放可执行内存
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~JitKernel();
+
+    //-------------------------------------------------------------
+    //【函数名称】compile
+    //【函数功能】为给定的各层生成机器码
+    //【参数】layers：编译后的层（第0层为逐元素输入层）
+    //【返回值】bool，生成成功返回true；平台不支持、权重过多或内存映射失败时返回false
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool compile(const vector<CompiledLayer>& layers);
+
+    //-------------------------------------------------------------
+    //【函数名称】isReady
+    //【函数功能】判断是否已生成可执行代码
+    //【参数】无
+    //【返回值】bool，已生成返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isReady() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】run
+    //【函数功能】执行生成的代码
+    //【参数】inputs：getInputSize()个输入，outputs：getOutputSize()个输出，
+    //       scratch：getScratchSize()个double的临时缓冲区（每个线程各自提供）
+    //【返回值】无；调用前须确认isReady()
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void run(const double* inputs, double* outputs, double* scratch) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取输入长度
+    //【参数】无
+    //【返回值】int64_t，输入长度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getOutputSize
+    //【函数功能】获取输出长度
+    //【参数】无
+    //【返回值】int64_t，输出长度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getOutputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getScratchSize
+    //【函数功能】获取run所需临时缓冲区的double个数
+    //【参数】无
+    //【返回值】int64_t，个数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getScratchSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getCodeBytes
+    //【函数功能】获取生成的机器码所占字节数（按页对齐）
+    //【参数】无
+    //【返回值】size_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    size_t getCodeBytes() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】isSupported
+    //【函数功能】判断当前平台是否支持即时编译
+    //【参数】无
+    //【返回值】bool，Linux x86-64返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool isSupported();
+};
+
+#endif // JitKernel_hpp
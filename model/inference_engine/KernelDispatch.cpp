@@ -0,0 +1,928 @@
+//-------------------------------------------------------------
+//【文件名】KernelDispatch.cpp
+//【功能模块和目的】按运行时CPU特性选择稠密层内核的指令集版本实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 稠密内核在写回前融合激活函数
+//           2026-10-18 增加axpy内核
+//           2026-10-18 增加优化器的融合更新内核
+//-------------------------------------------------------------
+
+#include "KernelDispatch.hpp"
+#include "CompiledLayer.hpp"
+#include "FusedActivation.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <cmath>
+
+#ifdef ANN_KERNEL_DISPATCH
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const int64_t LANES = KernelDispatch::PANEL_WIDTH;
+
+// Neurons of a panel, then for each input one weight per neuron
+inline const double* panelAt(const double* panels, int64_t panelIdx, int64_t inputWidth) {
+    return panels + panelIdx * (1 + inputWidth) * LANES;
+}
+
+// Copies the valid lanes of a computed panel; the padded ones are discarded
+inline void storePanel(const double* lanes, int64_t first, int64_t width, double* sums) {
+    int64_t iCount = min<int64_t>(LANES, width - first);
+    for (int64_t iLane = 0; iLane < iCount; ++iLane) {
+        sums[first + iLane] = lanes[iLane];
+    }
+}
+
+// Every dense kernel finishes a panel in registers: activations (when given) are applied
+// before the single store, so the outputs are written once per layer
+void denseScalar(const double* panels, const PanelActivation* activations, const int32_t* codes,
+                 int64_t width, int64_t inputWidth, const double* inputs, double* outputs) {
+    double lanes[LANES];
+    for (int64_t iFirst = 0, iPanel = 0; iFirst < width; iFirst += LANES, ++iPanel) {
+        const double* pPanel = panelAt(panels, iPanel, inputWidth);
+        for (int64_t iLane = 0; iLane < LANES; ++iLane) {
+            double rSum = pPanel[iLane];
+            for (int64_t iInputIdx = 0; iInputIdx < inputWidth; ++iInputIdx) {
+                rSum += inputs[iInputIdx] * pPanel[(1 + iInputIdx) * LANES + iLane];
+            }
+            lanes[iLane] = rSum;
+        }
+        if (activations) {
+            const PanelActivation& activation = activations[iPanel];
+            FusedActivation::applyLanes(activation.uReluLanes | activation.uScalarLanes, codes + iFirst, lanes);
+        }
+        storePanel(lanes, iFirst, width, outputs);
+    }
+}
+
+void activateScalar(const int32_t* codes, int64_t first, int64_t last, double* values) {
+    for (int64_t iIdx = first; iIdx < last; ++iIdx) {
+        values[iIdx] = CompiledLayer::applyActivation(codes[iIdx], values[iIdx]);
+    }
+}
+
+// A block of `count` neurons that are all ReLU can use one vector max
+inline bool isReLUBlock(const int32_t* codes, int64_t first, int64_t count) {
+    for (int64_t iIdx = first; iIdx < first + count; ++iIdx) {
+        if (codes[iIdx] != 3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void axpyScalar(int64_t first, int64_t count, double alpha, const double* x, double* y) {
+    for (int64_t iIdx = first; iIdx < count; ++iIdx) {
+        y[iIdx] += alpha * x[iIdx];
+    }
+}
+
+// The optimizer updates: every vector version evaluates these expressions in the same order
+void momentumScalar(int64_t first, int64_t count, double learningRate, double momentum,
+                    const double* gradients, double* velocity, double* parameters) {
+    for (int64_t iIdx = first; iIdx < count; ++iIdx) {
+        velocity[iIdx] = momentum * velocity[iIdx] + gradients[iIdx];
+        parameters[iIdx] += -learningRate * velocity[iIdx];
+    }
+}
+
+void rmsPropScalar(int64_t first, int64_t count, double learningRate, double decay, double epsilon,
+                   const double* gradients, double* meanSquares, double* parameters) {
+    for (int64_t iIdx = first; iIdx < count; ++iIdx) {
+        const double rGradient = gradients[iIdx];
+        meanSquares[iIdx] = decay * meanSquares[iIdx] + (1.0 - decay) * (rGradient * rGradient);
+        parameters[iIdx] -= learningRate * rGradient / (sqrt(meanSquares[iIdx]) + epsilon);
+    }
+}
+
+void adamScalar(int64_t first, int64_t count, double stepSize, double beta1, double beta2, double epsilon,
+                const double* gradients, double* firstMoments, double* secondMoments, double* parameters) {
+    for (int64_t iIdx = first; iIdx < count; ++iIdx) {
+        const double rGradient = gradients[iIdx];
+        firstMoments[iIdx] = beta1 * firstMoments[iIdx] + (1.0 - beta1) * rGradient;
+        secondMoments[iIdx] = beta2 * secondMoments[iIdx] + (1.0 - beta2) * (rGradient * rGradient);
+        parameters[iIdx] -= stepSize * firstMoments[iIdx] / (sqrt(secondMoments[iIdx]) + epsilon);
+    }
+}
+
+#ifdef ANN_KERNEL_DISPATCH
+
+// xgetbv with ecx = 0: which register states the OS saves on context switch
+uint64_t readXcr0() {
+    uint32_t uLow = 0;
+    uint32_t uHigh = 0;
+    __asm__ volatile("xgetbv" : "=a"(uLow), "=d"(uHigh) : "c"(0));
+    return (static_cast<uint64_t>(uHigh) << 32) | uLow;
+}
+
+// Each lane: bias, then + input * weight for every input in order; mul and add stay separate
+void denseSSE2(const double* panels, const PanelActivation* activations, const int32_t* codes,
+               int64_t width, int64_t inputWidth, const double* inputs, double* outputs) {
+    double lanes[LANES];
+    for (int64_t iFirst = 0, iPanel = 0; iFirst < width; iFirst += LANES, ++iPanel) {
+        const double* pPanel = panelAt(panels, iPanel, inputWidth);
+        __m128d sum[4] = {_mm_loadu_pd(pPanel), _mm_loadu_pd(pPanel + 2),
+                          _mm_loadu_pd(pPanel + 4), _mm_loadu_pd(pPanel + 6)};
+        const double* pWeights = pPanel + LANES;
+        for (int64_t iInputIdx = 0; iInputIdx < inputWidth; ++iInputIdx, pWeights += LANES) {
+            __m128d input = _mm_set1_pd(inputs[iInputIdx]);
+            __m128d product0 = _mm_mul_pd(input, _mm_loadu_pd(pWeights));
+            __m128d product1 = _mm_mul_pd(input, _mm_loadu_pd(pWeights + 2));
+            __m128d product2 = _mm_mul_pd(input, _mm_loadu_pd(pWeights + 4));
+            __m128d product3 = _mm_mul_pd(input, _mm_loadu_pd(pWeights + 6));
+            ANN_KEEP_PRODUCT(product0);
+            ANN_KEEP_PRODUCT(product1);
+            ANN_KEEP_PRODUCT(product2);
+            ANN_KEEP_PRODUCT(product3);
+            sum[0] = _mm_add_pd(sum[0], product0);
+            sum[1] = _mm_add_pd(sum[1], product1);
+            sum[2] = _mm_add_pd(sum[2], product2);
+            sum[3] = _mm_add_pd(sum[3], product3);
+        }
+        if (activations) {
+            FusedActivation::applySSE2(activations[iPanel], codes + iFirst, sum);
+        }
+        if (iFirst + LANES <= width) {
+            _mm_storeu_pd(outputs + iFirst, sum[0]);
+            _mm_storeu_pd(outputs + iFirst + 2, sum[1]);
+            _mm_storeu_pd(outputs + iFirst + 4, sum[2]);
+            _mm_storeu_pd(outputs + iFirst + 6, sum[3]);
+        } else {
+            _mm_storeu_pd(lanes, sum[0]);
+            _mm_storeu_pd(lanes + 2, sum[1]);
+            _mm_storeu_pd(lanes + 4, sum[2]);
+            _mm_storeu_pd(lanes + 6, sum[3]);
+            storePanel(lanes, iFirst, width, outputs);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void denseAVX2(const double* panels, const PanelActivation* activations, const int32_t* codes,
+               int64_t width, int64_t inputWidth, const double* inputs, double* outputs) {
+    double lanes[LANES];
+    for (int64_t iFirst = 0, iPanel = 0; iFirst < width; iFirst += LANES, ++iPanel) {
+        const double* pPanel = panelAt(panels, iPanel, inputWidth);
+        __m256d sum[2] = {_mm256_loadu_pd(pPanel), _mm256_loadu_pd(pPanel + 4)};
+        const double* pWeights = pPanel + LANES;
+        for (int64_t iInputIdx = 0; iInputIdx < inputWidth; ++iInputIdx, pWeights += LANES) {
+            __m256d input = _mm256_set1_pd(inputs[iInputIdx]);
+            __m256d product0 = _mm256_mul_pd(input, _mm256_loadu_pd(pWeights));
+            __m256d product1 = _mm256_mul_pd(input, _mm256_loadu_pd(pWeights + 4));
+            ANN_KEEP_PRODUCT(product0);
+            ANN_KEEP_PRODUCT(product1);
+            sum[0] = _mm256_add_pd(sum[0], product0);
+            sum[1] = _mm256_add_pd(sum[1], product1);
+        }
+        if (activations) {
+            FusedActivation::applyAVX2(activations[iPanel], codes + iFirst, sum);
+        }
+        if (iFirst + LANES <= width) {
+            _mm256_storeu_pd(outputs + iFirst, sum[0]);
+            _mm256_storeu_pd(outputs + iFirst + 4, sum[1]);
+        } else {
+            _mm256_storeu_pd(lanes, sum[0]);
+            _mm256_storeu_pd(lanes + 4, sum[1]);
+            storePanel(lanes, iFirst, width, outputs);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+void denseAVX512(const double* panels, const PanelActivation* activations, const int32_t* codes,
+                 int64_t width, int64_t inputWidth, const double* inputs, double* outputs) {
+    for (int64_t iFirst = 0, iPanel = 0; iFirst < width; iFirst += LANES, ++iPanel) {
+        const double* pPanel = panelAt(panels, iPanel, inputWidth);
+        __m512d sum = _mm512_loadu_pd(pPanel);
+        const double* pWeights = pPanel + LANES;
+        for (int64_t iInputIdx = 0; iInputIdx < inputWidth; ++iInputIdx, pWeights += LANES) {
+            __m512d product = _mm512_mul_pd(_mm512_set1_pd(inputs[iInputIdx]), _mm512_loadu_pd(pWeights));
+            ANN_KEEP_PRODUCT(product);
+            sum = _mm512_add_pd(sum, product);
+        }
+        if (activations) {
+            FusedActivation::applyAVX512(activations[iPanel], codes + iFirst, sum);
+        }
+        int64_t iCount = min<int64_t>(LANES, width - iFirst);
+        _mm512_mask_storeu_pd(outputs + iFirst, static_cast<__mmask8>((1u << iCount) - 1), sum);
+    }
+}
+
+// maxpd(x, 0) returns the second operand for NaN and for -0.0, exactly like max(0.0, x)
+void activateSSE2(const int32_t* codes, int64_t width, double* values) {
+    const __m128d zero = _mm_setzero_pd();
+    int64_t iIdx = 0;
+    for (; iIdx + 2 <= width; iIdx += 2) {
+        if (isReLUBlock(codes, iIdx, 2)) {
+            _mm_storeu_pd(values + iIdx, _mm_max_pd(_mm_loadu_pd(values + iIdx), zero));
+        } else {
+            activateScalar(codes, iIdx, iIdx + 2, values);
+        }
+    }
+    activateScalar(codes, iIdx, width, values);
+}
+
+__attribute__((target("avx2")))
+void activateAVX2(const int32_t* codes, int64_t width, double* values) {
+    const __m256d zero = _mm256_setzero_pd();
+    int64_t iIdx = 0;
+    for (; iIdx + 4 <= width; iIdx += 4) {
+        if (isReLUBlock(codes, iIdx, 4)) {
+            _mm256_storeu_pd(values + iIdx, _mm256_max_pd(_mm256_loadu_pd(values + iIdx), zero));
+        } else {
+            activateScalar(codes, iIdx, iIdx + 4, values);
+        }
+    }
+    activateScalar(codes, iIdx, width, values);
+}
+
+__attribute__((target("avx512f")))
+void activateAVX512(const int32_t* codes, int64_t width, double* values) {
+    const __m512d zero = _mm512_setzero_pd();
+    int64_t iIdx = 0;
+    for (; iIdx + 8 <= width; iIdx += 8) {
+        if (isReLUBlock(codes, iIdx, 8)) {
+            // maskz form: _mm512_max_pd trips a GCC 12 -Wmaybe-uninitialized false positive
+            _mm512_storeu_pd(values + iIdx, _mm512_maskz_max_pd(0xFF, _mm512_loadu_pd(values + iIdx), zero));
+        } else {
+            activateScalar(codes, iIdx, iIdx + 8, values);
+        }
+    }
+    activateScalar(codes, iIdx, width, values);
+}
+
+void axpySSE2(int64_t count, double alpha, const double* x, double* y) {
+    const __m128d scale = _mm_set1_pd(alpha);
+    int64_t iIdx = 0;
+    for (; iIdx + 4 <= count; iIdx += 4) {
+        __m128d product0 = _mm_mul_pd(scale, _mm_loadu_pd(x + iIdx));
+        __m128d product1 = _mm_mul_pd(scale, _mm_loadu_pd(x + iIdx + 2));
+        ANN_KEEP_PRODUCT(product0);
+        ANN_KEEP_PRODUCT(product1);
+        _mm_storeu_pd(y + iIdx, _mm_add_pd(_mm_loadu_pd(y + iIdx), product0));
+        _mm_storeu_pd(y + iIdx + 2, _mm_add_pd(_mm_loadu_pd(y + iIdx + 2), product1));
+    }
+    axpyScalar(iIdx, count, alpha, x, y);
+}
+
+__attribute__((target("avx2")))
+void axpyAVX2(int64_t count, double alpha, const double* x, double* y) {
+    const __m256d scale = _mm256_set1_pd(alpha);
+    int64_t iIdx = 0;
+    for (; iIdx + 8 <= count; iIdx += 8) {
+        __m256d product0 = _mm256_mul_pd(scale, _mm256_loadu_pd(x + iIdx));
+        __m256d product1 = _mm256_mul_pd(scale, _mm256_loadu_pd(x + iIdx + 4));
+        ANN_KEEP_PRODUCT(product0);
+        ANN_KEEP_PRODUCT(product1);
+        _mm256_storeu_pd(y + iIdx, _mm256_add_pd(_mm256_loadu_pd(y + iIdx), product0));
+        _mm256_storeu_pd(y + iIdx + 4, _mm256_add_pd(_mm256_loadu_pd(y + iIdx + 4), product1));
+    }
+    axpyScalar(iIdx, count, alpha, x, y);
+}
+
+__attribute__((target("avx512f")))
+void axpyAVX512(int64_t count, double alpha, const double* x, double* y) {
+    const __m512d scale = _mm512_set1_pd(alpha);
+    int64_t iIdx = 0;
+    for (; iIdx < count; iIdx += 8) {
+        // The tail is a masked load/store, so every element goes through the same instructions
+        __mmask8 uMask = static_cast<__mmask8>(count - iIdx >= 8 ? 0xFF : (1u << (count - iIdx)) - 1);
+        __m512d product = _mm512_mul_pd(scale, _mm512_maskz_loadu_pd(uMask, x + iIdx));
+        ANN_KEEP_PRODUCT(product);
+        _mm512_mask_storeu_pd(y + iIdx, uMask, _mm512_add_pd(_mm512_maskz_loadu_pd(uMask, y + iIdx), product));
+    }
+}
+
+void momentumSSE2(int64_t count, double learningRate, double momentum,
+                  const double* gradients, double* velocity, double* parameters) {
+    const __m128d mu = _mm_set1_pd(momentum);
+    const __m128d step = _mm_set1_pd(-learningRate);
+    int64_t iIdx = 0;
+    for (; iIdx + 2 <= count; iIdx += 2) {
+        __m128d decayed = _mm_mul_pd(mu, _mm_loadu_pd(velocity + iIdx));
+        ANN_KEEP_PRODUCT(decayed);
+        __m128d updated = _mm_add_pd(decayed, _mm_loadu_pd(gradients + iIdx));
+        __m128d change = _mm_mul_pd(step, updated);
+        ANN_KEEP_PRODUCT(change);
+        _mm_storeu_pd(velocity + iIdx, updated);
+        _mm_storeu_pd(parameters + iIdx, _mm_add_pd(_mm_loadu_pd(parameters + iIdx), change));
+    }
+    momentumScalar(iIdx, count, learningRate, momentum, gradients, velocity, parameters);
+}
+
+void rmsPropSSE2(int64_t count, double learningRate, double decay, double epsilon,
+                 const double* gradients, double* meanSquares, double* parameters) {
+    const __m128d rho = _mm_set1_pd(decay);
+    const __m128d rest = _mm_set1_pd(1.0 - decay);
+    const __m128d rate = _mm_set1_pd(learningRate);
+    const __m128d eps = _mm_set1_pd(epsilon);
+    int64_t iIdx = 0;
+    for (; iIdx + 2 <= count; iIdx += 2) {
+        __m128d gradient = _mm_loadu_pd(gradients + iIdx);
+        __m128d decayed = _mm_mul_pd(rho, _mm_loadu_pd(meanSquares + iIdx));
+        __m128d square = _mm_mul_pd(rest, _mm_mul_pd(gradient, gradient));
+        __m128d scaled = _mm_mul_pd(rate, gradient);
+        ANN_KEEP_PRODUCT(decayed);
+        ANN_KEEP_PRODUCT(square);
+        __m128d meanSquare = _mm_add_pd(decayed, square);
+        _mm_storeu_pd(meanSquares + iIdx, meanSquare);
+        __m128d change = _mm_div_pd(scaled, _mm_add_pd(_mm_sqrt_pd(meanSquare), eps));
+        _mm_storeu_pd(parameters + iIdx, _mm_sub_pd(_mm_loadu_pd(parameters + iIdx), change));
+    }
+    rmsPropScalar(iIdx, count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+}
+
+void adamSSE2(int64_t count, double stepSize, double beta1, double beta2, double epsilon,
+              const double* gradients, double* firstMoments, double* secondMoments, double* parameters) {
+    const __m128d b1 = _mm_set1_pd(beta1);
+    const __m128d rest1 = _mm_set1_pd(1.0 - beta1);
+    const __m128d b2 = _mm_set1_pd(beta2);
+    const __m128d rest2 = _mm_set1_pd(1.0 - beta2);
+    const __m128d alpha = _mm_set1_pd(stepSize);
+    const __m128d eps = _mm_set1_pd(epsilon);
+    int64_t iIdx = 0;
+    for (; iIdx + 2 <= count; iIdx += 2) {
+        __m128d gradient = _mm_loadu_pd(gradients + iIdx);
+        __m128d decayed1 = _mm_mul_pd(b1, _mm_loadu_pd(firstMoments + iIdx));
+        __m128d part1 = _mm_mul_pd(rest1, gradient);
+        __m128d decayed2 = _mm_mul_pd(b2, _mm_loadu_pd(secondMoments + iIdx));
+        __m128d part2 = _mm_mul_pd(rest2, _mm_mul_pd(gradient, gradient));
+        ANN_KEEP_PRODUCT(decayed1);
+        ANN_KEEP_PRODUCT(part1);
+        ANN_KEEP_PRODUCT(decayed2);
+        ANN_KEEP_PRODUCT(part2);
+        __m128d first = _mm_add_pd(decayed1, part1);
+        __m128d second = _mm_add_pd(decayed2, part2);
+        _mm_storeu_pd(firstMoments + iIdx, first);
+        _mm_storeu_pd(secondMoments + iIdx, second);
+        __m128d change = _mm_div_pd(_mm_mul_pd(alpha, first), _mm_add_pd(_mm_sqrt_pd(second), eps));
+        _mm_storeu_pd(parameters + iIdx, _mm_sub_pd(_mm_loadu_pd(parameters + iIdx), change));
+    }
+    adamScalar(iIdx, count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+}
+
+__attribute__((target("avx2")))
+void momentumAVX2(int64_t count, double learningRate, double momentum,
+                  const double* gradients, double* velocity, double* parameters) {
+    const __m256d mu = _mm256_set1_pd(momentum);
+    const __m256d step = _mm256_set1_pd(-learningRate);
+    int64_t iIdx = 0;
+    for (; iIdx + 4 <= count; iIdx += 4) {
+        __m256d decayed = _mm256_mul_pd(mu, _mm256_loadu_pd(velocity + iIdx));
+        ANN_KEEP_PRODUCT(decayed);
+        __m256d updated = _mm256_add_pd(decayed, _mm256_loadu_pd(gradients + iIdx));
+        __m256d change = _mm256_mul_pd(step, updated);
+        ANN_KEEP_PRODUCT(change);
+        _mm256_storeu_pd(velocity + iIdx, updated);
+        _mm256_storeu_pd(parameters + iIdx, _mm256_add_pd(_mm256_loadu_pd(parameters + iIdx), change));
+    }
+    momentumScalar(iIdx, count, learningRate, momentum, gradients, velocity, parameters);
+}
+
+__attribute__((target("avx2")))
+void rmsPropAVX2(int64_t count, double learningRate, double decay, double epsilon,
+                 const double* gradients, double* meanSquares, double* parameters) {
+    const __m256d rho = _mm256_set1_pd(decay);
+    const __m256d rest = _mm256_set1_pd(1.0 - decay);
+    const __m256d rate = _mm256_set1_pd(learningRate);
+    const __m256d eps = _mm256_set1_pd(epsilon);
+    int64_t iIdx = 0;
+    for (; iIdx + 4 <= count; iIdx += 4) {
+        __m256d gradient = _mm256_loadu_pd(gradients + iIdx);
+        __m256d decayed = _mm256_mul_pd(rho, _mm256_loadu_pd(meanSquares + iIdx));
+        __m256d square = _mm256_mul_pd(rest, _mm256_mul_pd(gradient, gradient));
+        __m256d scaled = _mm256_mul_pd(rate, gradient);
+        ANN_KEEP_PRODUCT(decayed);
+        ANN_KEEP_PRODUCT(square);
+        __m256d meanSquare = _mm256_add_pd(decayed, square);
+        _mm256_storeu_pd(meanSquares + iIdx, meanSquare);
+        __m256d change = _mm256_div_pd(scaled, _mm256_add_pd(_mm256_sqrt_pd(meanSquare), eps));
+        _mm256_storeu_pd(parameters + iIdx, _mm256_sub_pd(_mm256_loadu_pd(parameters + iIdx), change));
+    }
+    rmsPropScalar(iIdx, count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+}
+
+__attribute__((target("avx2")))
+void adamAVX2(int64_t count, double stepSize, double beta1, double beta2, double epsilon,
+              const double* gradients, double* firstMoments, double* secondMoments, double* parameters) {
+    const __m256d b1 = _mm256_set1_pd(beta1);
+    const __m256d rest1 = _mm256_set1_pd(1.0 - beta1);
+    const __m256d b2 = _mm256_set1_pd(beta2);
+    const __m256d rest2 = _mm256_set1_pd(1.0 - beta2);
+    const __m256d alpha = _mm256_set1_pd(stepSize);
+    const __m256d eps = _mm256_set1_pd(epsilon);
+    int64_t iIdx = 0;
+    for (; iIdx + 4 <= count; iIdx += 4) {
+        __m256d gradient = _mm256_loadu_pd(gradients + iIdx);
+        __m256d decayed1 = _mm256_mul_pd(b1, _mm256_loadu_pd(firstMoments + iIdx));
+        __m256d part1 = _mm256_mul_pd(rest1, gradient);
+        __m256d decayed2 = _mm256_mul_pd(b2, _mm256_loadu_pd(secondMoments + iIdx));
+        __m256d part2 = _mm256_mul_pd(rest2, _mm256_mul_pd(gradient, gradient));
+        ANN_KEEP_PRODUCT(decayed1);
+        ANN_KEEP_PRODUCT(part1);
+        ANN_KEEP_PRODUCT(decayed2);
+        ANN_KEEP_PRODUCT(part2);
+        __m256d first = _mm256_add_pd(decayed1, part1);
+        __m256d second = _mm256_add_pd(decayed2, part2);
+        _mm256_storeu_pd(firstMoments + iIdx, first);
+        _mm256_storeu_pd(secondMoments + iIdx, second);
+        __m256d root = _mm256_sqrt_pd(second);
+        __m256d change = _mm256_div_pd(_mm256_mul_pd(alpha, first), _mm256_add_pd(root, eps));
+        _mm256_storeu_pd(parameters + iIdx, _mm256_sub_pd(_mm256_loadu_pd(parameters + iIdx), change));
+    }
+    adamScalar(iIdx, count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+}
+
+// The AVX-512 updates mask their tails like axpyAVX512: a scalar tail here could be contracted into FMA
+__attribute__((target("avx512f")))
+inline __mmask8 tailMask(int64_t remaining) {
+    return static_cast<__mmask8>(remaining >= 8 ? 0xFF : (1u << remaining) - 1);
+}
+
+__attribute__((target("avx512f")))
+void momentumAVX512(int64_t count, double learningRate, double momentum,
+                    const double* gradients, double* velocity, double* parameters) {
+    const __m512d mu = _mm512_set1_pd(momentum);
+    const __m512d step = _mm512_set1_pd(-learningRate);
+    for (int64_t iIdx = 0; iIdx < count; iIdx += 8) {
+        __mmask8 uMask = tailMask(count - iIdx);
+        __m512d decayed = _mm512_mul_pd(mu, _mm512_maskz_loadu_pd(uMask, velocity + iIdx));
+        ANN_KEEP_PRODUCT(decayed);
+        __m512d updated = _mm512_add_pd(decayed, _mm512_maskz_loadu_pd(uMask, gradients + iIdx));
+        __m512d change = _mm512_mul_pd(step, updated);
+        ANN_KEEP_PRODUCT(change);
+        _mm512_mask_storeu_pd(velocity + iIdx, uMask, updated);
+        _mm512_mask_storeu_pd(parameters + iIdx, uMask,
+                              _mm512_add_pd(_mm512_maskz_loadu_pd(uMask, parameters + iIdx), change));
+    }
+}
+
+__attribute__((target("avx512f")))
+void rmsPropAVX512(int64_t count, double learningRate, double decay, double epsilon,
+                   const double* gradients, double* meanSquares, double* parameters) {
+    const __m512d rho = _mm512_set1_pd(decay);
+    const __m512d rest = _mm512_set1_pd(1.0 - decay);
+    const __m512d rate = _mm512_set1_pd(learningRate);
+    const __m512d eps = _mm512_set1_pd(epsilon);
+    for (int64_t iIdx = 0; iIdx < count; iIdx += 8) {
+        __mmask8 uMask = tailMask(count - iIdx);
+        __m512d gradient = _mm512_maskz_loadu_pd(uMask, gradients + iIdx);
+        __m512d decayed = _mm512_mul_pd(rho, _mm512_maskz_loadu_pd(uMask, meanSquares + iIdx));
+        __m512d square = _mm512_mul_pd(rest, _mm512_mul_pd(gradient, gradient));
+        __m512d scaled = _mm512_mul_pd(rate, gradient);
+        ANN_KEEP_PRODUCT(decayed);
+        ANN_KEEP_PRODUCT(square);
+        __m512d meanSquare = _mm512_add_pd(decayed, square);
+        _mm512_mask_storeu_pd(meanSquares + iIdx, uMask, meanSquare);
+        __m512d change = _mm512_div_pd(scaled, _mm512_add_pd(_mm512_maskz_sqrt_pd(uMask, meanSquare), eps));
+        _mm512_mask_storeu_pd(parameters + iIdx, uMask,
+                              _mm512_sub_pd(_mm512_maskz_loadu_pd(uMask, parameters + iIdx), change));
+    }
+}
+
+__attribute__((target("avx512f")))
+void adamAVX512(int64_t count, double stepSize, double beta1, double beta2, double epsilon,
+                const double* gradients, double* firstMoments, double* secondMoments, double* parameters) {
+    const __m512d b1 = _mm512_set1_pd(beta1);
+    const __m512d rest1 = _mm512_set1_pd(1.0 - beta1);
+    const __m512d b2 = _mm512_set1_pd(beta2);
+    const __m512d rest2 = _mm512_set1_pd(1.0 - beta2);
+    const __m512d alpha = _mm512_set1_pd(stepSize);
+    const __m512d eps = _mm512_set1_pd(epsilon);
+    for (int64_t iIdx = 0; iIdx < count; iIdx += 8) {
+        __mmask8 uMask = tailMask(count - iIdx);
+        __m512d gradient = _mm512_maskz_loadu_pd(uMask, gradients + iIdx);
+        __m512d decayed1 = _mm512_mul_pd(b1, _mm512_maskz_loadu_pd(uMask, firstMoments + iIdx));
+        __m512d part1 = _mm512_mul_pd(rest1, gradient);
+        __m512d decayed2 = _mm512_mul_pd(b2, _mm512_maskz_loadu_pd(uMask, secondMoments + iIdx));
+        __m512d part2 = _mm512_mul_pd(rest2, _mm512_mul_pd(gradient, gradient));
+        ANN_KEEP_PRODUCT(decayed1);
+        ANN_KEEP_PRODUCT(part1);
+        ANN_KEEP_PRODUCT(decayed2);
+        ANN_KEEP_PRODUCT(part2);
+        __m512d first = _mm512_add_pd(decayed1, part1);
+        __m512d second = _mm512_add_pd(decayed2, part2);
+        _mm512_mask_storeu_pd(firstMoments + iIdx, uMask, first);
+        _mm512_mask_storeu_pd(secondMoments + iIdx, uMask, second);
+        __m512d root = _mm512_maskz_sqrt_pd(uMask, second);
+        __m512d change = _mm512_div_pd(_mm512_mul_pd(alpha, first), _mm512_add_pd(root, eps));
+        _mm512_mask_storeu_pd(parameters + iIdx, uMask,
+                              _mm512_sub_pd(_mm512_maskz_loadu_pd(uMask, parameters + iIdx), change));
+    }
+}
+
+#endif // ANN_KERNEL_DISPATCH
+
+KernelIsa detectIsa() {
+#ifdef ANN_KERNEL_DISPATCH
+    unsigned int uEax = 0, uEbx = 0, uEcx = 0, uEdx = 0;
+    if (!__get_cpuid(1, &uEax, &uEbx, &uEcx, &uEdx) || !(uEdx & bit_SSE2)) {
+        return KernelIsa::Scalar;
+    }
+    // AVX state must be enabled by the OS, not just present in the CPU
+    if (!(uEcx & bit_OSXSAVE) || !(uEcx & bit_AVX)) {
+        return KernelIsa::SSE2;
+    }
+    uint64_t uXcr0 = readXcr0();
+    if ((uXcr0 & 0x6) != 0x6 || __get_cpuid_max(0, nullptr) < 7) {
+        return KernelIsa::SSE2;
+    }
+    __cpuid_count(7, 0, uEax, uEbx, uEcx, uEdx);
+    if (!(uEbx & bit_AVX2)) {
+        return KernelIsa::SSE2;
+    }
+    // AVX-512 additionally needs the opmask and upper ZMM states
+    if ((uEbx & bit_AVX512F) && (uXcr0 & 0xE6) == 0xE6) {
+        return KernelIsa::AVX512;
+    }
+    return KernelIsa::AVX2;
+#else
+    return KernelIsa::Scalar;
+#endif
+}
+
+// -1 when no level is forced; initialised once from ANN_KERNEL_ISA
+atomic<int>& overrideState() {
+    static atomic<int> s_state(-1);
+    static bool s_bInitialised = []() {
+        const char* pValue = getenv("ANN_KERNEL_ISA");
+        KernelIsa isa = KernelIsa::Scalar;
+        if (pValue && KernelDispatch::parseIsaName(pValue, isa) && KernelDispatch::isSupported(isa)) {
+            s_state.store(static_cast<int>(isa));
+        }
+        return true;
+    }();
+    (void)s_bInitialised;
+    return s_state;
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】getDetectedIsa
+//【函数功能】获取CPU与操作系统共同支持的最高级别
+//【参数】无
+//【返回值】KernelIsa，检测到的级别
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+KernelIsa KernelDispatch::getDetectedIsa() {
+    static const KernelIsa s_detected = detectIsa();
+    return s_detected;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getActiveIsa
+//【函数功能】获取内核实际使用的级别
+//【参数】无
+//【返回值】KernelIsa，当前级别
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+KernelIsa KernelDispatch::getActiveIsa() {
+    int iForced = overrideState().load(memory_order_relaxed);
+    return iForced < 0 ? getDetectedIsa() : static_cast<KernelIsa>(iForced);
+}
+
+//-------------------------------------------------------------
+//【函数名称】isSupported
+//【函数功能】判断某一级别能否在本机运行
+//【参数】isa：指令集级别
+//【返回值】bool，是否支持
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool KernelDispatch::isSupported(KernelIsa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(getDetectedIsa());
+}
+
+//-------------------------------------------------------------
+//【函数名称】setIsaOverride
+//【函数功能】强制内核使用指定级别
+//【参数】isa：指令集级别
+//【返回值】bool，是否设置成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool KernelDispatch::setIsaOverride(KernelIsa isa) {
+    if (!isSupported(isa)) {
+        return false;
+    }
+    overrideState().store(static_cast<int>(isa));
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】clearIsaOverride
+//【函数功能】取消强制设置
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::clearIsaOverride() {
+    overrideState().store(-1);
+}
+
+//-------------------------------------------------------------
+//【函数名称】isOverridden
+//【函数功能】判断当前是否处于强制设置
+//【参数】无
+//【返回值】bool，是否强制
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool KernelDispatch::isOverridden() {
+    return overrideState().load() >= 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getIsaName
+//【函数功能】获取级别的显示名称
+//【参数】isa：指令集级别
+//【返回值】const char*，名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const char* KernelDispatch::getIsaName(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::SSE2:
+            return "SSE2";
+        case KernelIsa::AVX2:
+            return "AVX2";
+        case KernelIsa::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】parseIsaName
+//【函数功能】解析级别名称
+//【参数】name：名称，isa：输出级别
+//【返回值】bool，是否合法
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool KernelDispatch::parseIsaName(const string& name, KernelIsa& isa) {
+    string lower;
+    for (char c : name) {
+        if (c != '-') {
+            lower += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    if (lower == "scalar") {
+        isa = KernelIsa::Scalar;
+    } else if (lower == "sse2") {
+        isa = KernelIsa::SSE2;
+    } else if (lower == "avx2") {
+        isa = KernelIsa::AVX2;
+    } else if (lower == "avx512") {
+        isa = KernelIsa::AVX512;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】packPanels
+//【函数功能】把行主序权重重排为面板
+//【参数】weights：权重，biases：偏置，width：神经元数，inputWidth：行长度，panels：输出面板
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::packPanels(const vector<double>& weights, const vector<double>& biases,
+                                int64_t width, int64_t inputWidth, vector<double>& panels) {
+    int64_t iPanels = (width + LANES - 1) / LANES;
+    panels.resize(static_cast<size_t>(iPanels * (1 + inputWidth) * LANES));
+    for (int64_t iPanel = 0; iPanel < iPanels; ++iPanel) {
+        double* pPanel = panels.data() + iPanel * (1 + inputWidth) * LANES;
+        for (int64_t iLane = 0; iLane < LANES; ++iLane) {
+            int64_t iNeuronIdx = iPanel * LANES + iLane;
+            bool bValid = iNeuronIdx < width;
+            pPanel[iLane] = bValid ? biases[iNeuronIdx] : 0.0;
+            for (int64_t iInputIdx = 0; iInputIdx < inputWidth; ++iInputIdx) {
+                pPanel[(1 + iInputIdx) * LANES + iLane] =
+                    bValid ? weights[iNeuronIdx * inputWidth + iInputIdx] : 0.0;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】describeActivations
+//【函数功能】按面板汇总各神经元的激活函数代码
+//【参数】codes：激活函数代码，width：神经元数，activations：输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::describeActivations(const int32_t* codes, int64_t width,
+                                         vector<PanelActivation>& activations) {
+    int64_t iPanels = (width + LANES - 1) / LANES;
+    activations.assign(static_cast<size_t>(iPanels), PanelActivation{0, 0});
+    for (int64_t iNeuronIdx = 0; iNeuronIdx < width; ++iNeuronIdx) {
+        PanelActivation& activation = activations[iNeuronIdx / LANES];
+        uint8_t uBit = static_cast<uint8_t>(1u << (iNeuronIdx % LANES));
+        if (codes[iNeuronIdx] == 3) {
+            activation.uReluLanes |= uBit;
+        } else if (codes[iNeuronIdx] == 1 || codes[iNeuronIdx] == 2) {
+            activation.uScalarLanes |= uBit;
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】denseForward
+//【函数功能】用指定级别的内核计算各神经元的输出
+//【参数】isa：级别，panels：面板，activations：面板激活分类（可为nullptr），codes：激活函数代码，
+//       width：神经元数，inputWidth：行长度，inputs：输入，outputs：输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 融合激活函数
+//-------------------------------------------------------------
+void KernelDispatch::denseForward(KernelIsa isa, const double* panels, const PanelActivation* activations,
+                                  const int32_t* codes, int64_t width, int64_t inputWidth,
+                                  const double* inputs, double* outputs) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            denseAVX512(panels, activations, codes, width, inputWidth, inputs, outputs);
+            return;
+        case KernelIsa::AVX2:
+            denseAVX2(panels, activations, codes, width, inputWidth, inputs, outputs);
+            return;
+        case KernelIsa::SSE2:
+            denseSSE2(panels, activations, codes, width, inputWidth, inputs, outputs);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    denseScalar(panels, activations, codes, width, inputWidth, inputs, outputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyActivations
+//【函数功能】用指定级别的内核原地计算激活值
+//【参数】isa：级别，codes：激活函数代码，width：数量，values：加权和/激活值
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::applyActivations(KernelIsa isa, const int32_t* codes, int64_t width, double* values) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            activateAVX512(codes, width, values);
+            return;
+        case KernelIsa::AVX2:
+            activateAVX2(codes, width, values);
+            return;
+        case KernelIsa::SSE2:
+            activateSSE2(codes, width, values);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    activateScalar(codes, 0, width, values);
+}
+
+//-------------------------------------------------------------
+//【函数名称】axpy
+//【函数功能】用指定级别的内核计算y += alpha·x
+//【参数】isa：级别，count：元素数，alpha：系数，x：输入，y：累加目标
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::axpy(KernelIsa isa, int64_t count, double alpha, const double* x, double* y) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            axpyAVX512(count, alpha, x, y);
+            return;
+        case KernelIsa::AVX2:
+            axpyAVX2(count, alpha, x, y);
+            return;
+        case KernelIsa::SSE2:
+            axpySSE2(count, alpha, x, y);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    axpyScalar(0, count, alpha, x, y);
+}
+
+//-------------------------------------------------------------
+//【函数名称】momentumUpdate
+//【函数功能】用指定级别的内核完成带动量的SGD更新
+//【参数】isa：级别，count：元素数，learningRate：学习率，momentum：动量系数，
+//       gradients：梯度，velocity：速度（原地更新），parameters：参数（原地更新）
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::momentumUpdate(KernelIsa isa, int64_t count, double learningRate, double momentum,
+                                    const double* gradients, double* velocity, double* parameters) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            momentumAVX512(count, learningRate, momentum, gradients, velocity, parameters);
+            return;
+        case KernelIsa::AVX2:
+            momentumAVX2(count, learningRate, momentum, gradients, velocity, parameters);
+            return;
+        case KernelIsa::SSE2:
+            momentumSSE2(count, learningRate, momentum, gradients, velocity, parameters);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    momentumScalar(0, count, learningRate, momentum, gradients, velocity, parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】rmsPropUpdate
+//【函数功能】用指定级别的内核完成RMSProp更新
+//【参数】isa：级别，count：元素数，learningRate：学习率，decay：衰减系数，epsilon：分母的小常数，
+//       gradients：梯度，meanSquares：梯度平方的滑动平均（原地更新），parameters：参数（原地更新）
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::rmsPropUpdate(KernelIsa isa, int64_t count, double learningRate, double decay, double epsilon,
+                                   const double* gradients, double* meanSquares, double* parameters) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            rmsPropAVX512(count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+            return;
+        case KernelIsa::AVX2:
+            rmsPropAVX2(count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+            return;
+        case KernelIsa::SSE2:
+            rmsPropSSE2(count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    rmsPropScalar(0, count, learningRate, decay, epsilon, gradients, meanSquares, parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】adamUpdate
+//【函数功能】用指定级别的内核完成Adam更新
+//【参数】isa：级别，count：元素数，stepSize：含偏差修正的步长，beta1、beta2：矩的衰减系数，
+//       epsilon：分母的小常数，gradients：梯度，firstMoments、secondMoments：一阶、二阶矩（原地更新），
+//       parameters：参数（原地更新）
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void KernelDispatch::adamUpdate(KernelIsa isa, int64_t count, double stepSize, double beta1, double beta2,
+                                double epsilon, const double* gradients, double* firstMoments,
+                                double* secondMoments, double* parameters) {
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            adamAVX512(count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+            return;
+        case KernelIsa::AVX2:
+            adamAVX2(count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+            return;
+        case KernelIsa::SSE2:
+            adamSSE2(count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+            return;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    adamScalar(0, count, stepSize, beta1, beta2, epsilon, gradients, firstMoments, secondMoments, parameters);
+}
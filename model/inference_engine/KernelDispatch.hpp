@@ -0,0 +1,257 @@
+//-------------------------------------------------------------
+//【文件名】KernelDispatch.hpp
+//【功能模块和目的】按运行时CPU特性选择稠密层内核的指令集版本声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 平台宏和ANN_KEEP_PRODUCT移到头文件，供PackedGemm共用
+//           2026-10-18 增加PanelActivation，内核在存储前融合激活函数
+//           2026-10-18 增加训练使用的axpy内核
+//           2026-10-18 增加优化器的融合更新内核（动量、RMSProp、Adam）
+//-------------------------------------------------------------
+
+#ifndef KernelDispatch_hpp
+#define KernelDispatch_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ANN_KERNEL_DISPATCH 1
+// Empty asm that claims to modify a product, so the compiler cannot fuse it with the following
+// add into an FMA (GCC contracts by default in C++ and the AVX-512 target includes FMA)
+#define ANN_KEEP_PRODUCT(product) __asm__("" : "+x"(product))
+#endif
+
+//-------------------------------------------------------------
+//【类名】KernelIsa
+//【功能】稠密层内核的指令集级别，按能力从低到高排列
+//【说明】Scalar为可移植的逐行内核（CompiledLayer::forward原实现），其余为x86-64向量内核
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+enum class KernelIsa {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+//-------------------------------------------------------------
+//【类名】PanelActivation
+//【功能】一个面板（PANEL_WIDTH个神经元）中各通道的激活函数分类，第i位对应面板的第i个神经元
+//【说明】ReLU通道在向量寄存器中取max；Sigmoid和Tanh通道在寄存器结果写回前逐通道调用
+//       CompiledLayer::applyActivation；两者均未置位的通道为Linear或末块的填充通道
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct PanelActivation {
+    uint8_t uReluLanes;     // Lanes computed with a vector max
+    uint8_t uScalarLanes;   // Sigmoid and Tanh lanes, computed one by one
+};
+
+//-------------------------------------------------------------
+//【类名】KernelDispatch
+//【功能】启动时用cpuid（及xgetbv确认操作系统保存向量寄存器）检测可用的指令集，
+//       为非输入层提供按面板打包权重的矩阵向量乘内核和激活函数循环的各指令集版本
+//【说明】向量内核一次计算PANEL_WIDTH个神经元，每个神经元各占一个向量通道，
+//       仍按偏置、输入0、输入1……的顺序逐次相乘再相加，不使用FMA，
+//       因此各级别的结果与Network::predict逐位一致，只是速度不同。
+//       偏置作为累加初值，激活函数在结果写回内存前对寄存器中的面板计算，每层输出只写一次；
+//       Sigmoid和Tanh调用与标量内核相同的exp，只有ReLU被向量化。
+//       可用setIsaOverride或环境变量ANN_KERNEL_ISA（scalar、sse2、avx2、avx512）
+//       强制使用某一级别，但不能高于CPU支持的级别。
+//       非GCC/Clang或非x86-64平台只有Scalar可用。所有方法均为静态方法，可在多个线程中调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 denseForward融合激活函数
+//-------------------------------------------------------------
+class KernelDispatch {
+public:
+    static const int64_t PANEL_WIDTH = 8;  // 每个权重面板包含的神经元数
+
+    //-------------------------------------------------------------
+    //【函数名称】getDetectedIsa
+    //【函数功能】获取CPU与操作系统共同支持的最高级别（首次调用时检测，之后缓存）
+    //【参数】无
+    //【返回值】KernelIsa，检测到的级别
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static KernelIsa getDetectedIsa();
+
+    //-------------------------------------------------------------
+    //【函数名称】getActiveIsa
+    //【函数功能】获取内核实际使用的级别：有强制设置时为强制级别，否则为检测到的级别
+    //【参数】无
+    //【返回值】KernelIsa，当前级别
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static KernelIsa getActiveIsa();
+
+    //-------------------------------------------------------------
+    //【函数名称】isSupported
+    //【函数功能】判断某一级别能否在本机运行
+    //【参数】isa：指令集级别
+    //【返回值】bool，不高于检测到的级别返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool isSupported(KernelIsa isa);
+
+    //-------------------------------------------------------------
+    //【函数名称】setIsaOverride
+    //【函数功能】强制内核使用指定级别（用于测试和对比），对之后的所有推理立即生效
+    //【参数】isa：指令集级别
+    //【返回值】bool，本机支持该级别时返回true，否则不改变当前设置
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool setIsaOverride(KernelIsa isa);
+
+    //-------------------------------------------------------------
+    //【函数名称】clearIsaOverride
+    //【函数功能】取消强制设置（包括环境变量给出的设置），恢复使用检测到的级别
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void clearIsaOverride();
+
+    //-------------------------------------------------------------
+    //【函数名称】isOverridden
+    //【函数功能】判断当前是否处于强制设置
+    //【参数】无
+    //【返回值】bool，强制设置时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool isOverridden();
+
+    //-------------------------------------------------------------
+    //【函数名称】getIsaName
+    //【函数功能】获取级别的显示名称
+    //【参数】isa：指令集级别
+    //【返回值】const char*，名称（"Scalar"、"SSE2"、"AVX2"、"AVX-512"）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static const char* getIsaName(KernelIsa isa);
+
+    //-------------------------------------------------------------
+    //【函数名称】parseIsaName
+    //【函数功能】解析级别名称（不区分大小写，与ANN_KERNEL_ISA的取值相同）
+    //【参数】name：名称，isa：输出级别
+    //【返回值】bool，名称合法返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool parseIsaName(const string& name, KernelIsa& isa);
+
+    //-------------------------------------------------------------
+    //【函数名称】packPanels
+    //【函数功能】把行主序权重重排为面板：每PANEL_WIDTH个神经元一块，块内先是偏置，
+    //           随后按输入顺序存放各神经元的权重，末块不足的通道以0填充
+    //【参数】weights：行主序权重，biases：偏置，width：神经元数，inputWidth：行长度，
+    //       panels：输出面板（复用已有容量）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void packPanels(const vector<double>& weights, const vector<double>& biases,
+                           int64_t width, int64_t inputWidth, vector<double>& panels);
+
+    //-------------------------------------------------------------
+    //【函数名称】describeActivations
+    //【函数功能】按面板汇总各神经元的激活函数代码，供融合内核使用
+    //【参数】codes：激活函数代码，width：神经元数，activations：每个面板一项（复用已有容量）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void describeActivations(const int32_t* codes, int64_t width, vector<PanelActivation>& activations);
+
+    //-------------------------------------------------------------
+    //【函数名称】denseForward
+    //【函数功能】用指定级别的内核计算各神经元的输出：偏置、加权和与激活函数在一次遍历中完成
+    //【参数】isa：指令集级别（Scalar按面板逐个计算），panels：packPanels的结果，
+    //       activations：describeActivations的结果，为nullptr时只计算加权和，
+    //       codes：激活函数代码，width：神经元数，inputWidth：行长度，
+    //       inputs：inputWidth个输入，outputs：width个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加activations和codes参数，激活函数在写回前计算
+    //-------------------------------------------------------------
+    static void denseForward(KernelIsa isa, const double* panels, const PanelActivation* activations,
+                             const int32_t* codes, int64_t width, int64_t inputWidth,
+                             const double* inputs, double* outputs);
+
+    //-------------------------------------------------------------
+    //【函数名称】applyActivations
+    //【函数功能】用指定级别的内核原地计算激活值，结果与CompiledLayer::applyActivation相同
+    //           （未融合的单独一遍，融合内核的结果与之逐位一致）
+    //【参数】isa：指令集级别，codes：激活函数代码，width：数量，values：加权和，计算后为激活值
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void applyActivations(KernelIsa isa, const int32_t* codes, int64_t width, double* values);
+
+    //-------------------------------------------------------------
+    //【函数名称】axpy
+    //【函数功能】用指定级别的内核计算y[i] += alpha·x[i]（反向传播的梯度累加和误差回传），
+    //           乘积与加法分开计算，各级别结果逐位一致
+    //【参数】isa：指令集级别，count：元素数，alpha：系数，x：count个输入，y：count个累加目标
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void axpy(KernelIsa isa, int64_t count, double alpha, const double* x, double* y);
+
+    //-------------------------------------------------------------
+    //【函数名称】momentumUpdate
+    //【函数功能】在一次遍历中完成带动量的SGD：velocity = momentum·velocity + gradient，
+    //           parameter += (-learningRate)·velocity（momentum为0时与axpy的SGD逐位相同）
+    //【参数】isa：指令集级别，count：元素数，learningRate：学习率，momentum：动量系数，
+    //       gradients：count个梯度，velocity：count个速度（原地更新），parameters：count个参数（原地更新）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void momentumUpdate(KernelIsa isa, int64_t count, double learningRate, double momentum,
+                               const double* gradients, double* velocity, double* parameters);
+
+    //-------------------------------------------------------------
+    //【函数名称】rmsPropUpdate
+    //【函数功能】在一次遍历中完成RMSProp：meanSquare = decay·meanSquare + (1-decay)·gradient²，
+    //           parameter -= learningRate·gradient / (sqrt(meanSquare) + epsilon)
+    //【参数】isa：指令集级别，count：元素数，learningRate：学习率，decay：衰减系数，epsilon：分母的小常数，
+    //       gradients：count个梯度，meanSquares：count个滑动平均（原地更新），parameters：count个参数（原地更新）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void rmsPropUpdate(KernelIsa isa, int64_t count, double learningRate, double decay, double epsilon,
+                              const double* gradients, double* meanSquares, double* parameters);
+
+    //-------------------------------------------------------------
+    //【函数名称】adamUpdate
+    //【函数功能】在一次遍历中完成Adam：m = beta1·m + (1-beta1)·gradient，v = beta2·v + (1-beta2)·gradient²，
+    //           parameter -= stepSize·m / (sqrt(v) + epsilon)
+    //【参数】isa：指令集级别，count：元素数，stepSize：本步含偏差修正的步长，beta1、beta2：矩的衰减系数，
+    //       epsilon：分母的小常数，gradients：count个梯度，firstMoments、secondMoments：count个一阶、二阶矩
+    //       （原地更新），parameters：count个参数（原地更新）
+    //【返回值】无
+    //【说明】三个更新内核与axpy相同，乘积与加法分开计算，sqrt和除法按IEEE精确舍入，
+    //       各级别结果逐位一致；AVX-512版本用掩码处理末尾不足一个向量的元素
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void adamUpdate(KernelIsa isa, int64_t count, double stepSize, double beta1, double beta2,
+                           double epsilon, const double* gradients, double* firstMoments,
+                           double* secondMoments, double* parameters);
+};
+
+#endif // KernelDispatch_hpp
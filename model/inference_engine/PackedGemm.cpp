@@ -0,0 +1,433 @@
+//-------------------------------------------------------------
+//【文件名】PackedGemm.cpp
+//【功能模块和目的】批量推理使用的分块打包矩阵乘内核实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 最后一段输入累加后在寄存器中计算激活函数
+//-------------------------------------------------------------
+
+#include "PackedGemm.hpp"
+#include "FusedActivation.hpp"
+#include <algorithm>
+#include <chrono>
+
+#ifdef ANN_KERNEL_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const int64_t LANES = KernelDispatch::PANEL_WIDTH;
+const int64_t PEAK_ITERATIONS = 1 << 22;
+const int PEAK_CHAINS = 12;  // Enough independent mul -> add chains to cover both latencies
+
+// Loops over tile rows and vectors must be fully unrolled, or the accumulators live on the stack
+#define ANN_UNROLL _Pragma("GCC unroll 16")
+
+// One register tile: ROWS samples x one panel over inputs [kBegin, kEnd). The first segment
+// starts from the biases, later ones continue from the partial sums stored in `sums`.
+// `activation` is non-null only on the last segment: the tile is activated before its store.
+template <int ROWS>
+void tileScalar(const double* panel, int64_t kBegin, int64_t kEnd,
+                const double* inputs, int64_t inputStride, double* sums, int64_t sumStride,
+                const PanelActivation* activation, const int32_t* codes) {
+    uint8_t uLanes = activation ? static_cast<uint8_t>(activation->uReluLanes | activation->uScalarLanes) : 0;
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        double* pSums = sums + iRow * sumStride;
+        for (int64_t iLane = 0; iLane < LANES; ++iLane) {
+            double rSum = kBegin == 0 ? panel[iLane] : pSums[iLane];
+            for (int64_t iInputIdx = kBegin; iInputIdx < kEnd; ++iInputIdx) {
+                rSum += inputs[iRow * inputStride + iInputIdx] * panel[(1 + iInputIdx) * LANES + iLane];
+            }
+            pSums[iLane] = (uLanes >> iLane) & 1 ? CompiledLayer::applyActivation(codes[iLane], rSum) : rSum;
+        }
+    }
+}
+
+#ifdef ANN_KERNEL_DISPATCH
+
+template <int ROWS>
+void tileSSE2(const double* panel, int64_t kBegin, int64_t kEnd,
+              const double* inputs, int64_t inputStride, double* sums, int64_t sumStride,
+              const PanelActivation* activation, const int32_t* codes) {
+    __m128d acc[ROWS][4];
+    const double* pStart = kBegin == 0 ? panel : sums;
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        ANN_UNROLL
+        for (int iVec = 0; iVec < 4; ++iVec) {
+            acc[iRow][iVec] = _mm_loadu_pd(pStart + (kBegin == 0 ? 0 : iRow * sumStride) + iVec * 2);
+        }
+    }
+    const double* pWeights = panel + (1 + kBegin) * LANES;
+    for (int64_t iInputIdx = kBegin; iInputIdx < kEnd; ++iInputIdx, pWeights += LANES) {
+        __m128d weights[4];
+        ANN_UNROLL
+        for (int iVec = 0; iVec < 4; ++iVec) {
+            weights[iVec] = _mm_loadu_pd(pWeights + iVec * 2);
+        }
+        ANN_UNROLL
+        for (int iRow = 0; iRow < ROWS; ++iRow) {
+            __m128d input = _mm_set1_pd(inputs[iRow * inputStride + iInputIdx]);
+            ANN_UNROLL
+            for (int iVec = 0; iVec < 4; ++iVec) {
+                __m128d product = _mm_mul_pd(input, weights[iVec]);
+                ANN_KEEP_PRODUCT(product);
+                acc[iRow][iVec] = _mm_add_pd(acc[iRow][iVec], product);
+            }
+        }
+    }
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        if (activation) {
+            FusedActivation::applySSE2(*activation, codes, acc[iRow]);
+        }
+        ANN_UNROLL
+        for (int iVec = 0; iVec < 4; ++iVec) {
+            _mm_storeu_pd(sums + iRow * sumStride + iVec * 2, acc[iRow][iVec]);
+        }
+    }
+}
+
+template <int ROWS>
+__attribute__((target("avx2")))
+void tileAVX2(const double* panel, int64_t kBegin, int64_t kEnd,
+              const double* inputs, int64_t inputStride, double* sums, int64_t sumStride,
+              const PanelActivation* activation, const int32_t* codes) {
+    __m256d acc[ROWS][2];
+    const double* pStart = kBegin == 0 ? panel : sums;
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        ANN_UNROLL
+        for (int iVec = 0; iVec < 2; ++iVec) {
+            acc[iRow][iVec] = _mm256_loadu_pd(pStart + (kBegin == 0 ? 0 : iRow * sumStride) + iVec * 4);
+        }
+    }
+    const double* pWeights = panel + (1 + kBegin) * LANES;
+    for (int64_t iInputIdx = kBegin; iInputIdx < kEnd; ++iInputIdx, pWeights += LANES) {
+        __m256d weights0 = _mm256_loadu_pd(pWeights);
+        __m256d weights1 = _mm256_loadu_pd(pWeights + 4);
+        ANN_UNROLL
+        for (int iRow = 0; iRow < ROWS; ++iRow) {
+            __m256d input = _mm256_set1_pd(inputs[iRow * inputStride + iInputIdx]);
+            __m256d product0 = _mm256_mul_pd(input, weights0);
+            __m256d product1 = _mm256_mul_pd(input, weights1);
+            ANN_KEEP_PRODUCT(product0);
+            ANN_KEEP_PRODUCT(product1);
+            acc[iRow][0] = _mm256_add_pd(acc[iRow][0], product0);
+            acc[iRow][1] = _mm256_add_pd(acc[iRow][1], product1);
+        }
+    }
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        if (activation) {
+            FusedActivation::applyAVX2(*activation, codes, acc[iRow]);
+        }
+        _mm256_storeu_pd(sums + iRow * sumStride, acc[iRow][0]);
+        _mm256_storeu_pd(sums + iRow * sumStride + 4, acc[iRow][1]);
+    }
+}
+
+template <int ROWS>
+__attribute__((target("avx512f")))
+void tileAVX512(const double* panel, int64_t kBegin, int64_t kEnd,
+                const double* inputs, int64_t inputStride, double* sums, int64_t sumStride,
+                const PanelActivation* activation, const int32_t* codes) {
+    __m512d acc[ROWS];
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        acc[iRow] = _mm512_loadu_pd(kBegin == 0 ? panel : sums + iRow * sumStride);
+    }
+    const double* pWeights = panel + (1 + kBegin) * LANES;
+    for (int64_t iInputIdx = kBegin; iInputIdx < kEnd; ++iInputIdx, pWeights += LANES) {
+        __m512d weights = _mm512_loadu_pd(pWeights);
+        ANN_UNROLL
+        for (int iRow = 0; iRow < ROWS; ++iRow) {
+            __m512d product = _mm512_mul_pd(_mm512_set1_pd(inputs[iRow * inputStride + iInputIdx]), weights);
+            ANN_KEEP_PRODUCT(product);
+            acc[iRow] = _mm512_add_pd(acc[iRow], product);
+        }
+    }
+    ANN_UNROLL
+    for (int iRow = 0; iRow < ROWS; ++iRow) {
+        if (activation) {
+            FusedActivation::applyAVX512(*activation, codes, acc[iRow]);
+        }
+        _mm512_storeu_pd(sums + iRow * sumStride, acc[iRow]);
+    }
+}
+
+#endif // ANN_KERNEL_DISPATCH
+
+typedef void (*TileFunction)(const double*, int64_t, int64_t, const double*, int64_t, double*, int64_t,
+                             const PanelActivation*, const int32_t*);
+
+// Full tiles plus one instantiation per possible remainder, indexed by row count
+#define ANN_TILE_TABLE(name, function)                                                        \
+    struct name {                                                                             \
+        static TileFunction get(int64_t rows) {                                               \
+            static const TileFunction s_tiles[] = {nullptr, function<1>, function<2>,         \
+                function<3>, function<4>, function<5>, function<6>, function<7>, function<8>}; \
+            return s_tiles[rows];                                                             \
+        }                                                                                     \
+    };
+
+ANN_TILE_TABLE(ScalarTiles, tileScalar)
+#ifdef ANN_KERNEL_DISPATCH
+ANN_TILE_TABLE(SSE2Tiles, tileSSE2)
+ANN_TILE_TABLE(AVX2Tiles, tileAVX2)
+ANN_TILE_TABLE(AVX512Tiles, tileAVX512)
+#endif
+
+#undef ANN_TILE_TABLE
+
+// Input segments outermost: the panel segment stays in L1 while it meets every row block,
+// and a row block's segment stays in L2 while it meets every panel
+template <class Tiles>
+void multiplyBlocked(int64_t tileRows, const double* panels, const PanelActivation* activations,
+                     const int32_t* codes, int64_t width, int64_t inputWidth,
+                     const double* inputs, int64_t inputStride, int64_t rows,
+                     double* sums, int64_t sumStride) {
+    const int64_t iPanels = (width + LANES - 1) / LANES;
+    const int64_t iPanelStride = (1 + inputWidth) * LANES;
+    const TileFunction fullTile = Tiles::get(tileRows);
+    for (int64_t kBegin = 0; kBegin == 0 || kBegin < inputWidth; kBegin += PackedGemm::BLOCK_K) {
+        int64_t kEnd = min(inputWidth, kBegin + PackedGemm::BLOCK_K);
+        bool bLastSegment = activations && kEnd == inputWidth;
+        for (int64_t iRowBegin = 0; iRowBegin < rows; iRowBegin += PackedGemm::BLOCK_ROWS) {
+            int64_t iRowEnd = min(rows, iRowBegin + PackedGemm::BLOCK_ROWS);
+            for (int64_t iPanel = 0; iPanel < iPanels; ++iPanel) {
+                const double* pPanel = panels + iPanel * iPanelStride;
+                const PanelActivation* pActivation = bLastSegment ? activations + iPanel : nullptr;
+                const int32_t* pCodes = bLastSegment ? codes + iPanel * LANES : nullptr;
+                for (int64_t iRow = iRowBegin; iRow < iRowEnd; iRow += tileRows) {
+                    int64_t iCount = min(tileRows, iRowEnd - iRow);
+                    TileFunction tile = iCount == tileRows ? fullTile : Tiles::get(iCount);
+                    tile(pPanel, kBegin, kEnd, inputs + iRow * inputStride, inputStride,
+                         sums + iRow * sumStride + iPanel * LANES, sumStride, pActivation, pCodes);
+                }
+            }
+        }
+    }
+}
+
+// Independent chains of the kernel's mul + add pair, entirely in registers; every chain feeds
+// the result so none is dropped as dead code
+double peakScalar() {
+    double acc[PEAK_CHAINS];
+    volatile double rFactor = 1e-9;
+    double rScale = rFactor;
+    ANN_UNROLL
+    for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+        acc[iChain] = iChain;
+    }
+    for (int64_t iIter = 0; iIter < PEAK_ITERATIONS; ++iIter) {
+        ANN_UNROLL
+        for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+            acc[iChain] += acc[iChain] * rScale;
+        }
+    }
+    double rTotal = 0.0;
+    for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+        rTotal += acc[iChain];
+    }
+    return rTotal;
+}
+
+#ifdef ANN_KERNEL_DISPATCH
+
+double peakSSE2() {
+    __m128d acc[PEAK_CHAINS];
+    volatile double rFactor = 1e-9;
+    __m128d scale = _mm_set1_pd(rFactor);
+    ANN_UNROLL
+    for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+        acc[iChain] = _mm_set1_pd(iChain);
+    }
+    for (int64_t iIter = 0; iIter < PEAK_ITERATIONS; ++iIter) {
+        ANN_UNROLL
+        for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+            __m128d product = _mm_mul_pd(acc[iChain], scale);
+            ANN_KEEP_PRODUCT(product);
+            acc[iChain] = _mm_add_pd(acc[iChain], product);
+        }
+    }
+    __m128d total = acc[0];
+    for (int iChain = 1; iChain < PEAK_CHAINS; ++iChain) {
+        total = _mm_add_pd(total, acc[iChain]);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, total);
+    return lanes[0] + lanes[1];
+}
+
+__attribute__((target("avx2")))
+double peakAVX2() {
+    __m256d acc[PEAK_CHAINS];
+    volatile double rFactor = 1e-9;
+    __m256d scale = _mm256_set1_pd(rFactor);
+    ANN_UNROLL
+    for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+        acc[iChain] = _mm256_set1_pd(iChain);
+    }
+    for (int64_t iIter = 0; iIter < PEAK_ITERATIONS; ++iIter) {
+        ANN_UNROLL
+        for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+            __m256d product = _mm256_mul_pd(acc[iChain], scale);
+            ANN_KEEP_PRODUCT(product);
+            acc[iChain] = _mm256_add_pd(acc[iChain], product);
+        }
+    }
+    __m256d total = acc[0];
+    for (int iChain = 1; iChain < PEAK_CHAINS; ++iChain) {
+        total = _mm256_add_pd(total, acc[iChain]);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, total);
+    return lanes[0] + lanes[3];
+}
+
+__attribute__((target("avx512f")))
+double peakAVX512() {
+    __m512d acc[PEAK_CHAINS];
+    volatile double rFactor = 1e-9;
+    __m512d scale = _mm512_set1_pd(rFactor);
+    ANN_UNROLL
+    for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+        acc[iChain] = _mm512_set1_pd(iChain);
+    }
+    for (int64_t iIter = 0; iIter < PEAK_ITERATIONS; ++iIter) {
+        ANN_UNROLL
+        for (int iChain = 0; iChain < PEAK_CHAINS; ++iChain) {
+            __m512d product = _mm512_mul_pd(acc[iChain], scale);
+            ANN_KEEP_PRODUCT(product);
+            acc[iChain] = _mm512_add_pd(acc[iChain], product);
+        }
+    }
+    __m512d total = acc[0];
+    for (int iChain = 1; iChain < PEAK_CHAINS; ++iChain) {
+        total = _mm512_add_pd(total, acc[iChain]);
+    }
+    double lanes[8];
+    _mm512_storeu_pd(lanes, total);
+    return lanes[0] + lanes[7];
+}
+
+#endif // ANN_KERNEL_DISPATCH
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】getTileRows
+//【函数功能】获取指定级别的寄存器分块行数
+//【参数】isa：指令集级别
+//【返回值】int64_t，行数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t PackedGemm::getTileRows(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::AVX512:
+            return 8;   // 8 zmm accumulators of the 32 registers
+        case KernelIsa::AVX2:
+            return 4;   // 8 ymm accumulators + 2 weight vectors of 16
+        case KernelIsa::SSE2:
+            return 2;   // 8 xmm accumulators + 4 weight vectors of 16
+        default:
+            return 1;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getPaddedWidth
+//【函数功能】计算输出行的最小跨度
+//【参数】width：神经元数
+//【返回值】int64_t，跨度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t PackedGemm::getPaddedWidth(int64_t width) {
+    return (width + LANES - 1) / LANES * LANES;
+}
+
+//-------------------------------------------------------------
+//【函数名称】multiply
+//【函数功能】计算一批样本的输出
+//【参数】isa：级别，panels：面板，activations：面板激活分类（可为nullptr），codes：激活函数代码，
+//       width：神经元数，inputWidth：行长度，inputs：输入，
+//       inputStride：输入跨度，rows：样本数，sums：输出，sumStride：输出跨度
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 融合激活函数
+//-------------------------------------------------------------
+void PackedGemm::multiply(KernelIsa isa, const double* panels, const PanelActivation* activations,
+                          const int32_t* codes, int64_t width, int64_t inputWidth,
+                          const double* inputs, int64_t inputStride, int64_t rows,
+                          double* sums, int64_t sumStride) {
+    if (rows <= 0 || width <= 0) {
+        return;
+    }
+    const int64_t iTileRows = getTileRows(isa);
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            multiplyBlocked<AVX512Tiles>(iTileRows, panels, activations, codes, width, inputWidth, inputs, inputStride, rows, sums, sumStride);
+            return;
+        case KernelIsa::AVX2:
+            multiplyBlocked<AVX2Tiles>(iTileRows, panels, activations, codes, width, inputWidth, inputs, inputStride, rows, sums, sumStride);
+            return;
+        case KernelIsa::SSE2:
+            multiplyBlocked<SSE2Tiles>(iTileRows, panels, activations, codes, width, inputWidth, inputs, inputStride, rows, sums, sumStride);
+            return;
+        default:
+            break;
+    }
+#endif
+    multiplyBlocked<ScalarTiles>(iTileRows, panels, activations, codes, width, inputWidth, inputs, inputStride, rows, sums, sumStride);
+}
+
+//-------------------------------------------------------------
+//【函数名称】measurePeakGflops
+//【函数功能】测量指定级别下本机的浮点峰值
+//【参数】isa：指令集级别
+//【返回值】double，GFLOP/s
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double PackedGemm::measurePeakGflops(KernelIsa isa) {
+    if (!KernelDispatch::isSupported(isa)) {
+        return 0.0;
+    }
+    int64_t iLanes = 1;
+    double rSink = 0.0;
+    auto start = chrono::steady_clock::now();
+#ifdef ANN_KERNEL_DISPATCH
+    switch (isa) {
+        case KernelIsa::AVX512:
+            iLanes = 8;
+            rSink = peakAVX512();
+            break;
+        case KernelIsa::AVX2:
+            iLanes = 4;
+            rSink = peakAVX2();
+            break;
+        case KernelIsa::SSE2:
+            iLanes = 2;
+            rSink = peakSSE2();
+            break;
+        default:
+            rSink = peakScalar();
+            break;
+    }
+#else
+    rSink = peakScalar();
+#endif
+    double rSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    // A NaN sink never happens for these inputs; the test only keeps the loop alive
+    if (rSink != rSink || rSeconds <= 0.0) {
+        return 0.0;
+    }
+    return 2.0 * PEAK_CHAINS * static_cast<double>(iLanes) * static_cast<double>(PEAK_ITERATIONS) / rSeconds * 1e-9;
+}
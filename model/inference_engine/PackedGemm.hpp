@@ -0,0 +1,86 @@
+//-------------------------------------------------------------
+//【文件名】PackedGemm.hpp
+//【功能模块和目的】批量推理使用的分块打包矩阵乘内核声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 融合激活函数
+//-------------------------------------------------------------
+
+#ifndef PackedGemm_hpp
+#define PackedGemm_hpp
+
+#include "KernelDispatch.hpp"
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】PackedGemm
+//【功能】计算一批样本经过一个稠密层后的输出：sums[r][j] = f_j(bias[j] + Σk inputs[r][k]·w[j][k])
+//【说明】权重使用KernelDispatch::packPanels在编译时生成的面板（每PANEL_WIDTH个神经元一块）。
+//       循环按BLOCK_K个输入分段：一个面板的一段（BLOCK_K×8个权重）留在L1中，
+//       依次与BLOCK_ROWS行样本相乘，这些样本的同一段留在L2中；寄存器分块为
+//       getTileRows行×PANEL_WIDTH个神经元，每个输出在整个分段中保持在寄存器里。
+//       各元素仍按偏置、输入0、输入1……的顺序逐次相乘再相加（分段之间经内存继续累加），
+//       不使用FMA，因此结果与逐样本的CompiledLayer::forward逐位一致。
+//       偏置是第一段的累加初值，激活函数在最后一段累加完成后对寄存器中的分块计算，
+//       输出矩阵只写一次，不再为偏置和激活各扫一遍。
+//       所有方法均为静态方法，可在多个线程中同时调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 融合激活函数
+//-------------------------------------------------------------
+class PackedGemm {
+public:
+    static const int64_t BLOCK_K = 256;     // 每段输入数，一个面板段为16 KiB
+    static const int64_t BLOCK_ROWS = 64;   // 与同一面板段相乘的样本行数
+
+    //-------------------------------------------------------------
+    //【函数名称】getTileRows
+    //【函数功能】获取指定级别的寄存器分块行数
+    //【参数】isa：指令集级别
+    //【返回值】int64_t，行数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int64_t getTileRows(KernelIsa isa);
+
+    //-------------------------------------------------------------
+    //【函数名称】getPaddedWidth
+    //【函数功能】计算输出行的最小跨度（神经元数向上取整到PANEL_WIDTH的倍数）
+    //【参数】width：神经元数
+    //【返回值】int64_t，跨度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int64_t getPaddedWidth(int64_t width);
+
+    //-------------------------------------------------------------
+    //【函数名称】multiply
+    //【函数功能】计算一批样本的输出（偏置、加权和与激活函数一次完成）
+    //【参数】isa：指令集级别，panels：packPanels的结果，
+    //       activations：KernelDispatch::describeActivations的结果，为nullptr时只计算加权和，
+    //       codes：激活函数代码，width：神经元数，inputWidth：行长度，
+    //       inputs：rows行输入，inputStride：输入行跨度，rows：样本数，
+    //       sums：rows行输出，sumStride：输出行跨度，不小于getPaddedWidth(width)
+    //       （末块的填充列也会被写入，其值无意义）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加activations和codes参数
+    //-------------------------------------------------------------
+    static void multiply(KernelIsa isa, const double* panels, const PanelActivation* activations,
+                         const int32_t* codes, int64_t width, int64_t inputWidth,
+                         const double* inputs, int64_t inputStride, int64_t rows,
+                         double* sums, int64_t sumStride);
+
+    //-------------------------------------------------------------
+    //【函数名称】measurePeakGflops
+    //【函数功能】测量指定级别下本机的浮点峰值：在寄存器中运行与内核相同的乘、加指令组合
+    //           （不使用FMA，足够多的独立累加链），作为multiply吞吐率的理论上限
+    //【参数】isa：指令集级别
+    //【返回值】double，每秒十亿次浮点运算数，级别不受支持时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static double measurePeakGflops(KernelIsa isa);
+};
+
+#endif // PackedGemm_hpp
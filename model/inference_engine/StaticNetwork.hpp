@@ -0,0 +1,391 @@
+//-------------------------------------------------------------
+//【文件名】StaticNetwork.hpp
+//【功能模块和目的】层宽度为模板参数的固定拓扑网络（仅头文件）
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef StaticNetwork_hpp
+#define StaticNetwork_hpp
+
+#include "CompiledNetwork.hpp"
+#include "../neural_components/Network.hpp"
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】StaticActivation
+//【功能】编译期选择的激活函数，公式与CompiledLayer::applyActivation逐位一致
+//【说明】Code为激活函数代码：0 Linear，1 Sigmoid，2 Tanh，3 ReLU
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+template <int32_t Code>
+struct StaticActivation {
+    static double apply(double x) { return x; }
+};
+
+template <>
+struct StaticActivation<1> {
+    static double apply(double x) { return 1.0 / (1.0 + exp(-x)); }
+};
+
+template <>
+struct StaticActivation<2> {
+    static double apply(double x) {
+        double rEx = exp(x);
+        double rENegX = exp(-x);
+        return (rEx - rENegX) / (rEx + rENegX);
+    }
+};
+
+template <>
+struct StaticActivation<3> {
+    static double apply(double x) { return max(0.0, x); }
+};
+
+//-------------------------------------------------------------
+//【类名】StaticLayer
+//【功能】宽度和行长度为编译期常量的稠密层，数据存放在std::array中
+//【说明】Elementwise为true时是输入层（神经元j读取输入j，每个神经元一个权重）。
+//       整层激活函数相同时在层外选择一次，内层循环按激活函数类型实例化；
+//       激活函数混合的层逐神经元选择
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+template <int Width, int InputWidth, bool Elementwise>
+class StaticLayer {
+    static_assert(Width > 0 && InputWidth > 0, "Layer widths must be positive");
+
+private:
+    static const int WEIGHT_COUNT = Elementwise ? Width : Width * InputWidth;
+
+    array<double, Width> m_biases;           // One bias per neuron
+    array<double, WEIGHT_COUNT> m_weights;   // Row-major, InputWidth per row
+    array<int32_t, Width> m_activationCodes; // One code per neuron
+    int32_t m_iUniformCode;                  // Shared code, -1 when the layer mixes functions
+
+    //-------------------------------------------------------------
+    //【函数名称】run
+    //【函数功能】以编译期确定的激活函数计算整层
+    //【参数】inputs：输入，outputs：Width个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    template <int32_t Code>
+    void run(const double* inputs, double* outputs) const {
+        for (int iNeuronIdx = 0; iNeuronIdx < Width; ++iNeuronIdx) {
+            outputs[iNeuronIdx] = StaticActivation<Code>::apply(weightedSum(inputs, iNeuronIdx));
+        }
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】weightedSum
+    //【函数功能】计算一个神经元的加权和（偏置在先，与Neuron::computeOutput顺序相同）
+    //【参数】inputs：输入，neuronIndex：神经元索引
+    //【返回值】double，加权和
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double weightedSum(const double* inputs, int neuronIndex) const {
+        double rSum = m_biases[neuronIndex];
+        if (Elementwise) {
+            rSum += inputs[neuronIndex] * m_weights[neuronIndex];
+        } else {
+            const double* pRow = m_weights.data() + neuronIndex * InputWidth;
+            for (int iInputIdx = 0; iInputIdx < InputWidth; ++iInputIdx) {
+                rSum += inputs[iInputIdx] * pRow[iInputIdx];
+            }
+        }
+        return rSum;
+    }
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】StaticLayer
+    //【函数功能】默认构造函数，创建全零的线性层
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    StaticLayer() : m_iUniformCode(0) {
+        m_biases.fill(0.0);
+        m_weights.fill(0.0);
+        m_activationCodes.fill(0);
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】load
+    //【函数功能】从编译后的层复制数据，宽度和行长度必须与模板参数一致
+    //【参数】layer：编译后的层
+    //【返回值】bool，拓扑一致返回true；失败时本层不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool load(const CompiledLayer& layer) {
+        if (layer.getWidth() != Width || layer.isElementwise() != Elementwise ||
+            (!Elementwise && layer.getInputWidth() != InputWidth)) {
+            return false;
+        }
+        copy(layer.getBiases().begin(), layer.getBiases().end(), m_biases.begin());
+        copy(layer.getWeights().begin(), layer.getWeights().end(), m_weights.begin());
+        copy(layer.getActivationCodes().begin(), layer.getActivationCodes().end(), m_activationCodes.begin());
+        m_iUniformCode = m_activationCodes[0];
+        for (int32_t iCode : m_activationCodes) {
+            if (iCode != m_iUniformCode) {
+                m_iUniformCode = -1;
+            }
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】forward
+    //【函数功能】计算本层输出
+    //【参数】inputs：输入（输入层Width个，其余InputWidth个），outputs：Width个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void forward(const double* inputs, double* outputs) const {
+        switch (m_iUniformCode) {
+            case 0:
+                run<0>(inputs, outputs);
+                break;
+            case 1:
+                run<1>(inputs, outputs);
+                break;
+            case 2:
+                run<2>(inputs, outputs);
+                break;
+            case 3:
+                run<3>(inputs, outputs);
+                break;
+            default:
+                for (int iNeuronIdx = 0; iNeuronIdx < Width; ++iNeuronIdx) {
+                    outputs[iNeuronIdx] = CompiledLayer::applyActivation(m_activationCodes[iNeuronIdx],
+                                                                         weightedSum(inputs, iNeuronIdx));
+                }
+                break;
+        }
+    }
+};
+
+//-------------------------------------------------------------
+//【类名】StaticLayerChain
+//【功能】输入层之后各层的递归组合，Previous为前一层宽度
+//【说明】中间结果存放在栈上的定长数组中；没有后续层时直接复制输入
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+template <int Previous, int... Widths>
+class StaticLayerChain {
+public:
+    static const int OUTPUT_SIZE = Previous;
+
+    //-------------------------------------------------------------
+    //【函数名称】load
+    //【函数功能】链尾无层可加载
+    //【参数】network：编译后的网络，layerIndex：层索引
+    //【返回值】bool，总是true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool load(const CompiledNetwork& network, int layerIndex) {
+        (void)network;
+        (void)layerIndex;
+        return true;
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】forward
+    //【函数功能】链尾直接复制输入（仅单层网络会用到）
+    //【参数】inputs：Previous个输入，outputs：Previous个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void forward(const double* inputs, double* outputs) const {
+        copy(inputs, inputs + Previous, outputs);
+    }
+};
+
+template <int Previous, int Width, int... Rest>
+class StaticLayerChain<Previous, Width, Rest...> {
+private:
+    StaticLayer<Width, Previous, false> m_layer;  // This layer
+    StaticLayerChain<Width, Rest...> m_next;      // Layers after it
+
+public:
+    static const int OUTPUT_SIZE = StaticLayerChain<Width, Rest...>::OUTPUT_SIZE;
+
+    //-------------------------------------------------------------
+    //【函数名称】load
+    //【函数功能】从编译后的网络加载本层及后续层
+    //【参数】network：编译后的网络，layerIndex：本层索引
+    //【返回值】bool，拓扑一致返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool load(const CompiledNetwork& network, int layerIndex) {
+        const CompiledLayer* pLayer = network.getLayer(layerIndex);
+        return pLayer && m_layer.load(*pLayer) && m_next.load(network, layerIndex + 1);
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】forward
+    //【函数功能】计算本层及后续层
+    //【参数】inputs：Previous个输入，outputs：OUTPUT_SIZE个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void forward(const double* inputs, double* outputs) const {
+        if (sizeof...(Rest) == 0) {
+            m_layer.forward(inputs, outputs);
+        } else {
+            double activations[Width];
+            m_layer.forward(inputs, activations);
+            m_next.forward(activations, outputs);
+        }
+    }
+};
+
+//-------------------------------------------------------------
+//【类名】StaticNetwork
+//【功能】层宽度在编译期确定的前馈网络，与动态Network并存，用于维度固定的小模型
+//【说明】StaticNetwork<5, 4, 3, 2>表示输入层5个神经元、输出层2个神经元的四层网络。
+//       全部参数存放在对象内部的std::array中，层循环的次数均为常量，编译器可完全内联和向量化；
+//       中间结果位于栈上，宽度很大的网络应改用CompiledNetwork。
+//       通过loadFrom或构造函数从Network加载，层数和每层宽度须与模板参数一致；
+//       推理结果与Network::predict逐位一致。predict为const，可在多个线程中同时调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+template <int InputWidth, int... Widths>
+class StaticNetwork {
+private:
+    typedef StaticLayerChain<InputWidth, Widths...> Chain;
+
+    StaticLayer<InputWidth, 1, true> m_inputLayer;  // Elementwise input layer
+    Chain m_layers;                                 // Remaining layers
+
+public:
+    static const int INPUT_SIZE = InputWidth;                  // 输入长度
+    static const int OUTPUT_SIZE = Chain::OUTPUT_SIZE;         // 输出长度
+    static const int LAYER_COUNT = 1 + sizeof...(Widths);      // 层数
+
+    //-------------------------------------------------------------
+    //【函数名称】StaticNetwork
+    //【函数功能】默认构造函数，创建全零的线性网络
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    StaticNetwork() = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】StaticNetwork
+    //【函数功能】从已加载的网络构造
+    //【参数】network：源网络
+    //【返回值】无；拓扑与模板参数不一致或网络无效时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit StaticNetwork(const Network& network) {
+        if (!loadFrom(network)) {
+            throw runtime_error("Network topology does not match the static layer widths");
+        }
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】loadFrom
+    //【函数功能】检查拓扑后从网络加载全部参数
+    //【参数】network：源网络
+    //【返回值】bool，网络有效且层数、各层宽度与模板参数一致返回true；失败时本对象不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool loadFrom(const Network& network) {
+        if (network.getLayerCount() != LAYER_COUNT) {
+            return false;
+        }
+        CompiledNetwork compiled;
+        if (!compiled.compile(network)) {
+            return false;
+        }
+        // Load into a copy so that a mismatch deeper in the chain leaves this object untouched
+        StaticNetwork candidate(*this);
+        if (!candidate.m_inputLayer.load(*compiled.getLayer(0)) || !candidate.m_layers.load(compiled, 1)) {
+            return false;
+        }
+        *this = candidate;
+        return true;
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】计算网络输出
+    //【参数】inputs：INPUT_SIZE个输入，outputs：OUTPUT_SIZE个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void predict(const double* inputs, double* outputs) const {
+        double activations[InputWidth];
+        m_inputLayer.forward(inputs, activations);
+        m_layers.forward(activations, outputs);
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】计算网络输出（定长数组版本）
+    //【参数】inputs：输入数组
+    //【返回值】array<double, OUTPUT_SIZE>，输出数组
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    array<double, OUTPUT_SIZE> predict(const array<double, InputWidth>& inputs) const {
+        array<double, OUTPUT_SIZE> outputs;
+        predict(inputs.data(), outputs.data());
+        return outputs;
+    }
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】计算网络输出（与Network::predict相同的向量接口）
+    //【参数】inputs：输入向量
+    //【返回值】vector<double>，输出向量；长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predict(const vector<double>& inputs) const {
+        if (inputs.size() != static_cast<size_t>(InputWidth)) {
+            throw runtime_error("Input size mismatch with first layer neuron count");
+        }
+        vector<double> outputs(static_cast<size_t>(OUTPUT_SIZE));
+        predict(inputs.data(), outputs.data());
+        return outputs;
+    }
+};
+
+// Definitions for the static constants so that they may be bound to references
+template <int InputWidth, int... Widths>
+const int StaticNetwork<InputWidth, Widths...>::INPUT_SIZE;
+
+template <int InputWidth, int... Widths>
+const int StaticNetwork<InputWidth, Widths...>::OUTPUT_SIZE;
+
+template <int InputWidth, int... Widths>
+const int StaticNetwork<InputWidth, Widths...>::LAYER_COUNT;
+
+#endif // StaticNetwork_hpp
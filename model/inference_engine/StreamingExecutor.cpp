@@ -0,0 +1,253 @@
+//-------------------------------------------------------------
+//【文件名】StreamingExecutor.cpp
+//【功能模块和目的】逐层流式读取权重的外存推理执行器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "StreamingExecutor.hpp"
+#include "BinaryModelFormat.hpp"
+#include <future>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】StreamingExecutor
+//【函数功能】默认构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+StreamingExecutor::StreamingExecutor() : m_bPrefetchEnabled(true), m_iPeakResidentBytes(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~StreamingExecutor
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+StreamingExecutor::~StreamingExecutor() = default;
+
+//-------------------------------------------------------------
+//【函数名称】open
+//【函数功能】打开模型文件并读取层表
+//【参数】filename：模型文件路径
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool StreamingExecutor::open(const string& filename) {
+    close();
+
+    m_file.open(filename, ios::in | ios::binary);
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    if (!BinaryModelFormat::readHeader(m_file, m_offsets, m_widths, m_inputWidths)) {
+        close();
+        return false;
+    }
+
+    m_filename = filename;
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】close
+//【函数功能】关闭模型文件并释放缓冲区
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void StreamingExecutor::close() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_file.clear();
+    m_filename.clear();
+    m_offsets.clear();
+    m_widths.clear();
+    m_inputWidths.clear();
+    m_buffers[0] = CompiledLayer();
+    m_buffers[1] = CompiledLayer();
+    m_iPeakResidentBytes = 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isOpen
+//【函数功能】判断是否已打开模型
+//【参数】无
+//【返回值】bool，已打开返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool StreamingExecutor::isOpen() const {
+    return m_file.is_open() && !m_widths.empty();
+}
+
+//-------------------------------------------------------------
+//【函数名称】readLayer
+//【函数功能】将指定层读入缓冲区并核对尺寸
+//【参数】layerIndex：层索引，target：目标缓冲区
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 不生成向量内核面板，保持内存上限
+//-------------------------------------------------------------
+bool StreamingExecutor::readLayer(int64_t layerIndex, CompiledLayer& target) {
+    size_t uLayerIdx = static_cast<size_t>(layerIndex);
+    m_file.clear();
+    m_file.seekg(static_cast<streamoff>(m_offsets[uLayerIdx]));
+    // No vector panels: they would double the two resident layers
+    if (!target.readFrom(m_file, layerIndex == 0, false)) {
+        return false;
+    }
+    return target.getWidth() == m_widths[uLayerIdx] && target.getInputWidth() == m_inputWidths[uLayerIdx];
+}
+
+//-------------------------------------------------------------
+//【函数名称】predict
+//【函数功能】逐层读取权重并执行前向传播
+//【参数】inputs：输入向量
+//【返回值】vector<double>，输出层结果
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> StreamingExecutor::predict(const vector<double>& inputs) {
+    if (!isOpen()) {
+        throw runtime_error("No compiled model opened");
+    }
+    if (static_cast<int64_t>(inputs.size()) != m_widths[0]) {
+        throw runtime_error("Input size mismatch with first layer neuron count");
+    }
+    if (!readLayer(0, m_buffers[0])) {
+        throw runtime_error("Failed to read layer 0 of " + m_filename);
+    }
+
+    vector<double> current(inputs);
+    vector<double> next;
+    size_t uLayerCount = m_widths.size();
+    for (size_t uLayerIdx = 0; uLayerIdx < uLayerCount; ++uLayerIdx) {
+        CompiledLayer& layer = m_buffers[uLayerIdx % 2];
+        CompiledLayer& upcoming = m_buffers[(uLayerIdx + 1) % 2];
+        bool bHasNext = uLayerIdx + 1 < uLayerCount;
+        int64_t iNextIdx = static_cast<int64_t>(uLayerIdx + 1);
+
+        // Start reading the next layer into the idle buffer before computing this one
+        future<bool> prefetch;
+        if (bHasNext && m_bPrefetchEnabled) {
+            prefetch = async(launch::async, &StreamingExecutor::readLayer, this, iNextIdx, ref(upcoming));
+        }
+
+        next.assign(static_cast<size_t>(layer.getWidth()), 0.0);
+        layer.forward(current.data(), next.data());
+        current.swap(next);
+
+        bool bLoaded = true;
+        if (bHasNext) {
+            bLoaded = m_bPrefetchEnabled ? prefetch.get() : readLayer(iNextIdx, upcoming);
+        }
+        m_iPeakResidentBytes = max(m_iPeakResidentBytes, layer.getResidentBytes() + upcoming.getResidentBytes());
+        if (!bLoaded) {
+            throw runtime_error("Failed to read layer " + to_string(iNextIdx) + " of " + m_filename);
+        }
+    }
+
+    return current;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setPrefetchEnabled
+//【函数功能】设置是否后台预取下一层
+//【参数】enabled：是否启用
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void StreamingExecutor::setPrefetchEnabled(bool enabled) {
+    m_bPrefetchEnabled = enabled;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isPrefetchEnabled
+//【函数功能】查询是否启用预取
+//【参数】无
+//【返回值】bool，是否启用预取
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool StreamingExecutor::isPrefetchEnabled() const {
+    return m_bPrefetchEnabled;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLayerCount
+//【函数功能】获取模型层数
+//【参数】无
+//【返回值】int64_t，层数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t StreamingExecutor::getLayerCount() const {
+    return static_cast<int64_t>(m_widths.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取输入层宽度
+//【参数】无
+//【返回值】int64_t，输入长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t StreamingExecutor::getInputSize() const {
+    return m_widths.empty() ? 0 : m_widths.front();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOutputSize
+//【函数功能】获取输出层宽度
+//【参数】无
+//【返回值】int64_t，输出长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t StreamingExecutor::getOutputSize() const {
+    return m_widths.empty() ? 0 : m_widths.back();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getModelBytes
+//【函数功能】获取全部层权重块的总字节数
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t StreamingExecutor::getModelBytes() const {
+    int64_t iTotal = 0;
+    for (size_t uLayerIdx = 0; uLayerIdx < m_widths.size(); ++uLayerIdx) {
+        iTotal += CompiledLayer::getBlockSize(m_widths[uLayerIdx], m_inputWidths[uLayerIdx]);
+    }
+    return iTotal;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getPeakResidentBytes
+//【函数功能】获取两个层缓冲区合计占用的最大字节数
+//【参数】无
+//【返回值】int64_t，字节数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t StreamingExecutor::getPeakResidentBytes() const {
+    return m_iPeakResidentBytes;
+}
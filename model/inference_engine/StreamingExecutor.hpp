@@ -0,0 +1,201 @@
+//-------------------------------------------------------------
+//【文件名】StreamingExecutor.hpp
+//【功能模块和目的】逐层流式读取权重的外存推理执行器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef StreamingExecutor_hpp
+#define StreamingExecutor_hpp
+
+#include "CompiledLayer.hpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】StreamingExecutor
+//【功能】对.annb编译模型执行推理，内存中最多同时驻留两层权重
+//【说明】open只读取文件头；predict计算第i层时在后台线程读取第i+1层（双缓冲预取），
+//       两个缓冲区交替复用，因此驻留内存不超过最大一层的两倍，与网络总大小无关。
+//       文件在执行器存在期间保持打开且不得被修改
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class StreamingExecutor {
+private:
+    string m_filename;                 // Path of the opened model
+    ifstream m_file;                   // Read only by one thread at a time
+    vector<int64_t> m_offsets;         // Block offset of each layer
+    vector<int64_t> m_widths;          // Neuron count of each layer
+    vector<int64_t> m_inputWidths;     // Row length of each layer
+    CompiledLayer m_buffers[2];        // Current layer and the layer being prefetched
+    bool m_bPrefetchEnabled;           // Read the next layer on a background thread
+    int64_t m_iPeakResidentBytes;      // Largest combined size of both buffers so far
+
+    //-------------------------------------------------------------
+    //【函数名称】readLayer
+    //【函数功能】将指定层读入缓冲区并核对其尺寸与层表一致
+    //【参数】layerIndex：层索引，target：目标缓冲区
+    //【返回值】bool，读取成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 不生成向量内核面板，保持内存上限
+    //-------------------------------------------------------------
+    bool readLayer(int64_t layerIndex, CompiledLayer& target);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】StreamingExecutor
+    //【函数功能】默认构造函数，创建未打开模型的执行器
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    StreamingExecutor();
+
+    //-------------------------------------------------------------
+    //【函数名称】StreamingExecutor（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，执行器持有文件句柄）
+    //【参数】other：被拷贝的执行器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    StreamingExecutor(const StreamingExecutor& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源执行器
+    //【返回值】StreamingExecutor&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    StreamingExecutor& operator=(const StreamingExecutor& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~StreamingExecutor
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~StreamingExecutor();
+
+    //-------------------------------------------------------------
+    //【函数名称】open
+    //【函数功能】打开.annb模型文件并读取层表，不读取任何权重
+    //【参数】filename：模型文件路径
+    //【返回值】bool，文件头合法返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool open(const string& filename);
+
+    //-------------------------------------------------------------
+    //【函数名称】close
+    //【函数功能】关闭模型文件并释放缓冲区
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void close();
+
+    //-------------------------------------------------------------
+    //【函数名称】isOpen
+    //【函数功能】判断是否已打开模型
+    //【参数】无
+    //【返回值】bool，已打开返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isOpen() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】逐层读取权重并执行前向传播，结果与Network::predict一致
+    //【参数】inputs：输入向量，长度须等于输入层宽度
+    //【返回值】vector<double>，输出层结果；未打开、输入长度不符或读取失败时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predict(const vector<double>& inputs);
+
+    //-------------------------------------------------------------
+    //【函数名称】setPrefetchEnabled
+    //【函数功能】设置是否在计算当前层时后台预取下一层
+    //【参数】enabled：true启用（默认），false在单线程中顺序读取
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setPrefetchEnabled(bool enabled);
+
+    //-------------------------------------------------------------
+    //【函数名称】isPrefetchEnabled
+    //【函数功能】查询是否启用预取
+    //【参数】无
+    //【返回值】bool，是否启用预取
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isPrefetchEnabled() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getLayerCount
+    //【函数功能】获取模型层数
+    //【参数】无
+    //【返回值】int64_t，层数，未打开时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getLayerCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取输入层宽度
+    //【参数】无
+    //【返回值】int64_t，输入长度，未打开时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getOutputSize
+    //【函数功能】获取输出层宽度
+    //【参数】无
+    //【返回值】int64_t，输出长度，未打开时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getOutputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getModelBytes
+    //【函数功能】获取全部层权重块的总字节数
+    //【参数】无
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getModelBytes() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getPeakResidentBytes
+    //【函数功能】获取推理过程中两个层缓冲区合计占用的最大字节数
+    //【参数】无
+    //【返回值】int64_t，字节数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getPeakResidentBytes() const;
+};
+
+#endif // StreamingExecutor_hpp
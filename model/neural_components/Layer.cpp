@@ -250,12 +250,12 @@ void Layer::clear() {
 //【函数名称】getTotalSynapseCount
 //【函数功能】获取本层所有突触数量
 //【参数】无
-//【返回值】int，突触数量
+//【返回值】int64_t，突触数量
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 返回值改为int64_t
 //-------------------------------------------------------------
-int Layer::getTotalSynapseCount() const {
-    int iTotalSynapses = 0;
+int64_t Layer::getTotalSynapseCount() const {
+    int64_t iTotalSynapses = 0;
     for (const auto& neuron : m_neurons) {
         // Count input synapses to avoid double counting internal connections
         iTotalSynapses += neuron->getInputSynapseCount();
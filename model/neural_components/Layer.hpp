@@ -10,6 +10,7 @@
 
 #include "Neuron.hpp"
 #include <vector>
+#include <cstdint>
 #include <memory>
 
 using namespace std;
@@ -180,11 +181,11 @@ public:
     //【函数名称】getTotalSynapseCount
     //【函数功能】获取本层所有突触数量
     //【参数】无
-    //【返回值】int，突触数量
+    //【返回值】int64_t，突触数量
     //【开发者及日期】林钲凯 2025-07-27
-    //【更改记录】
+    //【更改记录】2026-10-18 返回值改为int64_t
     //-------------------------------------------------------------
-    int getTotalSynapseCount() const;
+    int64_t getTotalSynapseCount() const;
 
     //-------------------------------------------------------------
     //【函数名称】connectToLayer
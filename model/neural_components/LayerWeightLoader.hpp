@@ -0,0 +1,119 @@
+//-------------------------------------------------------------
+//【文件名】LayerWeightLoader.hpp
+//【功能模块和目的】按层延迟加载突触权重的抽象接口声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef LayerWeightLoader_hpp
+#define LayerWeightLoader_hpp
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class Network;
+
+//-------------------------------------------------------------
+//【类名】LayerWeightLoader
+//【功能】为延迟加载的网络按需生成某一层的突触
+//【说明】一层"拥有"的突触为：其神经元的全部树突，以及其神经元指向外部输出的轴突。
+//       结构信息（突触数量、参与情况、是否前馈）由导入时的索引给出，无需加载权重
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class LayerWeightLoader {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】LayerWeightLoader
+    //【函数功能】默认构造函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    LayerWeightLoader() = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】LayerWeightLoader（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，加载器持有数据源）
+    //【参数】other：被拷贝的加载器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    LayerWeightLoader(const LayerWeightLoader& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源加载器
+    //【返回值】LayerWeightLoader&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    LayerWeightLoader& operator=(const LayerWeightLoader& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~LayerWeightLoader
+    //【函数功能】虚析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual ~LayerWeightLoader() = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】loadLayerWeights
+    //【函数功能】生成指定层拥有的全部突触（每层只会被调用一次）
+    //【参数】network：目标网络，layerIndex：层索引
+    //【返回值】bool，加载成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool loadLayerWeights(Network& network, int layerIndex) = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】getTargetLayers
+    //【函数功能】获取接收指定层连接的层（加载这些层才会生成本层的轴突）
+    //【参数】layerIndex：层索引
+    //【返回值】vector<int>，目标层索引
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual vector<int> getTargetLayers(int layerIndex) const = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】getLayerSynapseCount
+    //【函数功能】获取指定层加载后的突触数量（与Layer::getTotalSynapseCount口径一致）
+    //【参数】layerIndex：层索引
+    //【返回值】int64_t，突触数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual int64_t getLayerSynapseCount(int layerIndex) const = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】isNeuronConnected
+    //【函数功能】判断神经元加载后是否至少有一个输入或输出突触
+    //【参数】layerIndex：层索引，neuronIndex：层内神经元索引
+    //【返回值】bool，有连接返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool isNeuronConnected(int layerIndex, int neuronIndex) const = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】isFeedForward
+    //【函数功能】判断所有神经元间连接是否都指向更靠后的层（此时网络必无环）
+    //【参数】无
+    //【返回值】bool，严格前馈返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool isFeedForward() const = 0;
+};
+
+#endif // LayerWeightLoader_hpp
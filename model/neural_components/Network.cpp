@@ -13,6 +13,7 @@
 #include <queue>
 #include <map>
 #include <functional>
+#include <cstring>
 
 using namespace std;
 
@@ -24,7 +25,7 @@ using namespace std;
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-Network::Network() : m_name("Unnamed Network"), 
+Network::Network() : m_name("Unnamed Network"), m_inferenceEngine(InferenceEngine::Compiled),
                  m_hasImportErrors(false), m_importErrorMessage(""), m_validationCacheValid(false) {
 }
 
@@ -36,7 +37,7 @@ Network::Network() : m_name("Unnamed Network"),
 //【开发者及日期】林钲凯 2025-07-27
 //【更改记录】
 //-------------------------------------------------------------
-Network::Network(const string& name) : m_name(name), 
+Network::Network(const string& name) : m_name(name), m_inferenceEngine(InferenceEngine::Compiled),
                                   m_hasImportErrors(false), m_importErrorMessage(""), m_validationCacheValid(false) {
 }
 
@@ -46,15 +47,19 @@ Network::Network(const string& name) : m_name(name),
 //【参数】other：待拷贝的网络对象
 //【返回值】无
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 拷贝前先加载源网络的全部层
+//           2026-10-18 一并复制推理引擎选择
+//           2026-10-18 副本的突触改为指向副本中的神经元
 //-------------------------------------------------------------
-Network::Network(const Network& other) : m_name(other.m_name), 
+Network::Network(const Network& other) : m_name(other.m_name), m_inferenceEngine(other.m_inferenceEngine),
                                    m_hasImportErrors(other.m_hasImportErrors), 
                                    m_importErrorMessage(other.m_importErrorMessage),
                                    m_validationCacheValid(other.m_validationCacheValid) {
+    other.loadAllLayers();
     for (const auto& layer : other.m_layers) {
         m_layers.push_back(unique_ptr<Layer>(new Layer(*layer)));
     }
+    relinkCopiedLayers(other);
 }
 
 //-------------------------------------------------------------
@@ -63,22 +68,53 @@ Network::Network(const Network& other) : m_name(other.m_name),
 //【参数】other：待赋值的网络对象
 //【返回值】当前对象的引用
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 拷贝前先加载源网络的全部层
+//           2026-10-18 一并复制推理引擎选择
+//           2026-10-18 副本的突触改为指向副本中的神经元
 //-------------------------------------------------------------
 Network& Network::operator=(const Network& other) {
     if (this != &other) {
         m_name = other.m_name;
+        m_inferenceEngine = other.m_inferenceEngine;
         m_hasImportErrors = other.m_hasImportErrors;
         m_importErrorMessage = other.m_importErrorMessage;
         m_validationCacheValid = other.m_validationCacheValid;
+        other.loadAllLayers();
+        m_weightLoader.reset();
+        m_layerLoaded.clear();
         m_layers.clear();
         for (const auto& layer : other.m_layers) {
             m_layers.push_back(unique_ptr<Layer>(new Layer(*layer)));
         }
+        relinkCopiedLayers(other);
     }
     return *this;
 }
 
+//-------------------------------------------------------------
+//【函数名称】relinkCopiedLayers
+//【函数功能】把副本突触的端点改为副本中的神经元
+//【参数】other：源网络
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Network::relinkCopiedLayers(const Network& other) {
+    // Copied synapses still point at the source network's neurons
+    map<const Neuron*, Neuron*> neurons;
+    for (size_t uLayerIdx = 0; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        const Layer& source = *other.m_layers[uLayerIdx];
+        for (int iNeuronIdx = 0; iNeuronIdx < source.getNeuronCount(); ++iNeuronIdx) {
+            neurons[source.getNeuron(iNeuronIdx)] = m_layers[uLayerIdx]->getNeuron(iNeuronIdx);
+        }
+    }
+    for (const auto& layer : m_layers) {
+        for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
+            layer->getNeuron(iNeuronIdx)->remapSynapses(neurons);
+        }
+    }
+}
+
 //-------------------------------------------------------------
 //【函数名称】~Network
 //【函数功能】析构函数
@@ -119,9 +155,10 @@ void Network::setName(const string& name) {
 //【参数】layer：待添加的层
 //【返回值】无
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改结构前先加载全部层
 //-------------------------------------------------------------
 void Network::addLayer(unique_ptr<Layer> layer) {
+    loadAllLayers();
     if (layer) {
         m_layers.push_back(move(layer));
     }
@@ -133,9 +170,10 @@ void Network::addLayer(unique_ptr<Layer> layer) {
 //【参数】index：层的索引
 //【返回值】成功移除返回true，失败返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改结构前先加载全部层
 //-------------------------------------------------------------
 bool Network::removeLayer(int index) {
+    loadAllLayers();
     if (index >= 0 && index < static_cast<int>(m_layers.size())) {
         // Disconnect the layer before removing it
         m_layers[index]->disconnectAll();
@@ -151,10 +189,11 @@ bool Network::removeLayer(int index) {
 //【参数】index：层的索引
 //【返回值】对应层的指针，失败返回nullptr
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 按需加载该层突触
 //-------------------------------------------------------------
 Layer* Network::getLayer(int index) {
     if (index >= 0 && index < static_cast<int>(m_layers.size())) {
+        ensureLayerLoaded(index);
         return m_layers[index].get();
     }
     return nullptr;
@@ -166,15 +205,40 @@ Layer* Network::getLayer(int index) {
 //【参数】index：层的索引
 //【返回值】对应层的指针，失败返回nullptr
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 按需加载该层突触
 //-------------------------------------------------------------
 const Layer* Network::getLayer(int index) const {
     if (index >= 0 && index < static_cast<int>(m_layers.size())) {
+        ensureLayerLoaded(index);
         return m_layers[index].get();
     }
     return nullptr;
 }
 
+//-------------------------------------------------------------
+//【函数名称】getInferenceEngine
+//【函数功能】获取编译后推理使用的执行引擎
+//【参数】无
+//【返回值】InferenceEngine，执行引擎
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+InferenceEngine Network::getInferenceEngine() const {
+    return m_inferenceEngine;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setInferenceEngine
+//【函数功能】设置编译后推理使用的执行引擎
+//【参数】engine：执行引擎
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Network::setInferenceEngine(InferenceEngine engine) {
+    m_inferenceEngine = engine;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getLayerCount
 //【函数功能】获取层的数量
@@ -187,16 +251,31 @@ int Network::getLayerCount() const {
     return static_cast<int>(m_layers.size());
 }
 
+//-------------------------------------------------------------
+//【函数名称】getLayerNeuronCount
+//【函数功能】获取指定层的神经元数量（不触发延迟加载）
+//【参数】index：层的索引
+//【返回值】神经元数量，索引无效返回-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int Network::getLayerNeuronCount(int index) const {
+    if (index >= 0 && index < static_cast<int>(m_layers.size())) {
+        return m_layers[index]->getNeuronCount();
+    }
+    return -1;
+}
+
 //-------------------------------------------------------------
 //【函数名称】getNeuronCount
 //【函数功能】获取神经元的总数量
 //【参数】无
 //【返回值】神经元的总数量
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 返回值改为int64_t
 //-------------------------------------------------------------
-int Network::getNeuronCount() const {
-    int iTotalNeurons = 0;
+int64_t Network::getNeuronCount() const {
+    int64_t iTotalNeurons = 0;
     for (const auto& layer : m_layers) {
         iTotalNeurons += layer->getNeuronCount();
     }
@@ -209,12 +288,19 @@ int Network::getNeuronCount() const {
 //【参数】无
 //【返回值】突触的总数量
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
-//-------------------------------------------------------------
-int Network::getSynapseCount() const {
-    int iTotalSynapses = 0;
-    for (const auto& layer : m_layers) {
-        iTotalSynapses += layer->getTotalSynapseCount();
+//【更改记录】2026-10-18 未加载的层使用加载器索引中的突触数量；返回值改为int64_t
+//           2026-10-18 读取加载状态时加锁
+//-------------------------------------------------------------
+int64_t Network::getSynapseCount() const {
+    lock_guard<recursive_mutex> lock(m_loadMutex);
+    int64_t iTotalSynapses = 0;
+    for (size_t uLayerIdx = 0; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        if (m_weightLoader && !m_layerLoaded[uLayerIdx]) {
+            // Not loaded yet: the loader's index already knows the count
+            iTotalSynapses += m_weightLoader->getLayerSynapseCount(static_cast<int>(uLayerIdx));
+        } else {
+            iTotalSynapses += m_layers[uLayerIdx]->getTotalSynapseCount();
+        }
     }
     return iTotalSynapses;
 }
@@ -225,7 +311,8 @@ int Network::getSynapseCount() const {
 //【参数】无
 //【返回值】有效返回true， 无效返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 延迟加载且尚未加载任何层时使用加载器索引验证
+//           2026-10-18 读取加载状态时加锁
 //-------------------------------------------------------------
 bool Network::isValid() const {
     // Check for cached import errors first
@@ -255,6 +342,25 @@ bool Network::isValid() const {
         return false;
     }
     
+    // Lazily loaded network: answer from the loader's index while nothing has been loaded.
+    // Once layers are loaded they may have been edited, so check the real structure instead.
+    unique_lock<recursive_mutex> lock(m_loadMutex);
+    if (m_weightLoader && (getLoadedLayerCount() > 0 || !m_weightLoader->isFeedForward())) {
+        loadAllLayers();
+    }
+    if (m_weightLoader) {
+        // Strictly feed-forward, hence acyclic; axon weights were checked by the importer
+        for (size_t uLayerIdx = 1; uLayerIdx + 1 < m_layers.size(); ++uLayerIdx) {
+            for (int iNeuronIdx = 0; iNeuronIdx < m_layers[uLayerIdx]->getNeuronCount(); ++iNeuronIdx) {
+                if (!m_weightLoader->isNeuronConnected(static_cast<int>(uLayerIdx), iNeuronIdx)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    lock.unlock();
+    
     // Check for cycles (not allowed in feedforward networks)
     if (hasCycles()) {
         return false;
@@ -292,9 +398,12 @@ bool Network::isValid() const {
 //【参数】inputs：输入数据
 //【返回值】预测结果
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 推理前加载全部层
 //-------------------------------------------------------------
 vector<double> Network::predict(const vector<double>& inputs) {
+    // Inference touches every layer
+    loadAllLayers();
+    
     if (!isValid()) {
         throw runtime_error("Network is not valid for inference");
     }
@@ -382,9 +491,11 @@ void Network::resetComputationState() {
 //【参数】无
 //【返回值】无
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 同时丢弃权重加载器
 //-------------------------------------------------------------
 void Network::clear() {
+    m_weightLoader.reset();
+    m_layerLoaded.clear();
     m_layers.clear();
 }
 
@@ -394,10 +505,11 @@ void Network::clear() {
 //【参数】defaultWeight：默认权重
 //【返回值】成功连接返回true，失败返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改结构前先加载全部层
 //-------------------------------------------------------------
 bool Network::connectAllLayers(double defaultWeight) {
     (void)defaultWeight; // Suppress unused parameter warning
+    loadAllLayers();
     if (m_layers.size() < 2) {
         return true; // Nothing to connect
     }
@@ -417,7 +529,7 @@ bool Network::connectAllLayers(double defaultWeight) {
 //【参数】无
 //【返回值】网络结构信息字符串
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 只读取神经元数量，不触发延迟加载
 //-------------------------------------------------------------
 string Network::getStructureInfo() const {
     ostringstream oss;
@@ -428,13 +540,106 @@ string Network::getStructureInfo() const {
     oss << "Valid: " << (isValid() ? "Yes" : "No") << "\n";
     
     for (int iLayerIdx = 0; iLayerIdx < getLayerCount(); ++iLayerIdx) {
-        const Layer* pLayer = getLayer(iLayerIdx);
-        oss << "  Layer " << iLayerIdx << ": " << pLayer->getNeuronCount() << " neurons\n";
+        oss << "  Layer " << iLayerIdx << ": " << getLayerNeuronCount(iLayerIdx) << " neurons\n";
     }
     
     return oss.str();                                                                                                                                                                       
 }
 
+//-------------------------------------------------------------
+//【函数名称】getTopologyFingerprint
+//【函数功能】计算拓扑指纹
+//【参数】无
+//【返回值】uint64_t，指纹值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+uint64_t Network::getTopologyFingerprint() const {
+    loadAllLayers();
+    
+    map<const Neuron*, int64_t> globalIndex;
+    int64_t iNextIndex = 0;
+    for (const auto& layer : m_layers) {
+        for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
+            globalIndex[layer->getNeuron(iNeuronIdx)] = iNextIndex++;
+        }
+    }
+    
+    // FNV-1a over a stream of 64-bit values
+    uint64_t uHash = 14695981039346656037ULL;
+    auto mix = [&uHash](int64_t value) {
+        uint64_t uValue = static_cast<uint64_t>(value);
+        for (int iByte = 0; iByte < 8; ++iByte) {
+            uHash ^= (uValue >> (iByte * 8)) & 0xFF;
+            uHash *= 1099511628211ULL;
+        }
+    };
+    
+    mix(static_cast<int64_t>(m_layers.size()));
+    for (const auto& layer : m_layers) {
+        mix(layer->getNeuronCount());
+        for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
+            const Neuron* pNeuron = layer->getNeuron(iNeuronIdx);
+            mix(pNeuron->getInputSynapseCount());
+            for (int iSynapseIdx = 0; iSynapseIdx < pNeuron->getInputSynapseCount(); ++iSynapseIdx) {
+                const Neuron* pSource = pNeuron->getInputSynapse(iSynapseIdx)->getSourceNeuron();
+                auto found = globalIndex.find(pSource);
+                mix(found == globalIndex.end() ? -1 : found->second);
+            }
+            int64_t iExternalOutputs = 0;
+            for (int iSynapseIdx = 0; iSynapseIdx < pNeuron->getOutputSynapseCount(); ++iSynapseIdx) {
+                if (pNeuron->getOutputSynapse(iSynapseIdx)->getTargetNeuron() == nullptr) {
+                    ++iExternalOutputs;
+                }
+            }
+            mix(iExternalOutputs);
+        }
+    }
+    return uHash;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getParameterFingerprint
+//【函数功能】计算参数指纹
+//【参数】无
+//【返回值】uint64_t，指纹值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+uint64_t Network::getParameterFingerprint() const {
+    loadAllLayers();
+    
+    // FNV-1a over the bit patterns, so any change of a value changes the hash
+    uint64_t uHash = 14695981039346656037ULL;
+    auto mix = [&uHash](double value) {
+        uint64_t uValue = 0;
+        memcpy(&uValue, &value, sizeof(uValue));
+        for (int iByte = 0; iByte < 8; ++iByte) {
+            uHash ^= (uValue >> (iByte * 8)) & 0xFF;
+            uHash *= 1099511628211ULL;
+        }
+    };
+    
+    for (const auto& layer : m_layers) {
+        for (int iNeuronIdx = 0; iNeuronIdx < layer->getNeuronCount(); ++iNeuronIdx) {
+            const Neuron* pNeuron = layer->getNeuron(iNeuronIdx);
+            mix(pNeuron->getBias());
+            for (int iSynapseIdx = 0; iSynapseIdx < pNeuron->getInputSynapseCount(); ++iSynapseIdx) {
+                mix(pNeuron->getInputSynapse(iSynapseIdx)->getWeight());
+            }
+            // A missing activation function behaves as Linear
+            const ActivationFunction* pActivation = pNeuron->getActivationFunction();
+            for (char cName : pActivation ? pActivation->getName() : string("Linear")) {
+                uHash ^= static_cast<unsigned char>(cName);
+                uHash *= 1099511628211ULL;
+            }
+            uHash ^= 0xFF;  // Terminates the name
+            uHash *= 1099511628211ULL;
+        }
+    }
+    return uHash;
+}
+
 //-------------------------------------------------------------
 //【函数名称】setImportError
 //【函数功能】设置导入错误信息（用于缓存验证错误）
@@ -506,9 +711,10 @@ void Network::invalidateValidationCache() {
 //【参数】无
 //【返回值】有循环返回true，无循环返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 检查前先加载全部层
 //-------------------------------------------------------------
 bool Network::hasCycles() const {
+    loadAllLayers();
     if (m_layers.empty()) {
         return false;
     }
@@ -578,9 +784,10 @@ bool Network::hasCycles() const {
 //【参数】无
 //【返回值】参与返回true，未参与返回false
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 检查前先加载全部层
 //-------------------------------------------------------------
 bool Network::allNeuronsParticipate() const {
+    loadAllLayers();
     if (m_layers.empty()) {
         return false;
     }
@@ -641,9 +848,10 @@ bool Network::allNeuronsParticipate() const {
 //【参数】layerIndex：层索引，neuronIndex：神经元索引
 //【返回值】bool，是否移除成功
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 修改结构前先加载全部层
 //-------------------------------------------------------------
 bool Network::removeNeuron(int layerIndex, int neuronIndex) {
+    loadAllLayers();
     if (layerIndex < 0 || layerIndex >= static_cast<int>(m_layers.size())) {
         return false;
     }
@@ -684,3 +892,110 @@ bool Network::removeNeuron(int layerIndex, int neuronIndex) {
     // Remove the neuron from its layer
     return targetLayer->removeNeuron(neuronIndex);
 }
+
+//-------------------------------------------------------------
+//【函数名称】setWeightLoader
+//【函数功能】设置权重加载器，所有层标记为未加载
+//【参数】loader：权重加载器
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Network::setWeightLoader(unique_ptr<LayerWeightLoader> loader) {
+    m_weightLoader = move(loader);
+    m_layerLoaded.assign(m_layers.size(), m_weightLoader == nullptr);
+}
+
+//-------------------------------------------------------------
+//【函数名称】isFullyLoaded
+//【函数功能】检查是否所有层都已加载
+//【参数】无
+//【返回值】bool，全部加载返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 读取加载状态时加锁
+//-------------------------------------------------------------
+bool Network::isFullyLoaded() const {
+    lock_guard<recursive_mutex> lock(m_loadMutex);
+    return m_weightLoader == nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLoadedLayerCount
+//【函数功能】获取已加载的层数
+//【参数】无
+//【返回值】int，已加载层数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 读取加载状态时加锁
+//-------------------------------------------------------------
+int Network::getLoadedLayerCount() const {
+    lock_guard<recursive_mutex> lock(m_loadMutex);
+    if (!m_weightLoader) {
+        return getLayerCount();
+    }
+    return static_cast<int>(count(m_layerLoaded.begin(), m_layerLoaded.end(), true));
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadAllLayers
+//【函数功能】加载所有尚未加载的层，完成后释放加载器
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 加锁，多个线程同时触发加载时只加载一次
+//-------------------------------------------------------------
+void Network::loadAllLayers() const {
+    lock_guard<recursive_mutex> lock(m_loadMutex);
+    if (!m_weightLoader) {
+        return;
+    }
+    for (size_t uLayerIdx = 0; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        loadSingleLayer(static_cast<int>(uLayerIdx));
+    }
+    m_weightLoader.reset();
+}
+
+//-------------------------------------------------------------
+//【函数名称】ensureLayerLoaded
+//【函数功能】加载指定层及其下游层，全部加载后释放加载器
+//【参数】index：层索引
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 加锁，多个线程同时触发加载时只加载一次
+//-------------------------------------------------------------
+void Network::ensureLayerLoaded(int index) const {
+    lock_guard<recursive_mutex> lock(m_loadMutex);
+    if (!m_weightLoader) {
+        return;
+    }
+    
+    loadSingleLayer(index);
+    // This layer's axons are created when the layers it feeds are loaded
+    vector<int> targetLayers = m_weightLoader->getTargetLayers(index);
+    for (int iTarget : targetLayers) {
+        loadSingleLayer(iTarget);
+    }
+    
+    if (getLoadedLayerCount() == getLayerCount()) {
+        m_weightLoader.reset();
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadSingleLayer
+//【函数功能】通过加载器生成单层突触
+//【参数】index：层索引
+//【返回值】无，加载失败抛出runtime_error
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Network::loadSingleLayer(int index) const {
+    if (index < 0 || index >= static_cast<int>(m_layerLoaded.size()) || m_layerLoaded[index]) {
+        return;
+    }
+    
+    // Mark first so that a failed load is never retried on a half-built layer
+    m_layerLoaded[index] = true;
+    if (!m_weightLoader->loadLayerWeights(*const_cast<Network*>(this), index)) {
+        throw runtime_error("Failed to load weights of layer " + to_string(index));
+    }
+}
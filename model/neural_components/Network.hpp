@@ -9,28 +9,84 @@
 #define Network_hpp
 
 #include "Layer.hpp"
+#include "LayerWeightLoader.hpp"
 #include <vector>
 #include <memory>
 #include <string>
+#include <mutex>
 
 using namespace std;
 
+//-------------------------------------------------------------
+//【类名】InferenceEngine
+//【功能】编译后推理所用的执行引擎
+//【说明】Compiled：CompiledLayer的通用稠密内核；Jit：为该网络在运行时生成机器码，
+//       平台不支持或校验失败时自动退回Compiled。Network::predict始终在对象图上计算，作为基准
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+enum class InferenceEngine {
+    Compiled,
+    Jit
+};
+
 //-------------------------------------------------------------
 //【类名】Network
 //【功能】人工神经网络顶层容器，管理多层结构
 //【说明】支持推理、验证、结构修改等操作
 //【开发者及日期】林钲凯 2025-07-27
-//【更改记录】
+//【更改记录】2026-10-18 支持延迟加载：设置权重加载器后，getLayer/predict按需加载各层突触，
+//           统计与验证优先使用加载器的索引信息；结构修改与拷贝前先加载全部层
+//           2026-10-18 增加推理引擎选择，由CompiledNetwork编译时读取
+//           2026-10-18 增加参数指纹（getParameterFingerprint），供补丁确认基准网络的权重
+//           2026-10-18 按需加载由互斥量保护：多个线程可以同时通过常量接口读取同一个
+//           延迟加载的网络；结构修改仍须独占访问
 //-------------------------------------------------------------
 class Network {
 private:
     vector<unique_ptr<Layer>> m_layers;  ///< Collection of network layers
     string m_name;                            ///< Network name/identifier
+    InferenceEngine m_inferenceEngine;        ///< Engine used when this network is compiled
     
     // Validation cache for import errors
     mutable bool m_hasImportErrors;           ///< Whether import had validation errors
     mutable string m_importErrorMessage;     ///< Detailed error message from import
     mutable bool m_validationCacheValid;     ///< Whether validation cache is current
+    
+    // Lazy weight loading
+    mutable unique_ptr<LayerWeightLoader> m_weightLoader;  ///< Source of not yet loaded synapses
+    mutable vector<bool> m_layerLoaded;                   ///< Whether each layer's synapses exist
+    mutable recursive_mutex m_loadMutex;                  ///< Guards the two above; isValid and the loaders nest
+    
+    //-------------------------------------------------------------
+    //【函数名称】ensureLayerLoaded
+    //【函数功能】按需加载指定层的树突，以及其下游层（使本层轴突完整），持有m_loadMutex
+    //【参数】index：层索引
+    //【返回值】无，加载失败抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 加载过程加锁，可由多个线程同时调用
+    //-------------------------------------------------------------
+    void ensureLayerLoaded(int index) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】loadSingleLayer
+    //【函数功能】通过加载器生成单层拥有的突触
+    //【参数】index：层索引
+    //【返回值】无，加载失败抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void loadSingleLayer(int index) const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】relinkCopiedLayers
+    //【函数功能】拷贝各层后，把副本突触中指向源网络神经元的端点改为副本中对应的神经元
+    //【参数】other：被拷贝的源网络（层结构与本网络相同）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void relinkCopiedLayers(const Network& other);
 
 public:
     //-------------------------------------------------------------
@@ -103,6 +159,26 @@ public:
     //-------------------------------------------------------------
     void setName(const string& name);
     
+    //-------------------------------------------------------------
+    //【函数名称】getInferenceEngine
+    //【函数功能】获取编译后推理使用的执行引擎
+    //【参数】无
+    //【返回值】InferenceEngine，默认为Compiled
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    InferenceEngine getInferenceEngine() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】setInferenceEngine
+    //【函数功能】设置编译后推理使用的执行引擎（下次编译时生效）
+    //【参数】engine：执行引擎
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setInferenceEngine(InferenceEngine engine);
+    
     //-------------------------------------------------------------
     //【函数名称】addLayer
     //【函数功能】添加一层
@@ -138,8 +214,10 @@ public:
     //【函数功能】获取指定索引的层指针（常量）
     //【参数】index：层索引
     //【返回值】const Layer*，层指针
+    //【说明】延迟加载的网络在此按需加载突触，加载过程持有m_loadMutex，因此多个线程可以
+    //       同时调用；返回时该层的树突和轴突都已完整，之后不会再被加载改动
     //【开发者及日期】林钲凯 2025-07-27
-    //【更改记录】
+    //【更改记录】2026-10-18 按需加载可由多个线程同时触发
     //-------------------------------------------------------------
     const Layer* getLayer(int index) const;
     
@@ -153,25 +231,35 @@ public:
     //-------------------------------------------------------------
     int getLayerCount() const;
     
+    //-------------------------------------------------------------
+    //【函数名称】getLayerNeuronCount
+    //【函数功能】获取指定层的神经元数量（不触发延迟加载）
+    //【参数】index：层索引
+    //【返回值】int，神经元数量，索引无效返回-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getLayerNeuronCount(int index) const;
+    
     //-------------------------------------------------------------
     //【函数名称】getNeuronCount
     //【函数功能】获取网络中神经元总数
     //【参数】无
-    //【返回值】int，神经元总数
+    //【返回值】int64_t，神经元总数
     //【开发者及日期】林钲凯 2025-07-27
-    //【更改记录】
+    //【更改记录】2026-10-18 返回值改为int64_t
     //-------------------------------------------------------------
-    int getNeuronCount() const;
+    int64_t getNeuronCount() const;
     
     //-------------------------------------------------------------
     //【函数名称】getSynapseCount
     //【函数功能】获取网络中突触总数
     //【参数】无
-    //【返回值】int，突触总数
+    //【返回值】int64_t，突触总数
     //【开发者及日期】林钲凯 2025-07-27
-    //【更改记录】
+    //【更改记录】2026-10-18 返回值改为int64_t
     //-------------------------------------------------------------
-    int getSynapseCount() const;
+    int64_t getSynapseCount() const;
     
     //-------------------------------------------------------------
     //【函数名称】isValid
@@ -233,6 +321,28 @@ public:
     //-------------------------------------------------------------
     string getStructureInfo() const;
     
+    //-------------------------------------------------------------
+    //【函数名称】getTopologyFingerprint
+    //【函数功能】计算拓扑指纹：各层宽度、每个神经元树突的来源顺序及外部输出数量的FNV-1a散列，
+    //           不含偏置与权重，用于确认补丁的基准网络
+    //【参数】无
+    //【返回值】uint64_t，指纹值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    uint64_t getTopologyFingerprint() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getParameterFingerprint
+    //【函数功能】计算参数指纹：按层和神经元顺序对偏置、各树突权重（按位）和激活函数名称
+    //           做FNV-1a散列，与getTopologyFingerprint一起确认补丁的基准网络
+    //【参数】无
+    //【返回值】uint64_t，指纹值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    uint64_t getParameterFingerprint() const;
+    
     //-------------------------------------------------------------
     //【函数名称】hasCycles
     //【函数功能】判断网络是否有环（前馈网络应无环）
@@ -312,6 +422,46 @@ public:
     //【更改记录】
     //-------------------------------------------------------------
     bool removeNeuron(int layerIndex, int neuronIndex);
+    
+    //-------------------------------------------------------------
+    //【函数名称】setWeightLoader
+    //【函数功能】启用延迟加载：此后各层突触在首次需要时由加载器生成
+    //【参数】loader：权重加载器，须在全部层添加完成后设置
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setWeightLoader(unique_ptr<LayerWeightLoader> loader);
+    
+    //-------------------------------------------------------------
+    //【函数名称】isFullyLoaded
+    //【函数功能】检查是否所有层的突触都已加载
+    //【参数】无
+    //【返回值】bool，全部加载返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isFullyLoaded() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】getLoadedLayerCount
+    //【函数功能】获取已加载突触的层数
+    //【参数】无
+    //【返回值】int，已加载层数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getLoadedLayerCount() const;
+    
+    //-------------------------------------------------------------
+    //【函数名称】loadAllLayers
+    //【函数功能】加载所有尚未加载的层并释放加载器（加锁，可由多个线程同时调用）
+    //【参数】无
+    //【返回值】无，加载失败抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 加载过程加锁
+    //-------------------------------------------------------------
+    void loadAllLayers() const;
 };
 
 #endif // Network_hpp
@@ -267,6 +267,23 @@ bool Neuron::removeOutputSynapse(int index) {
     return false;
 }
 
+//-------------------------------------------------------------
+//【函数名称】setInputSynapseWeight
+//【函数功能】修改指定输入突触的权重
+//【参数】index：索引，weight：新权重
+//【返回值】bool，是否修改成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Neuron::setInputSynapseWeight(int index, double weight) {
+    if (index >= 0 && index < static_cast<int>(m_inputSynapses.size())) {
+        m_inputSynapses[index]->setWeight(weight);
+        m_hasComputedOutput = false; // Invalidate cached output
+        return true;
+    }
+    return false;
+}
+
 //-------------------------------------------------------------
 //【函数名称】connectTo
 //【函数功能】连接到目标神经元，根据规范轴突权重恒为1.0，连接权重存储在树突中
@@ -401,3 +418,26 @@ void Neuron::disconnectAll() {
     m_outputSynapses.clear();
     m_hasComputedOutput = false;
 }
+
+//-------------------------------------------------------------
+//【函数名称】remapSynapses
+//【函数功能】把突触端点中的旧神经元替换为新神经元
+//【参数】neurons：旧神经元到新神经元的映射
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Neuron::remapSynapses(const map<const Neuron*, Neuron*>& neurons) {
+    for (vector<unique_ptr<Synapse>>* pSynapses : {&m_inputSynapses, &m_outputSynapses}) {
+        for (unique_ptr<Synapse>& synapse : *pSynapses) {
+            auto source = neurons.find(synapse->getSourceNeuron());
+            if (source != neurons.end()) {
+                synapse->setSourceNeuron(source->second);
+            }
+            auto target = neurons.find(synapse->getTargetNeuron());
+            if (target != neurons.end()) {
+                synapse->setTargetNeuron(target->second);
+            }
+        }
+    }
+}
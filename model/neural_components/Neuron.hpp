@@ -12,6 +12,7 @@
 #include "../activation_functions/ActivationFunction.hpp"
 #include <vector>
 #include <memory>
+#include <map>
 
 using namespace std;
 
@@ -191,6 +192,16 @@ public:
     //-------------------------------------------------------------
     bool removeOutputSynapse(int index);
 
+    //-------------------------------------------------------------
+    //【函数名称】setInputSynapseWeight
+    //【函数功能】修改指定输入突触（树突）的权重
+    //【参数】index：索引，weight：新权重
+    //【返回值】bool，索引有效返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool setInputSynapseWeight(int index, double weight);
+
     //-------------------------------------------------------------
     //【函数名称】connectTo
     //【函数功能】连接到目标神经元
@@ -260,6 +271,16 @@ public:
     //【更改记录】
     //-------------------------------------------------------------
     void disconnectAll();
+
+    //-------------------------------------------------------------
+    //【函数名称】remapSynapses
+    //【函数功能】把突触端点中的旧神经元替换为对应的新神经元（拷贝网络后重新连接副本）
+    //【参数】neurons：旧神经元到新神经元的映射，不在映射中的端点保持不变
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void remapSynapses(const map<const Neuron*, Neuron*>& neurons);
 };
 
 #endif // Neuron_hpp
@@ -0,0 +1,221 @@
+//-------------------------------------------------------------
+//【文件名】BatchLoader.cpp
+//【功能模块和目的】从数据集按（打乱的）顺序组装小批量、由后台线程预取的加载器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "BatchLoader.hpp"
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】BatchLoader
+//【函数功能】构造函数
+//【参数】dataset：数据集，batchSize：每批样本数，shuffle：是否打乱，seed：洗牌种子，prefetch：是否预取
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+BatchLoader::BatchLoader(const Dataset& dataset, int64_t batchSize, bool shuffle, uint64_t seed, bool prefetch)
+    : m_dataset(dataset), m_iBatchSize(max<int64_t>(1, batchSize)), m_iBatchCount(0), m_bShuffle(shuffle),
+      m_bPrefetch(prefetch), m_random(seed), m_iProduced(0), m_iConsumed(0), m_iReleased(0),
+      m_bAssembling(false), m_bEpochActive(false), m_bStopping(false), m_iStalls(0) {
+    const int64_t iRows = dataset.getRowCount();
+    m_iBatchCount = (iRows + m_iBatchSize - 1) / m_iBatchSize;
+    m_order.resize(static_cast<size_t>(iRows));
+    for (int64_t iRow = 0; iRow < iRows; ++iRow) {
+        m_order[iRow] = iRow;
+    }
+    // Every slot is sized for a full batch once, then reused
+    for (MiniBatch& slot : m_slots) {
+        slot.inputs.resize(static_cast<size_t>(m_iBatchSize * dataset.getInputWidth()));
+        slot.targets.resize(static_cast<size_t>(m_iBatchSize * dataset.getTargetWidth()));
+    }
+    if (m_bPrefetch && m_iBatchCount > 0) {
+        m_worker = thread(&BatchLoader::prefetchLoop, this);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】~BatchLoader
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+BatchLoader::~BatchLoader() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_bStopping = true;
+    }
+    m_released.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getDataset
+//【函数功能】获取数据集
+//【参数】无
+//【返回值】const Dataset&，数据集
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const Dataset& BatchLoader::getDataset() const {
+    return m_dataset;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getBatchCount
+//【函数功能】获取每轮的批数
+//【参数】无
+//【返回值】int64_t，批数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t BatchLoader::getBatchCount() const {
+    return m_iBatchCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】startEpoch
+//【函数功能】开始新的一轮
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void BatchLoader::startEpoch() {
+    unique_lock<mutex> lock(m_mutex);
+    // The permutation is read while a slot is filled outside the lock
+    m_assembled.wait(lock, [this]() { return !m_bAssembling; });
+    if (m_bShuffle) {
+        for (size_t uIdx = m_order.size(); uIdx > 1; --uIdx) {
+            uniform_int_distribution<size_t> pick(0, uIdx - 1);
+            swap(m_order[uIdx - 1], m_order[pick(m_random)]);
+        }
+    }
+    m_iProduced = 0;
+    m_iConsumed = 0;
+    m_iReleased = 0;
+    m_bEpochActive = true;
+    lock.unlock();
+    m_released.notify_all();
+}
+
+//-------------------------------------------------------------
+//【函数名称】nextBatch
+//【函数功能】取得本轮的下一批
+//【参数】无
+//【返回值】const MiniBatch*，下一批，取完时为nullptr
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const MiniBatch* BatchLoader::nextBatch() {
+    unique_lock<mutex> lock(m_mutex);
+    if (!m_bEpochActive) {
+        return nullptr;
+    }
+    // The batch handed out last time is done: its slot may be filled again
+    m_iReleased = m_iConsumed;
+    if (m_iConsumed == m_iBatchCount) {
+        m_bEpochActive = false;
+        return nullptr;
+    }
+    MiniBatch& slot = m_slots[m_iConsumed % PREFETCH_DEPTH];
+    if (!m_bPrefetch) {
+        ++m_iStalls;
+        assemble(m_iConsumed, slot);
+    } else {
+        lock.unlock();
+        m_released.notify_one();
+        lock.lock();
+        if (m_iProduced <= m_iConsumed) {
+            ++m_iStalls;
+            m_assembled.wait(lock, [this]() { return m_iProduced > m_iConsumed; });
+        }
+    }
+    ++m_iConsumed;
+    return &slot;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOrder
+//【函数功能】获取本轮的样本下标排列
+//【参数】无
+//【返回值】const vector<int64_t>&，排列
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<int64_t>& BatchLoader::getOrder() const {
+    return m_order;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getStallCount
+//【函数功能】获取nextBatch的等待次数
+//【参数】无
+//【返回值】int64_t，等待次数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t BatchLoader::getStallCount() const {
+    return m_iStalls;
+}
+
+//-------------------------------------------------------------
+//【函数名称】assemble
+//【函数功能】按当前排列组装一批
+//【参数】batchIdx：批编号，batch：目标缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void BatchLoader::assemble(int64_t batchIdx, MiniBatch& batch) const {
+    const int64_t iInputWidth = m_dataset.getInputWidth();
+    const int64_t iTargetWidth = m_dataset.getTargetWidth();
+    const int64_t iFirst = batchIdx * m_iBatchSize;
+    batch.rows = min(m_iBatchSize, m_dataset.getRowCount() - iFirst);
+    // Gather rows; the buffers keep their full-batch size so a short last batch reallocates nothing
+    for (int64_t iRow = 0; iRow < batch.rows; ++iRow) {
+        const int64_t iSample = m_order[iFirst + iRow];
+        const double* pInputs = m_dataset.getInputs() + iSample * iInputWidth;
+        const double* pTargets = m_dataset.getTargets() + iSample * iTargetWidth;
+        copy(pInputs, pInputs + iInputWidth, batch.inputs.begin() + iRow * iInputWidth);
+        copy(pTargets, pTargets + iTargetWidth, batch.targets.begin() + iRow * iTargetWidth);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】prefetchLoop
+//【函数功能】后台线程主循环
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void BatchLoader::prefetchLoop() {
+    unique_lock<mutex> lock(m_mutex);
+    while (true) {
+        // A slot is free when fewer than PREFETCH_DEPTH batches are assembled but not yet released
+        m_released.wait(lock, [this]() {
+            return m_bStopping ||
+                   (m_bEpochActive && m_iProduced < m_iBatchCount && m_iProduced - m_iReleased < PREFETCH_DEPTH);
+        });
+        if (m_bStopping) {
+            return;
+        }
+        const int64_t iBatchIdx = m_iProduced;
+        m_bAssembling = true;
+        lock.unlock();
+        assemble(iBatchIdx, m_slots[iBatchIdx % PREFETCH_DEPTH]);
+        lock.lock();
+        m_bAssembling = false;
+        ++m_iProduced;
+        m_assembled.notify_all();
+    }
+}
@@ -0,0 +1,193 @@
+//-------------------------------------------------------------
+//【文件名】BatchLoader.hpp
+//【功能模块和目的】从数据集按（打乱的）顺序组装小批量、由后台线程预取的加载器声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef BatchLoader_hpp
+#define BatchLoader_hpp
+
+#include "Dataset.hpp"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】MiniBatch
+//【功能】一个小批量：rows个样本的输入和目标，各为连续的行主序矩阵
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct MiniBatch {
+    vector<double> inputs;   // rows × 输入宽度
+    vector<double> targets;  // rows × 目标宽度
+    int64_t rows = 0;
+};
+
+//-------------------------------------------------------------
+//【类名】BatchLoader
+//【功能】每轮（startEpoch）生成一个样本下标排列（打乱时为Fisher-Yates洗牌），
+//       按排列把每batchSize个样本从Dataset复制为一个MiniBatch，依次由nextBatch交给训练循环
+//【说明】启用预取时，后台线程在PREFETCH_DEPTH个缓冲区中轮流组装：训练循环使用一个批次时，
+//       后台线程已在组装下一个，训练循环只在组装慢于计算时才等待（getStallCount计数）。
+//       缓冲区在各轮之间重复使用，不随每批重新分配。洗牌用以seed初始化的mt19937_64，
+//       相同的seed在各轮得到相同的排列序列，与是否预取无关。
+//       nextBatch和startEpoch只能由同一个线程调用；加载器存在期间Dataset必须保持打开
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class BatchLoader {
+public:
+    static const int PREFETCH_DEPTH = 2;  // 预取缓冲区数（训练循环持有一个，后台线程组装另一个）
+
+    //-------------------------------------------------------------
+    //【函数名称】BatchLoader
+    //【函数功能】构造函数，启用预取时启动后台线程
+    //【参数】dataset：已打开的数据集，batchSize：每批样本数（小于1时按1处理），
+    //       shuffle：是否每轮打乱顺序，seed：洗牌种子，prefetch：是否由后台线程预取
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    BatchLoader(const Dataset& dataset, int64_t batchSize, bool shuffle, uint64_t seed, bool prefetch = true);
+
+    //-------------------------------------------------------------
+    //【函数名称】BatchLoader（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，后台线程不可复制）
+    //【参数】other：被拷贝的加载器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    BatchLoader(const BatchLoader& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源
+    //【返回值】BatchLoader&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    BatchLoader& operator=(const BatchLoader& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~BatchLoader
+    //【函数功能】析构函数，停止并等待后台线程
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~BatchLoader();
+
+    //-------------------------------------------------------------
+    //【函数名称】getDataset
+    //【函数功能】获取数据集
+    //【参数】无
+    //【返回值】const Dataset&，数据集
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const Dataset& getDataset() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getBatchCount
+    //【函数功能】获取每轮的批数
+    //【参数】无
+    //【返回值】int64_t，ceil(样本数 / batchSize)
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getBatchCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】startEpoch
+    //【函数功能】开始新的一轮：丢弃本轮未取的批次，生成新的排列，后台线程开始组装第一批
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void startEpoch();
+
+    //-------------------------------------------------------------
+    //【函数名称】nextBatch
+    //【函数功能】取得本轮的下一批（同时归还上一次取得的批次，其缓冲区可被重新组装）
+    //【参数】无
+    //【返回值】const MiniBatch*，下一批，在下一次调用nextBatch或startEpoch之前有效；
+    //         本轮已取完或尚未startEpoch时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const MiniBatch* nextBatch();
+
+    //-------------------------------------------------------------
+    //【函数名称】getOrder
+    //【函数功能】获取本轮的样本下标排列
+    //【参数】无
+    //【返回值】const vector<int64_t>&，第k批为getOrder()[k·batchSize]起的样本
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<int64_t>& getOrder() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getStallCount
+    //【函数功能】获取nextBatch因下一批尚未组装完成而等待的次数（不预取时每批都计一次）
+    //【参数】无
+    //【返回值】int64_t，等待次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getStallCount() const;
+
+private:
+    //-------------------------------------------------------------
+    //【函数名称】assemble
+    //【函数功能】按当前排列把第batchIdx批样本复制到batch
+    //【参数】batchIdx：批编号，batch：目标缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void assemble(int64_t batchIdx, MiniBatch& batch) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】prefetchLoop
+    //【函数功能】后台线程主循环：有空闲缓冲区且本轮还有批次时组装下一批，直到加载器被析构
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void prefetchLoop();
+
+    const Dataset& m_dataset;
+    int64_t m_iBatchSize;
+    int64_t m_iBatchCount;
+    bool m_bShuffle;
+    bool m_bPrefetch;
+    mt19937_64 m_random;
+    vector<int64_t> m_order;        // Sample permutation of the current epoch
+    MiniBatch m_slots[PREFETCH_DEPTH];
+    mutex m_mutex;                  // Guards the counters below
+    condition_variable m_assembled; // Signals a finished batch
+    condition_variable m_released;  // Signals a free slot, a new epoch or shutdown
+    int64_t m_iProduced;            // Batches of this epoch assembled so far
+    int64_t m_iConsumed;            // Batches of this epoch handed out so far
+    int64_t m_iReleased;            // Handed-out batches whose slot may be reused
+    bool m_bAssembling;             // The prefetch thread is filling a slot outside the lock
+    bool m_bEpochActive;
+    bool m_bStopping;
+    int64_t m_iStalls;
+    thread m_worker;
+};
+
+#endif // BatchLoader_hpp
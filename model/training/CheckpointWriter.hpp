@@ -0,0 +1,197 @@
+//-------------------------------------------------------------
+//【文件名】CheckpointWriter.hpp
+//【功能模块和目的】训练检查点（.annk）的异步写出与恢复声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef CheckpointWriter_hpp
+#define CheckpointWriter_hpp
+
+#include "Trainer.hpp"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】CheckpointWriter
+//【功能】在训练过程中保存检查点：capture把训练器的参数和优化器状态复制到缓冲区，
+//       后台线程把缓冲区写成二进制文件；restore从检查点恢复训练器
+//【说明】.annk文件布局：魔数"ANNK"、uint32版本号、int64轮次、int64参数个数、
+//       int64优化器状态长度、uint64拓扑指纹（Network::getTopologyFingerprint）、double学习率、
+//       以0结尾的优化器名称，以0填充到HEADER_SIZE字节；
+//       随后是扁平参数数组（布局见Trainer）和Optimizer::saveState的状态数组，数值为本机字节序的double。
+//       两个快照缓冲区轮流使用：capture在锁内把数据复制到待写缓冲区，后台线程交换两个缓冲区后
+//       在锁外写文件，训练线程的停顿只有这次内存复制，不等待磁盘，也不经过ANNExporter的文本导出。
+//       上一次写出尚未完成时再次capture会覆盖待写的快照，文件总是保存最新的快照（getDroppedCount计数）。
+//       文件先写到"文件名.tmp"并刷新到磁盘，再用rename替换原文件，写出中途失败或进程终止时
+//       原来的检查点保持完整
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 版本2：文件头增加拓扑指纹并扩大到128字节，恢复时拒绝参数个数相同
+//           但层宽度或连接不同的网络；版本1的文件不再被接受
+//-------------------------------------------------------------
+class CheckpointWriter {
+public:
+    static const uint32_t VERSION = 2;       // 当前格式版本
+    static const int64_t HEADER_SIZE = 128;  // 文件头字节数（含填充）
+    static const size_t NAME_SIZE = 24;     // 文件头中优化器名称的字节数（含结尾的0）
+
+    //-------------------------------------------------------------
+    //【函数名称】CheckpointWriter
+    //【函数功能】构造函数，启动后台写出线程
+    //【参数】filename：检查点文件路径
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit CheckpointWriter(const string& filename);
+
+    //-------------------------------------------------------------
+    //【函数名称】CheckpointWriter（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，后台线程不可复制）
+    //【参数】other：被拷贝的对象
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CheckpointWriter(const CheckpointWriter& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源
+    //【返回值】CheckpointWriter&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    CheckpointWriter& operator=(const CheckpointWriter& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~CheckpointWriter
+    //【函数功能】析构函数，写完待写的快照后停止后台线程
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~CheckpointWriter();
+
+    //-------------------------------------------------------------
+    //【函数名称】getFilename
+    //【函数功能】获取检查点文件路径
+    //【参数】无
+    //【返回值】const string&，文件路径
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const string& getFilename() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】capture
+    //【函数功能】把训练器当前的参数、优化器状态和学习率复制为待写的快照，交给后台线程写出
+    //【参数】trainer：已载入网络的训练器（在两次更新之间由训练线程调用），epoch：记录在文件中的轮次
+    //【返回值】bool，训练器已载入网络且优化器名称不超过NAME_SIZE-1字节时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool capture(const Trainer& trainer, int64_t epoch);
+
+    //-------------------------------------------------------------
+    //【函数名称】flush
+    //【函数功能】等待已capture的快照全部写出
+    //【参数】无
+    //【返回值】bool，最后一次写出成功（或尚未写出过）时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool flush();
+
+    //-------------------------------------------------------------
+    //【函数名称】getWrittenCount
+    //【函数功能】获取成功写出的检查点数
+    //【参数】无
+    //【返回值】int64_t，写出次数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getWrittenCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getDroppedCount
+    //【函数功能】获取写出前被更新的快照覆盖、因而没有写出的快照数
+    //【参数】无
+    //【返回值】int64_t，被覆盖的快照数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getDroppedCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】restore
+    //【函数功能】从检查点恢复训练器的参数、优化器状态和学习率
+    //【参数】filename：检查点文件路径，trainer：已从同一结构的网络loadFrom、
+    //       并设置了同名优化器的训练器，epoch：返回文件中记录的轮次
+    //【返回值】bool，文件完整且与训练器匹配（参数个数、拓扑指纹和优化器名称都相同）时返回true；
+    //       失败时训练器不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 同时核对拓扑指纹
+    //-------------------------------------------------------------
+    static bool restore(const string& filename, Trainer& trainer, int64_t& epoch);
+
+private:
+    //-------------------------------------------------------------
+    //【类名】Snapshot
+    //【功能】一个检查点的内容
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    struct Snapshot {
+        int64_t iEpoch = 0;
+        uint64_t uTopologyFingerprint = 0;
+        double rLearningRate = 0.0;
+        string optimizerName;
+        vector<double> parameters;
+        vector<double> state;
+    };
+
+    //-------------------------------------------------------------
+    //【函数名称】writeSnapshot
+    //【函数功能】把快照写到临时文件，刷新后替换检查点文件
+    //【参数】snapshot：快照
+    //【返回值】bool，是否成功
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool writeSnapshot(const Snapshot& snapshot) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】writerLoop
+    //【函数功能】后台线程主循环：有待写的快照时交换缓冲区并写出，直到对象被析构
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void writerLoop();
+
+    string m_filename;
+    Snapshot m_pending;                 // Filled by capture
+    Snapshot m_writing;                 // Owned by the writer thread while m_bWriting
+    mutable mutex m_mutex;              // Guards the fields below and m_pending
+    condition_variable m_captured;      // Signals a pending snapshot or shutdown
+    condition_variable m_written;       // Signals that the writer thread became idle
+    bool m_bHasPending;
+    bool m_bWriting;
+    bool m_bStopping;
+    bool m_bLastWriteFailed;
+    int64_t m_iWritten;
+    int64_t m_iDropped;
+    thread m_worker;
+};
+
+#endif // CheckpointWriter_hpp
@@ -0,0 +1,290 @@
+//-------------------------------------------------------------
+//【文件名】Dataset.cpp
+//【功能模块和目的】内存映射的二进制训练数据集（.annd）实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "Dataset.hpp"
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ANN_DATASET_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char MAGIC[4] = {'A', 'N', 'N', 'D'};
+
+// The fixed part of the header; the rest up to HEADER_SIZE is zero
+struct DatasetHeader {
+    char magic[4];
+    uint32_t uVersion;
+    int64_t iRows;
+    int64_t iInputWidth;
+    int64_t iTargetWidth;
+};
+
+// Number of doubles after the header, or -1 when the sizes are invalid or overflow
+int64_t payloadDoubles(const DatasetHeader& header) {
+    if (header.iRows <= 0 || header.iInputWidth <= 0 || header.iTargetWidth <= 0) {
+        return -1;
+    }
+    const int64_t iLimit = numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(double));
+    if (header.iInputWidth > iLimit - header.iTargetWidth ||
+        header.iRows > iLimit / (header.iInputWidth + header.iTargetWidth)) {
+        return -1;
+    }
+    return header.iRows * (header.iInputWidth + header.iTargetWidth);
+}
+
+bool isValidHeader(const DatasetHeader& header) {
+    return memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.uVersion == Dataset::VERSION &&
+           payloadDoubles(header) > 0;
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】Dataset
+//【函数功能】构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Dataset::Dataset()
+    : m_pMapping(nullptr), m_uMappedBytes(0), m_pInputs(nullptr), m_pTargets(nullptr),
+      m_iRows(0), m_iInputWidth(0), m_iTargetWidth(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~Dataset
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Dataset::~Dataset() {
+    close();
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeFile
+//【函数功能】写出.annd文件
+//【参数】filename：文件路径，inputs：输入，targets：目标，rows：样本数，
+//       inputWidth：输入宽度，targetWidth：目标宽度
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Dataset::writeFile(const string& filename, const vector<double>& inputs, const vector<double>& targets,
+                        int64_t rows, int64_t inputWidth, int64_t targetWidth) {
+    DatasetHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.uVersion = VERSION;
+    header.iRows = rows;
+    header.iInputWidth = inputWidth;
+    header.iTargetWidth = targetWidth;
+    if (payloadDoubles(header) <= 0 ||
+        static_cast<int64_t>(inputs.size()) != rows * inputWidth ||
+        static_cast<int64_t>(targets.size()) != rows * targetWidth) {
+        return false;
+    }
+
+    ofstream file(filename, ios::out | ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    char padded[HEADER_SIZE] = {};
+    memcpy(padded, &header, sizeof(header));
+    file.write(padded, HEADER_SIZE);
+    file.write(reinterpret_cast<const char*>(inputs.data()), static_cast<streamsize>(inputs.size() * sizeof(double)));
+    file.write(reinterpret_cast<const char*>(targets.data()), static_cast<streamsize>(targets.size() * sizeof(double)));
+    return static_cast<bool>(file);
+}
+
+//-------------------------------------------------------------
+//【函数名称】open
+//【函数功能】打开.annd文件
+//【参数】filename：文件路径
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Dataset::open(const string& filename) {
+    close();
+    DatasetHeader header;
+    int64_t iDoubles = 0;
+#ifdef ANN_DATASET_MMAP
+    int iFile = ::open(filename.c_str(), O_RDONLY);
+    if (iFile < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(iFile, &info) != 0 || info.st_size < HEADER_SIZE) {
+        ::close(iFile);
+        return false;
+    }
+    m_uMappedBytes = static_cast<size_t>(info.st_size);
+    void* pMapping = mmap(nullptr, m_uMappedBytes, PROT_READ, MAP_PRIVATE, iFile, 0);
+    // The mapping keeps its own reference to the file
+    ::close(iFile);
+    if (pMapping == MAP_FAILED) {
+        m_uMappedBytes = 0;
+        return false;
+    }
+    m_pMapping = pMapping;
+    memcpy(&header, m_pMapping, sizeof(header));
+    iDoubles = isValidHeader(header) ? payloadDoubles(header) : -1;
+    if (iDoubles <= 0 ||
+        static_cast<int64_t>(m_uMappedBytes) != HEADER_SIZE + iDoubles * static_cast<int64_t>(sizeof(double))) {
+        close();
+        return false;
+    }
+    m_pInputs = reinterpret_cast<const double*>(static_cast<const char*>(m_pMapping) + HEADER_SIZE);
+#else
+    ifstream file(filename, ios::in | ios::binary);
+    char padded[HEADER_SIZE];
+    if (!file.is_open() || !file.read(padded, HEADER_SIZE)) {
+        return false;
+    }
+    memcpy(&header, padded, sizeof(header));
+    iDoubles = isValidHeader(header) ? payloadDoubles(header) : -1;
+    file.seekg(0, ios::end);
+    if (iDoubles <= 0 ||
+        static_cast<int64_t>(file.tellg()) != HEADER_SIZE + iDoubles * static_cast<int64_t>(sizeof(double))) {
+        return false;
+    }
+    file.seekg(HEADER_SIZE, ios::beg);
+    m_contents.resize(static_cast<size_t>(iDoubles));
+    if (!file.read(reinterpret_cast<char*>(m_contents.data()), iDoubles * static_cast<int64_t>(sizeof(double)))) {
+        m_contents.clear();
+        return false;
+    }
+    m_pInputs = m_contents.data();
+#endif
+    m_iRows = header.iRows;
+    m_iInputWidth = header.iInputWidth;
+    m_iTargetWidth = header.iTargetWidth;
+    m_pTargets = m_pInputs + m_iRows * m_iInputWidth;
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】close
+//【函数功能】关闭数据集
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Dataset::close() {
+#ifdef ANN_DATASET_MMAP
+    if (m_pMapping) {
+        munmap(m_pMapping, m_uMappedBytes);
+    }
+#endif
+    m_pMapping = nullptr;
+    m_uMappedBytes = 0;
+    m_contents.clear();
+    m_contents.shrink_to_fit();
+    m_pInputs = nullptr;
+    m_pTargets = nullptr;
+    m_iRows = 0;
+    m_iInputWidth = 0;
+    m_iTargetWidth = 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isOpen
+//【函数功能】判断数据集是否已打开
+//【参数】无
+//【返回值】bool，已打开返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Dataset::isOpen() const {
+    return m_pInputs != nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】isMapped
+//【函数功能】判断数据是否来自文件映射
+//【参数】无
+//【返回值】bool，使用mmap时返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Dataset::isMapped() const {
+    return m_pMapping != nullptr;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getRowCount
+//【函数功能】获取样本数
+//【参数】无
+//【返回值】int64_t，样本数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Dataset::getRowCount() const {
+    return m_iRows;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputWidth
+//【函数功能】获取输入宽度
+//【参数】无
+//【返回值】int64_t，输入宽度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Dataset::getInputWidth() const {
+    return m_iInputWidth;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getTargetWidth
+//【函数功能】获取目标宽度
+//【参数】无
+//【返回值】int64_t，目标宽度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Dataset::getTargetWidth() const {
+    return m_iTargetWidth;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputs
+//【函数功能】获取输入矩阵
+//【参数】无
+//【返回值】const double*，输入矩阵
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const double* Dataset::getInputs() const {
+    return m_pInputs;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getTargets
+//【函数功能】获取目标矩阵
+//【参数】无
+//【返回值】const double*，目标矩阵
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const double* Dataset::getTargets() const {
+    return m_pTargets;
+}
@@ -0,0 +1,189 @@
+//-------------------------------------------------------------
+//【文件名】Dataset.hpp
+//【功能模块和目的】内存映射的二进制训练数据集（.annd）声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef Dataset_hpp
+#define Dataset_hpp
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】Dataset
+//【功能】只读的训练数据集：rows个样本，每个样本inputWidth个输入和targetWidth个目标
+//【说明】.annd文件布局：魔数"ANND"、uint32版本号、int64样本数、int64输入宽度、int64目标宽度，
+//       以0填充到HEADER_SIZE字节；随后是rows×inputWidth的行主序输入矩阵，
+//       再是rows×targetWidth的行主序目标矩阵，数值为本机字节序的double。
+//       文件头占满一个缓存行，两个矩阵都从缓存行边界开始（文件映射按页对齐）。
+//       在POSIX系统上open用mmap只读映射整个文件，数据页由操作系统按需调入，
+//       getInputs/getTargets直接指向映射区，不复制；其他平台整个读入内存。
+//       对象不可复制，close或析构后之前取得的指针失效
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class Dataset {
+public:
+    static const uint32_t VERSION = 1;       // 当前格式版本
+    static const int64_t HEADER_SIZE = 64;   // 文件头字节数（含填充）
+
+    //-------------------------------------------------------------
+    //【函数名称】Dataset
+    //【函数功能】构造函数，创建未打开的数据集
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Dataset();
+
+    //-------------------------------------------------------------
+    //【函数名称】Dataset（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，映射区只能有一个所有者）
+    //【参数】other：被拷贝的数据集
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Dataset(const Dataset& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源
+    //【返回值】Dataset&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Dataset& operator=(const Dataset& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~Dataset
+    //【函数功能】析构函数，解除映射
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~Dataset();
+
+    //-------------------------------------------------------------
+    //【函数名称】writeFile
+    //【函数功能】把行主序的输入和目标矩阵写成.annd文件
+    //【参数】filename：文件路径，inputs：rows×inputWidth个输入，targets：rows×targetWidth个目标，
+    //       rows：样本数，inputWidth：输入宽度，targetWidth：目标宽度
+    //【返回值】bool，尺寸合法且写入成功返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static bool writeFile(const string& filename, const vector<double>& inputs, const vector<double>& targets,
+                          int64_t rows, int64_t inputWidth, int64_t targetWidth);
+
+    //-------------------------------------------------------------
+    //【函数名称】open
+    //【函数功能】打开.annd文件（先关闭已打开的文件），校验文件头和文件长度
+    //【参数】filename：文件路径
+    //【返回值】bool，成功返回true；失败时数据集保持关闭
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool open(const string& filename);
+
+    //-------------------------------------------------------------
+    //【函数名称】close
+    //【函数功能】关闭数据集，解除映射或释放内存
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void close();
+
+    //-------------------------------------------------------------
+    //【函数名称】isOpen
+    //【函数功能】判断数据集是否已打开
+    //【参数】无
+    //【返回值】bool，已打开返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isOpen() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】isMapped
+    //【函数功能】判断数据是否直接来自文件映射（而不是读入的副本）
+    //【参数】无
+    //【返回值】bool，使用mmap时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool isMapped() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getRowCount
+    //【函数功能】获取样本数
+    //【参数】无
+    //【返回值】int64_t，样本数，未打开时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getRowCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputWidth
+    //【函数功能】获取每个样本的输入数
+    //【参数】无
+    //【返回值】int64_t，输入宽度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputWidth() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getTargetWidth
+    //【函数功能】获取每个样本的目标数
+    //【参数】无
+    //【返回值】int64_t，目标宽度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getTargetWidth() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputs
+    //【函数功能】获取行主序的输入矩阵
+    //【参数】无
+    //【返回值】const double*，第i个样本的输入从getInputs() + i·getInputWidth()开始；未打开时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const double* getInputs() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getTargets
+    //【函数功能】获取行主序的目标矩阵
+    //【参数】无
+    //【返回值】const double*，第i个样本的目标从getTargets() + i·getTargetWidth()开始；未打开时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const double* getTargets() const;
+
+private:
+    void* m_pMapping;           // Start of the mapped file, nullptr when not mapped
+    size_t m_uMappedBytes;
+    vector<double> m_contents;  // Whole file after the header when mmap is unavailable
+    const double* m_pInputs;
+    const double* m_pTargets;
+    int64_t m_iRows;
+    int64_t m_iInputWidth;
+    int64_t m_iTargetWidth;
+};
+
+#endif // Dataset_hpp
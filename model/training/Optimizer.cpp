@@ -0,0 +1,428 @@
+//-------------------------------------------------------------
+//【文件名】Optimizer.cpp
+//【功能模块和目的】训练器使用的参数更新规则（优化器）实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加动量SGD、RMSProp和Adam
+//           2026-10-18 优化器状态可以导出和恢复
+//-------------------------------------------------------------
+
+#include "Optimizer.hpp"
+#include "../inference_engine/KernelDispatch.hpp"
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】Optimizer
+//【函数功能】构造函数
+//【参数】learningRate：学习率
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Optimizer::Optimizer(double learningRate) : m_rLearningRate(learningRate) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getLearningRate
+//【函数功能】获取学习率
+//【参数】无
+//【返回值】double，学习率
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Optimizer::getLearningRate() const {
+    return m_rLearningRate;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setLearningRate
+//【函数功能】设置学习率
+//【参数】learningRate：学习率
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Optimizer::setLearningRate(double learningRate) {
+    m_rLearningRate = learningRate;
+}
+
+//-------------------------------------------------------------
+//【函数名称】reset
+//【函数功能】清空优化器状态（基类无状态）
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Optimizer::reset() {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getStateSize
+//【函数功能】获取状态长度
+//【参数】无
+//【返回值】int64_t，状态长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Optimizer::getStateSize() const {
+    return 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】saveState
+//【函数功能】复制优化器状态（基类无状态）
+//【参数】state：缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Optimizer::saveState(double* state) const {
+    (void)state;
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadState
+//【函数功能】恢复优化器状态（基类无状态）
+//【参数】state：状态数据，size：元素数
+//【返回值】bool，长度合法时返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Optimizer::loadState(const double* state, int64_t size) {
+    (void)state;
+    return size == 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】SgdOptimizer
+//【函数功能】构造函数
+//【参数】learningRate：学习率
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+SgdOptimizer::SgdOptimizer(double learningRate) : Optimizer(learningRate) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getName
+//【函数功能】获取优化器名称
+//【参数】无
+//【返回值】string，名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string SgdOptimizer::getName() const {
+    return "SGD";
+}
+
+//-------------------------------------------------------------
+//【函数名称】step
+//【函数功能】parameters -= learningRate · gradients
+//【参数】parameters：参数，gradients：梯度，count：元素数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void SgdOptimizer::step(double* parameters, const double* gradients, int64_t count) {
+    KernelDispatch::axpy(KernelDispatch::getActiveIsa(), count, -m_rLearningRate, gradients, parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】MomentumOptimizer
+//【函数功能】构造函数
+//【参数】learningRate：学习率，momentum：动量系数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+MomentumOptimizer::MomentumOptimizer(double learningRate, double momentum)
+    : Optimizer(learningRate), m_rMomentum(momentum) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getName
+//【函数功能】获取优化器名称
+//【参数】无
+//【返回值】string，名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string MomentumOptimizer::getName() const {
+    return "Momentum";
+}
+
+//-------------------------------------------------------------
+//【函数名称】step
+//【函数功能】更新速度和参数
+//【参数】parameters：参数，gradients：梯度，count：元素数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void MomentumOptimizer::step(double* parameters, const double* gradients, int64_t count) {
+    if (static_cast<int64_t>(m_velocity.size()) != count) {
+        m_velocity.assign(static_cast<size_t>(count), 0.0);
+    }
+    KernelDispatch::momentumUpdate(KernelDispatch::getActiveIsa(), count, m_rLearningRate, m_rMomentum,
+                                   gradients, m_velocity.data(), parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】reset
+//【函数功能】清空速度
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void MomentumOptimizer::reset() {
+    m_velocity.clear();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getStateSize
+//【函数功能】获取状态长度
+//【参数】无
+//【返回值】int64_t，状态长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t MomentumOptimizer::getStateSize() const {
+    return static_cast<int64_t>(m_velocity.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】saveState
+//【函数功能】复制速度数组
+//【参数】state：缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void MomentumOptimizer::saveState(double* state) const {
+    copy(m_velocity.begin(), m_velocity.end(), state);
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadState
+//【函数功能】恢复速度数组
+//【参数】state：状态数据，size：元素数
+//【返回值】bool，长度合法时返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool MomentumOptimizer::loadState(const double* state, int64_t size) {
+    if (size < 0) {
+        return false;
+    }
+    m_velocity.assign(state, state + size);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】RmsPropOptimizer
+//【函数功能】构造函数
+//【参数】learningRate：学习率，decay：衰减系数，epsilon：分母的小常数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+RmsPropOptimizer::RmsPropOptimizer(double learningRate, double decay, double epsilon)
+    : Optimizer(learningRate), m_rDecay(decay), m_rEpsilon(epsilon) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getName
+//【函数功能】获取优化器名称
+//【参数】无
+//【返回值】string，名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string RmsPropOptimizer::getName() const {
+    return "RMSProp";
+}
+
+//-------------------------------------------------------------
+//【函数名称】step
+//【函数功能】更新梯度平方的滑动平均和参数
+//【参数】parameters：参数，gradients：梯度，count：元素数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void RmsPropOptimizer::step(double* parameters, const double* gradients, int64_t count) {
+    if (static_cast<int64_t>(m_meanSquares.size()) != count) {
+        m_meanSquares.assign(static_cast<size_t>(count), 0.0);
+    }
+    KernelDispatch::rmsPropUpdate(KernelDispatch::getActiveIsa(), count, m_rLearningRate, m_rDecay, m_rEpsilon,
+                                  gradients, m_meanSquares.data(), parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】reset
+//【函数功能】清空滑动平均
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void RmsPropOptimizer::reset() {
+    m_meanSquares.clear();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getStateSize
+//【函数功能】获取状态长度
+//【参数】无
+//【返回值】int64_t，状态长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t RmsPropOptimizer::getStateSize() const {
+    return static_cast<int64_t>(m_meanSquares.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】saveState
+//【函数功能】复制滑动平均数组
+//【参数】state：缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void RmsPropOptimizer::saveState(double* state) const {
+    copy(m_meanSquares.begin(), m_meanSquares.end(), state);
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadState
+//【函数功能】恢复滑动平均数组
+//【参数】state：状态数据，size：元素数
+//【返回值】bool，长度合法时返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool RmsPropOptimizer::loadState(const double* state, int64_t size) {
+    if (size < 0) {
+        return false;
+    }
+    m_meanSquares.assign(state, state + size);
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】AdamOptimizer
+//【函数功能】构造函数
+//【参数】learningRate：学习率，beta1、beta2：矩的衰减系数，epsilon：分母的小常数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+AdamOptimizer::AdamOptimizer(double learningRate, double beta1, double beta2, double epsilon)
+    : Optimizer(learningRate), m_rBeta1(beta1), m_rBeta2(beta2), m_rEpsilon(epsilon), m_iStep(0) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】getName
+//【函数功能】获取优化器名称
+//【参数】无
+//【返回值】string，名称
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+string AdamOptimizer::getName() const {
+    return "Adam";
+}
+
+//-------------------------------------------------------------
+//【函数名称】step
+//【函数功能】更新两个矩和参数
+//【参数】parameters：参数，gradients：梯度，count：元素数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void AdamOptimizer::step(double* parameters, const double* gradients, int64_t count) {
+    if (static_cast<int64_t>(m_firstMoments.size()) != count) {
+        m_firstMoments.assign(static_cast<size_t>(count), 0.0);
+        m_secondMoments.assign(static_cast<size_t>(count), 0.0);
+        m_iStep = 0;
+    }
+    ++m_iStep;
+    // Bias correction once per step instead of once per element
+    const double rT = static_cast<double>(m_iStep);
+    const double rStepSize = m_rLearningRate * sqrt(1.0 - pow(m_rBeta2, rT)) / (1.0 - pow(m_rBeta1, rT));
+    KernelDispatch::adamUpdate(KernelDispatch::getActiveIsa(), count, rStepSize, m_rBeta1, m_rBeta2, m_rEpsilon,
+                               gradients, m_firstMoments.data(), m_secondMoments.data(), parameters);
+}
+
+//-------------------------------------------------------------
+//【函数名称】reset
+//【函数功能】清空两个矩，步数归零
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void AdamOptimizer::reset() {
+    m_firstMoments.clear();
+    m_secondMoments.clear();
+    m_iStep = 0;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getStateSize
+//【函数功能】获取状态长度
+//【参数】无
+//【返回值】int64_t，状态长度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t AdamOptimizer::getStateSize() const {
+    return m_firstMoments.empty() ? 0 : 1 + 2 * static_cast<int64_t>(m_firstMoments.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】saveState
+//【函数功能】复制步数、一阶矩和二阶矩
+//【参数】state：缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void AdamOptimizer::saveState(double* state) const {
+    if (m_firstMoments.empty()) {
+        return;
+    }
+    state[0] = static_cast<double>(m_iStep);
+    copy(m_firstMoments.begin(), m_firstMoments.end(), state + 1);
+    copy(m_secondMoments.begin(), m_secondMoments.end(), state + 1 + m_firstMoments.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】loadState
+//【函数功能】恢复步数、一阶矩和二阶矩
+//【参数】state：状态数据，size：元素数
+//【返回值】bool，长度合法时返回true
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool AdamOptimizer::loadState(const double* state, int64_t size) {
+    if (size == 0) {
+        reset();
+        return true;
+    }
+    if (size < 3 || (size - 1) % 2 != 0 || state[0] < 0.0) {
+        return false;
+    }
+    const int64_t iCount = (size - 1) / 2;
+    m_iStep = static_cast<int64_t>(state[0]);
+    m_firstMoments.assign(state + 1, state + 1 + iCount);
+    m_secondMoments.assign(state + 1 + iCount, state + size);
+    return true;
+}
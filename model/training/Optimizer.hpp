@@ -0,0 +1,439 @@
+//-------------------------------------------------------------
+//【文件名】Optimizer.hpp
+//【功能模块和目的】训练器使用的参数更新规则（优化器）声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加动量SGD、RMSProp和Adam
+//           2026-10-18 优化器状态可以导出和恢复，供检查点使用
+//-------------------------------------------------------------
+
+#ifndef Optimizer_hpp
+#define Optimizer_hpp
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】Optimizer
+//【功能】优化器抽象基类：按梯度原地更新Trainer的扁平参数数组
+//【说明】step每批调用一次，parameters与gradients的布局相同（见Trainer）；
+//       有状态的优化器按元素下标保存状态，同一个对象只能用于一个训练器
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class Optimizer {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】Optimizer
+    //【函数功能】构造函数
+    //【参数】learningRate：学习率
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit Optimizer(double learningRate);
+
+    //-------------------------------------------------------------
+    //【函数名称】~Optimizer
+    //【函数功能】虚析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual ~Optimizer() = default;
+
+    //-------------------------------------------------------------
+    //【函数名称】getLearningRate
+    //【函数功能】获取学习率
+    //【参数】无
+    //【返回值】double，学习率
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double getLearningRate() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】setLearningRate
+    //【函数功能】设置学习率（对之后的step生效）
+    //【参数】learningRate：学习率
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setLearningRate(double learningRate);
+
+    //-------------------------------------------------------------
+    //【函数名称】getName
+    //【函数功能】获取优化器名称
+    //【参数】无
+    //【返回值】string，名称
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual string getName() const = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】step
+    //【函数功能】按一批的平均梯度更新参数
+    //【参数】parameters：count个参数（原地更新），gradients：count个梯度，count：元素数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual void step(double* parameters, const double* gradients, int64_t count) = 0;
+
+    //-------------------------------------------------------------
+    //【函数名称】reset
+    //【函数功能】清空优化器状态（矩、步数），下一次step从零状态开始
+    //【参数】无
+    //【返回值】无
+    //【说明】Trainer::loadFrom载入新网络时调用；无状态的优化器什么也不做
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual void reset();
+
+    //-------------------------------------------------------------
+    //【函数名称】getStateSize
+    //【函数功能】获取优化器状态的double个数（保存检查点时的缓冲区长度）
+    //【参数】无
+    //【返回值】int64_t，状态长度；无状态或尚未step时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual int64_t getStateSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】saveState
+    //【函数功能】把优化器状态复制到state（连续的内存复制）
+    //【参数】state：getStateSize()个元素的缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual void saveState(double* state) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】loadState
+    //【函数功能】从saveState保存的数据恢复优化器状态
+    //【参数】state：状态数据，size：元素数（为0时等于reset）
+    //【返回值】bool，长度对本优化器合法时返回true，否则状态不变
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    virtual bool loadState(const double* state, int64_t size);
+
+protected:
+    double m_rLearningRate;
+};
+
+//-------------------------------------------------------------
+//【类名】SgdOptimizer
+//【功能】随机梯度下降：parameter -= learningRate · gradient
+//【说明】无状态（状态长度为0），用KernelDispatch::axpy在一次遍历中完成
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class SgdOptimizer : public Optimizer {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】SgdOptimizer
+    //【函数功能】构造函数
+    //【参数】learningRate：学习率
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit SgdOptimizer(double learningRate = 0.1);
+
+    //-------------------------------------------------------------
+    //【函数名称】getName
+    //【函数功能】获取优化器名称
+    //【参数】无
+    //【返回值】string，"SGD"
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string getName() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】step
+    //【函数功能】parameters -= learningRate · gradients
+    //【参数】parameters：参数，gradients：梯度，count：元素数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void step(double* parameters, const double* gradients, int64_t count) override;
+};
+
+//-------------------------------------------------------------
+//【类名】MomentumOptimizer
+//【功能】带动量的随机梯度下降：velocity = momentum·velocity + gradient，
+//       parameter -= learningRate · velocity
+//【说明】速度数组与扁平参数按下标一一对应，首次step（或元素数变化）时置零；
+//       每步用KernelDispatch::momentumUpdate在一次遍历中完成全部层的更新
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class MomentumOptimizer : public Optimizer {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】MomentumOptimizer
+    //【函数功能】构造函数
+    //【参数】learningRate：学习率，momentum：动量系数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit MomentumOptimizer(double learningRate = 0.01, double momentum = 0.9);
+
+    //-------------------------------------------------------------
+    //【函数名称】getName
+    //【函数功能】获取优化器名称
+    //【参数】无
+    //【返回值】string，"Momentum"
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string getName() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】step
+    //【函数功能】更新速度和参数
+    //【参数】parameters：参数，gradients：梯度，count：元素数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void step(double* parameters, const double* gradients, int64_t count) override;
+
+    //-------------------------------------------------------------
+    //【函数名称】reset
+    //【函数功能】清空速度
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void reset() override;
+
+    //-------------------------------------------------------------
+    //【函数名称】getStateSize
+    //【函数功能】获取状态长度
+    //【参数】无
+    //【返回值】int64_t，速度数组的长度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getStateSize() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】saveState
+    //【函数功能】复制速度数组
+    //【参数】state：缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void saveState(double* state) const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】loadState
+    //【函数功能】恢复速度数组
+    //【参数】state：状态数据，size：元素数
+    //【返回值】bool，长度合法时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool loadState(const double* state, int64_t size) override;
+
+private:
+    double m_rMomentum;
+    vector<double> m_velocity;      // One element per parameter
+};
+
+//-------------------------------------------------------------
+//【类名】RmsPropOptimizer
+//【功能】RMSProp：meanSquare = decay·meanSquare + (1-decay)·gradient²，
+//       parameter -= learningRate · gradient / (sqrt(meanSquare) + epsilon)
+//【说明】滑动平均数组与扁平参数按下标一一对应，首次step（或元素数变化）时置零；
+//       每步用KernelDispatch::rmsPropUpdate在一次遍历中完成全部层的更新
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class RmsPropOptimizer : public Optimizer {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】RmsPropOptimizer
+    //【函数功能】构造函数
+    //【参数】learningRate：学习率，decay：衰减系数，epsilon：分母的小常数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit RmsPropOptimizer(double learningRate = 0.001, double decay = 0.9, double epsilon = 1e-8);
+
+    //-------------------------------------------------------------
+    //【函数名称】getName
+    //【函数功能】获取优化器名称
+    //【参数】无
+    //【返回值】string，"RMSProp"
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string getName() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】step
+    //【函数功能】更新梯度平方的滑动平均和参数
+    //【参数】parameters：参数，gradients：梯度，count：元素数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void step(double* parameters, const double* gradients, int64_t count) override;
+
+    //-------------------------------------------------------------
+    //【函数名称】reset
+    //【函数功能】清空滑动平均
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void reset() override;
+
+    //-------------------------------------------------------------
+    //【函数名称】getStateSize
+    //【函数功能】获取状态长度
+    //【参数】无
+    //【返回值】int64_t，滑动平均数组的长度
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getStateSize() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】saveState
+    //【函数功能】复制滑动平均数组
+    //【参数】state：缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void saveState(double* state) const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】loadState
+    //【函数功能】恢复滑动平均数组
+    //【参数】state：状态数据，size：元素数
+    //【返回值】bool，长度合法时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool loadState(const double* state, int64_t size) override;
+
+private:
+    double m_rDecay;
+    double m_rEpsilon;
+    vector<double> m_meanSquares;   // One element per parameter
+};
+
+//-------------------------------------------------------------
+//【类名】AdamOptimizer
+//【功能】Adam：一阶矩m和二阶矩v按beta1、beta2滑动平均，
+//       parameter -= stepSize · m / (sqrt(v) + epsilon)，
+//       stepSize = learningRate · sqrt(1 - beta2^t) / (1 - beta1^t)
+//【说明】偏差修正并入每步只计算一次的stepSize（Adam论文第2节末的等价形式），
+//       内层循环不再逐元素除以修正系数；两个矩数组与扁平参数按下标一一对应，
+//       每步用KernelDispatch::adamUpdate在一次遍历中完成全部层的更新
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class AdamOptimizer : public Optimizer {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】AdamOptimizer
+    //【函数功能】构造函数
+    //【参数】learningRate：学习率，beta1、beta2：一阶、二阶矩的衰减系数，epsilon：分母的小常数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit AdamOptimizer(double learningRate = 0.001, double beta1 = 0.9, double beta2 = 0.999,
+                           double epsilon = 1e-8);
+
+    //-------------------------------------------------------------
+    //【函数名称】getName
+    //【函数功能】获取优化器名称
+    //【参数】无
+    //【返回值】string，"Adam"
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    string getName() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】step
+    //【函数功能】更新两个矩和参数，步数加一
+    //【参数】parameters：参数，gradients：梯度，count：元素数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void step(double* parameters, const double* gradients, int64_t count) override;
+
+    //-------------------------------------------------------------
+    //【函数名称】reset
+    //【函数功能】清空两个矩，步数归零
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void reset() override;
+
+    //-------------------------------------------------------------
+    //【函数名称】getStateSize
+    //【函数功能】获取状态长度
+    //【参数】无
+    //【返回值】int64_t，1 + 2×参数个数（步数、一阶矩、二阶矩），尚未step时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getStateSize() const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】saveState
+    //【函数功能】复制步数（以double保存）、一阶矩和二阶矩
+    //【参数】state：缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void saveState(double* state) const override;
+
+    //-------------------------------------------------------------
+    //【函数名称】loadState
+    //【函数功能】恢复步数、一阶矩和二阶矩
+    //【参数】state：状态数据，size：元素数
+    //【返回值】bool，长度合法时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool loadState(const double* state, int64_t size) override;
+
+private:
+    double m_rBeta1;
+    double m_rBeta2;
+    double m_rEpsilon;
+    int64_t m_iStep;                // Steps taken since the last reset
+    vector<double> m_firstMoments;  // One element per parameter
+    vector<double> m_secondMoments;
+};
+
+#endif // Optimizer_hpp
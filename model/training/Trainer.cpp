@@ -0,0 +1,1117 @@
+//-------------------------------------------------------------
+//【文件名】Trainer.cpp
+//【功能模块和目的】反向传播训练器实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加数据并行的小批量训练
+//           2026-10-18 增加Hogwild异步SGD
+//           2026-10-18 增加以BatchLoader为数据来源的trainEpoch
+//           2026-10-18 增加与训练并行的验证和早停
+//           2026-10-18 增加只读的getOptimizer
+//           2026-10-18 增加进化策略训练
+//-------------------------------------------------------------
+
+#include "Trainer.hpp"
+#include "../inference_engine/KernelDispatch.hpp"
+#include "../inference_engine/PackedGemm.hpp"
+#include "../neural_components/Layer.hpp"
+#include "../neural_components/Neuron.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <future>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// Rows of a weight matrix visited together while back-propagating deltas (about 128 KB)
+const int64_t BACKWARD_BLOCK_DOUBLES = 16384;
+
+// Parameters per task when the evolution-strategy direction is accumulated
+const int64_t EVOLUTION_CHUNK = 4096;
+
+// SplitMix64 finaliser: a bijective, well-avalanching mix of a 64-bit counter
+uint64_t mixBits(uint64_t uValue) {
+    uValue += 0x9E3779B97F4A7C15ULL;
+    uValue = (uValue ^ (uValue >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    uValue = (uValue ^ (uValue >> 27)) * 0x94D049BB133111EBULL;
+    return uValue ^ (uValue >> 31);
+}
+
+// Standard normal value number uIndex of a noise stream, computed from the counter alone (Box-Muller):
+// any thread can regenerate any element without a shared buffer or a sequential generator
+double counterGaussian(uint64_t uStream, uint64_t uIndex) {
+    const double rUnit = 1.0 / 9007199254740992.0;  // 2^-53
+    const uint64_t uPair = uIndex >> 1;
+    const double rUniform = (static_cast<double>(mixBits(uStream + 2 * uPair) >> 11) + 1.0) * rUnit;
+    const double rAngle = 6.283185307179586 * static_cast<double>(mixBits(uStream + 2 * uPair + 1) >> 11) * rUnit;
+    const double rRadius = sqrt(-2.0 * log(rUniform));
+    return rRadius * ((uIndex & 1) ? sin(rAngle) : cos(rAngle));
+}
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】Trainer
+//【函数功能】默认构造函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Trainer::Trainer() : m_uTopologyFingerprint(0), m_optimizer(new SgdOptimizer()) {
+}
+
+//-------------------------------------------------------------
+//【函数名称】~Trainer
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Trainer::~Trainer() = default;
+
+//-------------------------------------------------------------
+//【函数名称】loadFrom
+//【函数功能】从网络载入结构、激活函数和参数
+//【参数】network：源网络
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 载入时清空优化器状态
+//           2026-10-18 记录网络的拓扑指纹
+//-------------------------------------------------------------
+bool Trainer::loadFrom(const Network& network) {
+    m_optimizer->reset();
+    m_uTopologyFingerprint = 0;
+    m_layers.clear();
+    m_layerOffsets.clear();
+    m_rowLengths.clear();
+    m_parameters.clear();
+    m_gradients.clear();
+    if (network.getLayerCount() < 2 || !network.isValid()) {
+        return false;
+    }
+
+    const size_t uLayers = static_cast<size_t>(network.getLayerCount());
+    m_layers.resize(uLayers);
+    m_layerOffsets.assign(uLayers, 0);
+    m_rowLengths.resize(uLayers);
+    int64_t iPreviousWidth = 0;
+    for (int iLayerIdx = 0; iLayerIdx < network.getLayerCount(); ++iLayerIdx) {
+        const Layer* pLayer = network.getLayer(iLayerIdx);
+        CompiledLayer& layer = m_layers[iLayerIdx];
+        if (!pLayer || pLayer->getNeuronCount() == 0 || !layer.compile(*pLayer, iPreviousWidth, iLayerIdx == 0)) {
+            m_layers.clear();
+            m_layerOffsets.clear();
+            m_rowLengths.clear();
+            m_parameters.clear();
+            return false;
+        }
+        iPreviousWidth = layer.getWidth();
+        if (iLayerIdx == 0) {
+            continue;
+        }
+
+        // Dendrites beyond the previous layer's width never see an input: nothing to train there
+        vector<int64_t>& rowLengths = m_rowLengths[iLayerIdx];
+        rowLengths.resize(static_cast<size_t>(layer.getWidth()));
+        for (int iNeuronIdx = 0; iNeuronIdx < pLayer->getNeuronCount(); ++iNeuronIdx) {
+            rowLengths[iNeuronIdx] = min<int64_t>(pLayer->getNeuron(iNeuronIdx)->getInputSynapseCount(),
+                                                  layer.getInputWidth());
+        }
+        m_layerOffsets[iLayerIdx] = static_cast<int64_t>(m_parameters.size());
+        m_parameters.insert(m_parameters.end(), layer.getBiases().begin(), layer.getBiases().end());
+        m_parameters.insert(m_parameters.end(), layer.getWeights().begin(), layer.getWeights().end());
+    }
+    m_gradients.assign(m_parameters.size(), 0.0);
+    m_uTopologyFingerprint = network.getTopologyFingerprint();
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】writeTo
+//【函数功能】把训练后的偏置和权重写回网络
+//【参数】network：目标网络
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+bool Trainer::writeTo(Network& network) const {
+    if (m_layers.empty() || network.getLayerCount() != static_cast<int>(m_layers.size())) {
+        return false;
+    }
+    // Check the whole topology first so that a mismatch leaves the network untouched
+    for (size_t uLayerIdx = 0; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        const Layer* pLayer = network.getLayer(static_cast<int>(uLayerIdx));
+        if (!pLayer || pLayer->getNeuronCount() != m_layers[uLayerIdx].getWidth()) {
+            return false;
+        }
+        for (int iNeuronIdx = 0; uLayerIdx > 0 && iNeuronIdx < pLayer->getNeuronCount(); ++iNeuronIdx) {
+            const Neuron* pNeuron = pLayer->getNeuron(iNeuronIdx);
+            if (!pNeuron || pNeuron->getInputSynapseCount() < m_rowLengths[uLayerIdx][iNeuronIdx]) {
+                return false;
+            }
+        }
+    }
+
+    for (size_t uLayerIdx = 1; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        Layer* pLayer = network.getLayer(static_cast<int>(uLayerIdx));
+        const int64_t iWidth = m_layers[uLayerIdx].getWidth();
+        const int64_t iInputWidth = m_layers[uLayerIdx].getInputWidth();
+        const double* pBiases = m_parameters.data() + m_layerOffsets[uLayerIdx];
+        const double* pWeights = pBiases + iWidth;
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            Neuron* pNeuron = pLayer->getNeuron(static_cast<int>(iNeuronIdx));
+            pNeuron->setBias(pBiases[iNeuronIdx]);
+            for (int64_t iInputIdx = 0; iInputIdx < m_rowLengths[uLayerIdx][iNeuronIdx]; ++iInputIdx) {
+                pNeuron->setInputSynapseWeight(static_cast<int>(iInputIdx),
+                                               pWeights[iNeuronIdx * iInputWidth + iInputIdx]);
+            }
+        }
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】setOptimizer
+//【函数功能】更换优化器
+//【参数】optimizer：新的优化器
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Trainer::setOptimizer(unique_ptr<Optimizer> optimizer) {
+    if (optimizer) {
+        m_optimizer = move(optimizer);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOptimizer
+//【函数功能】获取当前优化器
+//【参数】无
+//【返回值】Optimizer&，优化器
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+Optimizer& Trainer::getOptimizer() {
+    return *m_optimizer;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOptimizer
+//【函数功能】获取当前优化器（只读）
+//【参数】无
+//【返回值】const Optimizer&，优化器
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const Optimizer& Trainer::getOptimizer() const {
+    return *m_optimizer;
+}
+
+//-------------------------------------------------------------
+//【函数名称】refreshLayers
+//【函数功能】把参数复制到各CompiledLayer
+//【参数】layers：各层，parameters：扁平参数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加参数，Hogwild线程刷新自己的局部副本
+//-------------------------------------------------------------
+void Trainer::refreshLayers(vector<CompiledLayer>& layers, const double* parameters) const {
+    for (size_t uLayerIdx = 1; uLayerIdx < layers.size(); ++uLayerIdx) {
+        const double* pBiases = parameters + m_layerOffsets[uLayerIdx];
+        layers[uLayerIdx].setParameters(pBiases, pBiases + layers[uLayerIdx].getWidth());
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】forwardRows
+//【函数功能】计算一批样本在每一层的输出
+//【参数】layers：各层，inputs：输入，rows：样本数，activations：每层的输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加layers参数，供Hogwild线程使用局部副本
+//-------------------------------------------------------------
+void Trainer::forwardRows(const vector<CompiledLayer>& layers, const double* inputs, int64_t rows,
+                          vector<vector<double>>& activations) const {
+    activations.resize(layers.size());
+    const double* pInputs = inputs;
+    int64_t iInputStride = layers[0].getWidth();
+    for (size_t uLayerIdx = 0; uLayerIdx < layers.size(); ++uLayerIdx) {
+        // The matrix kernels store whole panels, so rows are padded like in CompiledNetwork
+        const int64_t iStride = PackedGemm::getPaddedWidth(layers[uLayerIdx].getWidth());
+        activations[uLayerIdx].resize(static_cast<size_t>(rows * iStride));
+        layers[uLayerIdx].forwardBatch(pInputs, iInputStride, rows, activations[uLayerIdx].data(), iStride);
+        pInputs = activations[uLayerIdx].data();
+        iInputStride = iStride;
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】squaredError
+//【函数功能】分块批量前向计算并累加误差平方
+//【参数】layers：各层，inputs：输入，targets：目标，rows：样本数
+//【返回值】double，误差平方和
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::squaredError(const vector<CompiledLayer>& layers, const double* inputs, const double* targets,
+                             int64_t rows) const {
+    const int64_t iInputs = getInputSize();
+    const int64_t iOutputs = getOutputSize();
+    const int64_t iStride = PackedGemm::getPaddedWidth(iOutputs);
+    const int64_t iChunk = VALIDATION_ROWS;
+    vector<vector<double>> activations;
+    double rSum = 0.0;
+    for (int64_t iFirst = 0; iFirst < rows; iFirst += iChunk) {
+        const int64_t iRows = min(iChunk, rows - iFirst);
+        forwardRows(layers, inputs + iFirst * iInputs, iRows, activations);
+        const double* pTargets = targets + iFirst * iOutputs;
+        for (int64_t iRow = 0; iRow < iRows; ++iRow) {
+            for (int64_t iOutputIdx = 0; iOutputIdx < iOutputs; ++iOutputIdx) {
+                double rError = activations.back()[iRow * iStride + iOutputIdx] - pTargets[iRow * iOutputs + iOutputIdx];
+                rSum += rError * rError;
+            }
+        }
+    }
+    return rSum;
+}
+
+//-------------------------------------------------------------
+//【函数名称】objectiveLoss
+//【函数功能】分块批量前向计算全部样本的输出并计算目标函数
+//【参数】layers：各层，inputs：输入，rows：样本数，objective：目标函数，outputs：输出缓冲区，
+//       activations：前向计算的缓冲区
+//【返回值】double，目标函数的返回值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::objectiveLoss(const vector<CompiledLayer>& layers, const double* inputs, int64_t rows,
+                              const function<double(const double*, int64_t)>& objective, vector<double>& outputs,
+                              vector<vector<double>>& activations) const {
+    const int64_t iInputs = getInputSize();
+    const int64_t iOutputs = getOutputSize();
+    const int64_t iStride = PackedGemm::getPaddedWidth(iOutputs);
+    const int64_t iChunk = VALIDATION_ROWS;
+    outputs.resize(static_cast<size_t>(rows * iOutputs));
+    for (int64_t iFirst = 0; iFirst < rows; iFirst += iChunk) {
+        const int64_t iRows = min(iChunk, rows - iFirst);
+        forwardRows(layers, inputs + iFirst * iInputs, iRows, activations);
+        // The objective sees plain rows, not the padded panels of the matrix kernels
+        for (int64_t iRow = 0; iRow < iRows; ++iRow) {
+            const double* pSource = activations.back().data() + iRow * iStride;
+            copy(pSource, pSource + iOutputs, outputs.begin() + (iFirst + iRow) * iOutputs);
+        }
+    }
+    return objective(outputs.data(), rows);
+}
+
+//-------------------------------------------------------------
+//【函数名称】maskUnusedWeights
+//【函数功能】把没有对应树突的权重位置置为0
+//【参数】parameters：扁平参数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Trainer::maskUnusedWeights(double* parameters) const {
+    // Positions without a dendrite must stay 0 to keep the semantics of the network
+    for (size_t uLayerIdx = 1; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        const int64_t iWidth = m_layers[uLayerIdx].getWidth();
+        const int64_t iInputWidth = m_layers[uLayerIdx].getInputWidth();
+        double* pWeights = parameters + m_layerOffsets[uLayerIdx] + iWidth;
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            fill(pWeights + iNeuronIdx * iInputWidth + m_rowLengths[uLayerIdx][iNeuronIdx],
+                 pWeights + (iNeuronIdx + 1) * iInputWidth, 0.0);
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】acquireWorkspace
+//【函数功能】取出一个空闲的临时缓冲区，没有时新建
+//【参数】无
+//【返回值】unique_ptr<Workspace>，缓冲区
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+unique_ptr<Trainer::Workspace> Trainer::acquireWorkspace() {
+    lock_guard<mutex> lock(m_workspaceMutex);
+    if (m_freeWorkspaces.empty()) {
+        return unique_ptr<Workspace>(new Workspace());
+    }
+    unique_ptr<Workspace> workspace = move(m_freeWorkspaces.back());
+    m_freeWorkspaces.pop_back();
+    return workspace;
+}
+
+//-------------------------------------------------------------
+//【函数名称】releaseWorkspace
+//【函数功能】归还临时缓冲区
+//【参数】workspace：缓冲区
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Trainer::releaseWorkspace(unique_ptr<Workspace> workspace) {
+    lock_guard<mutex> lock(m_workspaceMutex);
+    m_freeWorkspaces.push_back(move(workspace));
+}
+
+//-------------------------------------------------------------
+//【函数名称】accumulateGradients
+//【函数功能】对若干样本做前向和反向传播，梯度累加到gradients
+//【参数】layers：各层，parameters：与layers一致的扁平参数，inputs：输入，targets：目标，
+//       rows：样本数，scale：输出误差的系数，workspace：临时缓冲区，gradients：累加目标，
+//       touched：不为空时标记梯度非零的神经元
+//【返回值】double，误差平方和
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加layers和parameters参数，供Hogwild线程使用局部副本
+//           2026-10-18 增加touched参数，Hogwild只写回被标记的行
+//-------------------------------------------------------------
+double Trainer::accumulateGradients(const vector<CompiledLayer>& layers, const double* parameters,
+                                    const double* inputs, const double* targets, int64_t rows, double scale,
+                                    Workspace& workspace, double* gradients,
+                                    vector<vector<uint8_t>>* touched) const {
+    forwardRows(layers, inputs, rows, workspace.activations);
+
+    // Output layer: dLoss/dSum = scale * (y - t) * f'(y)
+    const size_t uLast = layers.size() - 1;
+    const int64_t iOutputs = layers[uLast].getWidth();
+    const int64_t iOutputStride = PackedGemm::getPaddedWidth(iOutputs);
+    const int32_t* pCodes = layers[uLast].getActivationCodes().data();
+    const double* pOutputs = workspace.activations[uLast].data();
+    double rLoss = 0.0;
+    workspace.delta.resize(static_cast<size_t>(rows * iOutputs));
+    for (int64_t iRow = 0; iRow < rows; ++iRow) {
+        for (int64_t iOutputIdx = 0; iOutputIdx < iOutputs; ++iOutputIdx) {
+            const int64_t iIdx = iRow * iOutputs + iOutputIdx;
+            double rOutput = pOutputs[iRow * iOutputStride + iOutputIdx];
+            double rError = rOutput - targets[iIdx];
+            rLoss += rError * rError;
+            workspace.delta[iIdx] = scale * rError * CompiledLayer::applyDerivative(pCodes[iOutputIdx], rOutput);
+        }
+    }
+
+    const KernelIsa isa = KernelDispatch::getActiveIsa();
+    for (size_t uLayerIdx = uLast; uLayerIdx >= 1; --uLayerIdx) {
+        const int64_t iWidth = layers[uLayerIdx].getWidth();
+        const int64_t iInputWidth = layers[uLayerIdx].getInputWidth();
+        const int64_t iInputStride = PackedGemm::getPaddedWidth(iInputWidth);
+        const vector<int64_t>& rowLengths = m_rowLengths[uLayerIdx];
+        const double* pInputs = workspace.activations[uLayerIdx - 1].data();
+        double* pBiasGradients = gradients + m_layerOffsets[uLayerIdx];
+        double* pWeightGradients = pBiasGradients + iWidth;
+
+        // A neuron's weight-gradient row stays in cache while the batch's inputs stream past it
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            double* pRow = pWeightGradients + iNeuronIdx * iInputWidth;
+            bool bTouched = false;
+            for (int64_t iRow = 0; iRow < rows; ++iRow) {
+                double rDelta = workspace.delta[iRow * iWidth + iNeuronIdx];
+                pBiasGradients[iNeuronIdx] += rDelta;
+                if (rDelta != 0.0) {
+                    KernelDispatch::axpy(isa, rowLengths[iNeuronIdx], rDelta, pInputs + iRow * iInputStride, pRow);
+                    bTouched = true;
+                }
+            }
+            if (touched && bTouched) {
+                (*touched)[uLayerIdx][iNeuronIdx] = 1;
+            }
+        }
+        if (uLayerIdx == 1) {
+            break;  // The input layer is not trained, so its delta is never needed
+        }
+
+        // delta_below = (W^T · delta) ⊙ f'(y_below), a block of weight rows at a time
+        const double* pWeights = parameters + m_layerOffsets[uLayerIdx] + iWidth;
+        workspace.previousDelta.assign(static_cast<size_t>(rows * iInputWidth), 0.0);
+        const int64_t iBlockRows = max<int64_t>(1, BACKWARD_BLOCK_DOUBLES / iInputWidth);
+        for (int64_t iFirst = 0; iFirst < iWidth; iFirst += iBlockRows) {
+            const int64_t iEnd = min(iWidth, iFirst + iBlockRows);
+            for (int64_t iRow = 0; iRow < rows; ++iRow) {
+                double* pTarget = workspace.previousDelta.data() + iRow * iInputWidth;
+                for (int64_t iNeuronIdx = iFirst; iNeuronIdx < iEnd; ++iNeuronIdx) {
+                    double rDelta = workspace.delta[iRow * iWidth + iNeuronIdx];
+                    if (rDelta != 0.0) {
+                        KernelDispatch::axpy(isa, rowLengths[iNeuronIdx], rDelta,
+                                             pWeights + iNeuronIdx * iInputWidth, pTarget);
+                    }
+                }
+            }
+        }
+        const int32_t* pBelowCodes = layers[uLayerIdx - 1].getActivationCodes().data();
+        for (int64_t iRow = 0; iRow < rows; ++iRow) {
+            for (int64_t iInputIdx = 0; iInputIdx < iInputWidth; ++iInputIdx) {
+                workspace.previousDelta[iRow * iInputWidth + iInputIdx] *=
+                    CompiledLayer::applyDerivative(pBelowCodes[iInputIdx], pInputs[iRow * iInputStride + iInputIdx]);
+            }
+        }
+        workspace.delta.swap(workspace.previousDelta);
+    }
+    return rLoss;
+}
+
+//-------------------------------------------------------------
+//【函数名称】computeGradients
+//【函数功能】对一批样本做前向和反向传播
+//【参数】inputs：输入，targets：目标，rows：样本数
+//【返回值】double，均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 计算移到accumulateGradients，与并行版本共用
+//-------------------------------------------------------------
+double Trainer::computeGradients(const double* inputs, const double* targets, int64_t rows) {
+    fill(m_gradients.begin(), m_gradients.end(), 0.0);
+    if (m_layers.empty() || rows <= 0) {
+        return 0.0;
+    }
+    const double rCount = static_cast<double>(rows * getOutputSize());
+    unique_ptr<Workspace> workspace = acquireWorkspace();
+    double rLoss = accumulateGradients(m_layers, m_parameters.data(), inputs, targets, rows, 2.0 / rCount,
+                                       *workspace, m_gradients.data());
+    releaseWorkspace(move(workspace));
+    return rLoss / rCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】computeGradients
+//【函数功能】把一批样本分给线程池计算梯度，各分片的梯度在线程局部缓冲区中归约
+//【参数】inputs：输入，targets：目标，rows：样本数，pool：线程池，mode：归约方式
+//【返回值】double，均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::computeGradients(const double* inputs, const double* targets, int64_t rows,
+                                 ThreadPool& pool, ReductionMode mode) {
+    fill(m_gradients.begin(), m_gradients.end(), 0.0);
+    if (m_layers.empty() || rows <= 0) {
+        return 0.0;
+    }
+    // The squared error rides along as one extra element, so one reduction yields both
+    const int64_t iParameters = getParameterCount();
+    const int64_t iInputs = getInputSize();
+    const int64_t iOutputs = getOutputSize();
+    const double rCount = static_cast<double>(rows * iOutputs);
+    m_reduced.resize(static_cast<size_t>(iParameters + 1));
+    ParallelReduction::sum(pool, mode, rows, iParameters + 1, [&](int64_t iBegin, int64_t iEnd, double* pAccumulator) {
+        unique_ptr<Workspace> workspace = acquireWorkspace();
+        pAccumulator[iParameters] += accumulateGradients(m_layers, m_parameters.data(), inputs + iBegin * iInputs,
+                                                         targets + iBegin * iOutputs, iEnd - iBegin, 2.0 / rCount,
+                                                         *workspace, pAccumulator);
+        releaseWorkspace(move(workspace));
+    }, m_reduced.data());
+    copy(m_reduced.begin(), m_reduced.begin() + iParameters, m_gradients.begin());
+    return m_reduced[iParameters] / rCount;
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainBatch
+//【函数功能】计算一批样本的梯度并更新一次参数
+//【参数】inputs：输入，targets：目标，rows：样本数
+//【返回值】double，更新前的均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainBatch(const double* inputs, const double* targets, int64_t rows) {
+    double rLoss = computeGradients(inputs, targets, rows);
+    applyUpdate(rows);
+    return rLoss;
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainBatch
+//【函数功能】在线程池上计算一批样本的梯度，归约后更新一次参数
+//【参数】inputs：输入，targets：目标，rows：样本数，pool：线程池，mode：归约方式
+//【返回值】double，更新前的均方误差
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainBatch(const double* inputs, const double* targets, int64_t rows,
+                           ThreadPool& pool, ReductionMode mode) {
+    double rLoss = computeGradients(inputs, targets, rows, pool, mode);
+    applyUpdate(rows);
+    return rLoss;
+}
+
+//-------------------------------------------------------------
+//【函数名称】applyUpdate
+//【函数功能】由优化器按当前梯度更新参数并刷新各层
+//【参数】rows：本批样本数（不大于0时不更新）
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void Trainer::applyUpdate(int64_t rows) {
+    if (m_layers.empty() || rows <= 0) {
+        return;
+    }
+    m_optimizer->step(m_parameters.data(), m_gradients.data(), static_cast<int64_t>(m_parameters.size()));
+    refreshLayers(m_layers, m_parameters.data());
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainEpoch
+//【函数功能】按顺序分批训练一遍数据集
+//【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数
+//【返回值】double，加权平均均方误差，数据长度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 与并行版本共用runEpoch
+//-------------------------------------------------------------
+double Trainer::trainEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                           int64_t batchSize) {
+    return runEpoch(inputs, targets, rows, batchSize, nullptr, ReductionMode::Deterministic);
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainEpoch
+//【函数功能】按顺序分批训练一遍数据集，每批在线程池上并行计算
+//【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，pool：线程池，mode：归约方式
+//【返回值】double，加权平均均方误差，数据长度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                           int64_t batchSize, ThreadPool& pool, ReductionMode mode) {
+    return runEpoch(inputs, targets, rows, batchSize, &pool, mode);
+}
+
+//-------------------------------------------------------------
+//【函数名称】runEpoch
+//【函数功能】按顺序分批训练一遍数据集
+//【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，
+//       pool：线程池（为nullptr时单线程），mode：归约方式
+//【返回值】double，加权平均均方误差，数据长度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::runEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                         int64_t batchSize, ThreadPool* pool, ReductionMode mode) {
+    if (m_layers.empty() || rows <= 0 ||
+        static_cast<int64_t>(inputs.size()) != rows * getInputSize() ||
+        static_cast<int64_t>(targets.size()) != rows * getOutputSize()) {
+        return -1.0;
+    }
+    const int64_t iBatch = max<int64_t>(1, batchSize);
+    double rTotal = 0.0;
+    for (int64_t iFirst = 0; iFirst < rows; iFirst += iBatch) {
+        const int64_t iRows = min(iBatch, rows - iFirst);
+        const double* pInputs = inputs.data() + iFirst * getInputSize();
+        const double* pTargets = targets.data() + iFirst * getOutputSize();
+        double rLoss = pool ? trainBatch(pInputs, pTargets, iRows, *pool, mode) : trainBatch(pInputs, pTargets, iRows);
+        rTotal += rLoss * static_cast<double>(iRows);
+    }
+    return rTotal / static_cast<double>(rows);
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainEpoch
+//【函数功能】按加载器给出的批次训练一轮
+//【参数】loader：批次加载器
+//【返回值】double，加权平均均方误差，宽度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainEpoch(BatchLoader& loader) {
+    return runEpoch(loader, nullptr, ReductionMode::Deterministic);
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainEpoch
+//【函数功能】按加载器给出的批次在线程池上训练一轮
+//【参数】loader：批次加载器，pool：线程池，mode：归约方式
+//【返回值】double，加权平均均方误差，宽度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainEpoch(BatchLoader& loader, ThreadPool& pool, ReductionMode mode) {
+    return runEpoch(loader, &pool, mode);
+}
+
+//-------------------------------------------------------------
+//【函数名称】runEpoch
+//【函数功能】按加载器给出的批次训练一轮
+//【参数】loader：批次加载器，pool：线程池（为nullptr时单线程），mode：归约方式
+//【返回值】double，加权平均均方误差，宽度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::runEpoch(BatchLoader& loader, ThreadPool* pool, ReductionMode mode) {
+    const Dataset& dataset = loader.getDataset();
+    if (m_layers.empty() || dataset.getRowCount() <= 0 ||
+        dataset.getInputWidth() != getInputSize() || dataset.getTargetWidth() != getOutputSize()) {
+        return -1.0;
+    }
+    loader.startEpoch();
+    double rTotal = 0.0;
+    // While this batch computes, the loader's thread assembles the next one
+    for (const MiniBatch* pBatch = loader.nextBatch(); pBatch; pBatch = loader.nextBatch()) {
+        const double* pInputs = pBatch->inputs.data();
+        const double* pTargets = pBatch->targets.data();
+        double rLoss = pool ? trainBatch(pInputs, pTargets, pBatch->rows, *pool, mode)
+                            : trainBatch(pInputs, pTargets, pBatch->rows);
+        rTotal += rLoss * static_cast<double>(pBatch->rows);
+    }
+    return rTotal / static_cast<double>(dataset.getRowCount());
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainEpochHogwild
+//【函数功能】Hogwild式异步SGD：各线程无锁读写共享参数，批与批之间没有屏障
+//【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，pool：线程池
+//【返回值】double，各批更新前误差的加权平均，数据长度不符或优化器不是SGD时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 每批只读取被改过的行、只写回梯度非零的行；拒绝SGD以外的优化器
+//-------------------------------------------------------------
+double Trainer::trainEpochHogwild(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                                  int64_t batchSize, ThreadPool& pool) {
+    if (m_layers.empty() || rows <= 0 || m_optimizer->getName() != "SGD" ||
+        static_cast<int64_t>(inputs.size()) != rows * getInputSize() ||
+        static_cast<int64_t>(targets.size()) != rows * getOutputSize()) {
+        return -1.0;
+    }
+    const int64_t iParameters = getParameterCount();
+    const int64_t iInputs = getInputSize();
+    const int64_t iOutputs = getOutputSize();
+    const int64_t iBatch = max<int64_t>(1, batchSize);
+    const double rStep = -m_optimizer->getLearningRate();
+
+    // One row per trainable neuron: its bias and its weights, each row with a version counter
+    struct HogwildRow {
+        size_t uLayer;
+        int64_t iNeuron;
+        int64_t iBias;      // Index of the bias in the flat parameters
+        int64_t iWeights;   // Index of the first weight
+        int64_t iLength;    // Trainable weights
+    };
+    vector<HogwildRow> rowList;
+    vector<vector<int64_t>> rowIndices(m_layers.size());
+    for (size_t uLayerIdx = 1; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+        const int64_t iWidth = m_layers[uLayerIdx].getWidth();
+        const int64_t iInputWidth = m_layers[uLayerIdx].getInputWidth();
+        for (int64_t iNeuronIdx = 0; iNeuronIdx < iWidth; ++iNeuronIdx) {
+            rowIndices[uLayerIdx].push_back(static_cast<int64_t>(rowList.size()));
+            rowList.push_back(HogwildRow{uLayerIdx, iNeuronIdx, m_layerOffsets[uLayerIdx] + iNeuronIdx,
+                                         m_layerOffsets[uLayerIdx] + iWidth + iNeuronIdx * iInputWidth,
+                                         m_rowLengths[uLayerIdx][iNeuronIdx]});
+        }
+    }
+    const size_t uRows = rowList.size();
+
+    // The shared model: relaxed atomics are plain loads and stores on x86-64, but keep the races defined.
+    // A writer bumps the row's version after its stores (release), so readers re-read only changed rows
+    unique_ptr<atomic<double>[]> shared(new atomic<double>[static_cast<size_t>(iParameters)]);
+    for (int64_t iIdx = 0; iIdx < iParameters; ++iIdx) {
+        shared[iIdx].store(m_parameters[iIdx], memory_order_relaxed);
+    }
+    unique_ptr<atomic<uint64_t>[]> versions(new atomic<uint64_t>[uRows]);
+    for (size_t uRow = 0; uRow < uRows; ++uRow) {
+        versions[uRow].store(0, memory_order_relaxed);
+    }
+
+    // Per executor: private copies of the layers and parameters it last read, the row versions
+    // they correspond to, and its gradients (all zero between batches)
+    struct HogwildWorker {
+        vector<CompiledLayer> layers;
+        vector<double> parameters;
+        vector<uint64_t> versions;
+        vector<double> gradients;
+        vector<vector<uint8_t>> touched;
+        double rSquaredError = 0.0;
+    };
+    vector<HogwildWorker> workers(static_cast<size_t>(pool.getThreadCount()));
+    pool.parallelFor((rows + iBatch - 1) / iBatch, [&](int64_t iBatchIdx, int iWorker) {
+        HogwildWorker& worker = workers[iWorker];
+        if (worker.layers.empty()) {
+            // m_layers and m_parameters are the version-0 state of every row
+            worker.layers = m_layers;
+            worker.parameters = m_parameters;
+            worker.versions.assign(uRows, 0);
+            worker.gradients.assign(static_cast<size_t>(iParameters), 0.0);
+            worker.touched.resize(m_layers.size());
+            for (size_t uLayerIdx = 1; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+                worker.touched[uLayerIdx].assign(static_cast<size_t>(m_layers[uLayerIdx].getWidth()), 0);
+            }
+        }
+        // Refresh the rows other executors changed; a row may be torn by a writer still storing it,
+        // in which case its version has moved on again and it is re-read before the next batch
+        for (size_t uRow = 0; uRow < uRows; ++uRow) {
+            const uint64_t uVersion = versions[uRow].load(memory_order_acquire);
+            if (uVersion == worker.versions[uRow]) {
+                continue;
+            }
+            const HogwildRow& row = rowList[uRow];
+            double* pBias = worker.parameters.data() + row.iBias;
+            double* pWeights = worker.parameters.data() + row.iWeights;
+            *pBias = shared[row.iBias].load(memory_order_relaxed);
+            for (int64_t iIdx = 0; iIdx < row.iLength; ++iIdx) {
+                pWeights[iIdx] = shared[row.iWeights + iIdx].load(memory_order_relaxed);
+            }
+            worker.layers[row.uLayer].setNeuronParameters(row.iNeuron, *pBias, pWeights);
+            worker.versions[uRow] = uVersion;
+        }
+
+        const int64_t iFirst = iBatchIdx * iBatch;
+        const int64_t iRows = min(iBatch, rows - iFirst);
+        unique_ptr<Workspace> workspace = acquireWorkspace();
+        worker.rSquaredError += accumulateGradients(worker.layers, worker.parameters.data(),
+                                                    inputs.data() + iFirst * iInputs, targets.data() + iFirst * iOutputs,
+                                                    iRows, 2.0 / static_cast<double>(iRows * iOutputs),
+                                                    *workspace, worker.gradients.data(), &worker.touched);
+        releaseWorkspace(move(workspace));
+
+        // Unsynchronised read-modify-write of the touched rows only: a concurrent update of the same
+        // element may be lost, but sparse gradients rarely collide. Untouched rows have zero gradients
+        for (size_t uLayerIdx = 1; uLayerIdx < m_layers.size(); ++uLayerIdx) {
+            vector<uint8_t>& touched = worker.touched[uLayerIdx];
+            for (size_t uNeuronIdx = 0; uNeuronIdx < touched.size(); ++uNeuronIdx) {
+                if (!touched[uNeuronIdx]) {
+                    continue;
+                }
+                touched[uNeuronIdx] = 0;
+                const int64_t iRow = rowIndices[uLayerIdx][uNeuronIdx];
+                const HogwildRow& row = rowList[static_cast<size_t>(iRow)];
+                double* pGradient = worker.gradients.data() + row.iBias;
+                shared[row.iBias].store(shared[row.iBias].load(memory_order_relaxed) + rStep * *pGradient,
+                                        memory_order_relaxed);
+                *pGradient = 0.0;
+                pGradient = worker.gradients.data() + row.iWeights;
+                for (int64_t iIdx = 0; iIdx < row.iLength; ++iIdx) {
+                    if (pGradient[iIdx] != 0.0) {
+                        atomic<double>& rParameter = shared[row.iWeights + iIdx];
+                        rParameter.store(rParameter.load(memory_order_relaxed) + rStep * pGradient[iIdx],
+                                         memory_order_relaxed);
+                        pGradient[iIdx] = 0.0;
+                    }
+                }
+                versions[static_cast<size_t>(iRow)].fetch_add(1, memory_order_release);
+            }
+        }
+    });
+
+    // parallelFor has joined every executor, so the final values are visible
+    for (int64_t iIdx = 0; iIdx < iParameters; ++iIdx) {
+        m_parameters[iIdx] = shared[iIdx].load(memory_order_relaxed);
+    }
+    refreshLayers(m_layers, m_parameters.data());
+    double rSquaredError = 0.0;
+    for (const HogwildWorker& worker : workers) {
+        rSquaredError += worker.rSquaredError;
+    }
+    return rSquaredError / static_cast<double>(rows * iOutputs);
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainWithValidation
+//【函数功能】训练并与之并行地验证每轮的参数，验证误差停滞时提前停止
+//【参数】inputs、targets、rows：训练集，validationInputs、validationTargets、validationRows：验证集，
+//       batchSize：每批样本数，maxEpochs：最多轮数，patience：容忍的未改善轮数，minDelta：最小降幅，
+//       pool：线程池，mode：归约方式
+//【返回值】TrainingReport，各轮误差与早停信息
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+TrainingReport Trainer::trainWithValidation(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                                            const vector<double>& validationInputs,
+                                            const vector<double>& validationTargets, int64_t validationRows,
+                                            int64_t batchSize, int maxEpochs, int patience, double minDelta,
+                                            ThreadPool& pool, ReductionMode mode) {
+    TrainingReport report;
+    if (m_layers.empty() || rows <= 0 || validationRows <= 0 ||
+        static_cast<int64_t>(inputs.size()) != rows * getInputSize() ||
+        static_cast<int64_t>(targets.size()) != rows * getOutputSize() ||
+        static_cast<int64_t>(validationInputs.size()) != validationRows * getInputSize() ||
+        static_cast<int64_t>(validationTargets.size()) != validationRows * getOutputSize()) {
+        return report;
+    }
+
+    // Owned by the validation thread while a validation is pending
+    vector<CompiledLayer> validationLayers = m_layers;
+    vector<double> snapshot(m_parameters.size());
+    vector<double> best;
+    future<double> pending;
+    const double rScale = 1.0 / static_cast<double>(validationRows * getOutputSize());
+    auto validate = [&]() {
+        refreshLayers(validationLayers, snapshot.data());
+        return squaredError(validationLayers, validationInputs.data(), validationTargets.data(), validationRows) *
+               rScale;
+    };
+    // Records the pending result for the epoch before; true when training should stop
+    auto collect = [&]() {
+        const double rLoss = pending.get();
+        const int iEpoch = static_cast<int>(report.validationLosses.size());
+        report.validationLosses.push_back(rLoss);
+        if (report.iBestEpoch < 0 || rLoss < report.rBestValidationLoss - minDelta) {
+            report.iBestEpoch = iEpoch;
+            report.rBestValidationLoss = rLoss;
+            best = snapshot;
+        }
+        return iEpoch - report.iBestEpoch >= max(1, patience);
+    };
+
+    for (int iEpoch = 0; iEpoch < maxEpochs; ++iEpoch) {
+        report.trainingLosses.push_back(trainEpoch(inputs, targets, rows, batchSize, pool, mode));
+        // The previous epoch's validation ran alongside this epoch
+        if (pending.valid() && collect()) {
+            report.bStoppedEarly = true;
+            break;
+        }
+        copy(m_parameters.begin(), m_parameters.end(), snapshot.begin());
+        pending = async(launch::async, validate);
+    }
+    if (pending.valid() && collect() && static_cast<int>(report.trainingLosses.size()) < maxEpochs) {
+        report.bStoppedEarly = true;
+    }
+    // An epoch trained before the stop was decided has no validation and is dropped with the rest
+    report.trainingLosses.resize(report.validationLosses.size());
+    if (!best.empty()) {
+        m_parameters = best;
+        refreshLayers(m_layers, m_parameters.data());
+    }
+    return report;
+}
+
+//-------------------------------------------------------------
+//【函数名称】trainGenerationEvolution
+//【函数功能】进化策略训练一代
+//【参数】inputs：输入，rows：样本数，objective：目标函数，settings：种群参数，generation：代数，pool：线程池
+//【返回值】double，各扰动损失的平均值，参数无效时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::trainGenerationEvolution(const vector<double>& inputs, int64_t rows,
+                                         const function<double(const double*, int64_t)>& objective,
+                                         const EvolutionSettings& settings, int64_t generation, ThreadPool& pool) {
+    if (m_layers.empty() || rows <= 0 || static_cast<int64_t>(inputs.size()) != rows * getInputSize() ||
+        !objective || settings.iPopulation < 2 || !(settings.rSigma > 0.0)) {
+        return -1.0;
+    }
+    const int64_t iParameters = getParameterCount();
+    const int64_t iPairs = (settings.iPopulation + 1) / 2;
+    const int64_t iMembers = 2 * iPairs;
+    const uint64_t uGenerationKey = mixBits(settings.uSeed ^ mixBits(static_cast<uint64_t>(generation)));
+    auto pairStream = [uGenerationKey](int64_t iPair) { return mixBits(uGenerationKey + static_cast<uint64_t>(iPair)); };
+
+    // Per executor: private layers and the perturbed parameters it is evaluating
+    struct EvolutionWorker {
+        vector<CompiledLayer> layers;
+        vector<double> parameters;
+        vector<double> outputs;
+        vector<vector<double>> activations;
+    };
+    vector<EvolutionWorker> workers(static_cast<size_t>(pool.getThreadCount()));
+    vector<double> losses(static_cast<size_t>(iMembers));
+    pool.parallelFor(iMembers, [&](int64_t iMember, int iWorker) {
+        EvolutionWorker& worker = workers[iWorker];
+        if (worker.layers.empty()) {
+            worker.layers = m_layers;
+            worker.parameters.resize(static_cast<size_t>(iParameters));
+        }
+        // Members 2k and 2k+1 are the mirrored pair mean ± sigma·noise_k
+        const uint64_t uStream = pairStream(iMember / 2);
+        const double rScale = iMember % 2 == 0 ? settings.rSigma : -settings.rSigma;
+        for (int64_t iIdx = 0; iIdx < iParameters; ++iIdx) {
+            worker.parameters[iIdx] = m_parameters[iIdx] + rScale * counterGaussian(uStream, static_cast<uint64_t>(iIdx));
+        }
+        maskUnusedWeights(worker.parameters.data());
+        refreshLayers(worker.layers, worker.parameters.data());
+        losses[iMember] = objectiveLoss(worker.layers, inputs.data(), rows, objective, worker.outputs,
+                                        worker.activations);
+    });
+
+    // Centred ranks: only the order of the losses matters, non-finite losses rank last
+    vector<int64_t> order(static_cast<size_t>(iMembers));
+    for (int64_t iMember = 0; iMember < iMembers; ++iMember) {
+        order[iMember] = iMember;
+    }
+    auto rankKey = [&losses](int64_t iMember) {
+        return isfinite(losses[iMember]) ? losses[iMember] : numeric_limits<double>::infinity();
+    };
+    stable_sort(order.begin(), order.end(), [&rankKey](int64_t iLeft, int64_t iRight) {
+        return rankKey(iLeft) < rankKey(iRight);
+    });
+    vector<double> utilities(static_cast<size_t>(iMembers));
+    for (int64_t iRank = 0; iRank < iMembers; ++iRank) {
+        utilities[order[iRank]] = 0.5 - static_cast<double>(iRank) / static_cast<double>(iMembers - 1);
+    }
+    // Loss gradient estimate: -1/(N·sigma) · sum over pairs of (u+ - u-)·noise
+    vector<double> pairWeights(static_cast<size_t>(iPairs));
+    for (int64_t iPair = 0; iPair < iPairs; ++iPair) {
+        pairWeights[iPair] = -(utilities[2 * iPair] - utilities[2 * iPair + 1]) /
+                             (static_cast<double>(iMembers) * settings.rSigma);
+    }
+
+    // Each chunk regenerates the noise it needs; pairs are always added in the same order
+    pool.parallelFor((iParameters + EVOLUTION_CHUNK - 1) / EVOLUTION_CHUNK, [&](int64_t iChunk, int) {
+        const int64_t iFirst = iChunk * EVOLUTION_CHUNK;
+        const int64_t iLast = min(iParameters, iFirst + EVOLUTION_CHUNK);
+        fill(m_gradients.begin() + iFirst, m_gradients.begin() + iLast, 0.0);
+        for (int64_t iPair = 0; iPair < iPairs; ++iPair) {
+            const double rWeight = pairWeights[iPair];
+            if (rWeight == 0.0) {
+                continue;
+            }
+            const uint64_t uStream = pairStream(iPair);
+            for (int64_t iIdx = iFirst; iIdx < iLast; ++iIdx) {
+                m_gradients[iIdx] += rWeight * counterGaussian(uStream, static_cast<uint64_t>(iIdx));
+            }
+        }
+    });
+    maskUnusedWeights(m_gradients.data());
+    m_optimizer->step(m_parameters.data(), m_gradients.data(), iParameters);
+    refreshLayers(m_layers, m_parameters.data());
+
+    double rSum = 0.0;
+    for (double rLoss : losses) {
+        rSum += rLoss;
+    }
+    return rSum / static_cast<double>(iMembers);
+}
+
+//-------------------------------------------------------------
+//【函数名称】evaluateObjective
+//【函数功能】用当前参数计算目标函数的损失
+//【参数】inputs：输入，rows：样本数，objective：目标函数
+//【返回值】double，损失，数据长度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double Trainer::evaluateObjective(const vector<double>& inputs, int64_t rows,
+                                  const function<double(const double*, int64_t)>& objective) const {
+    if (m_layers.empty() || rows <= 0 || static_cast<int64_t>(inputs.size()) != rows * getInputSize() || !objective) {
+        return -1.0;
+    }
+    vector<double> outputs;
+    vector<vector<double>> activations;
+    return objectiveLoss(m_layers, inputs.data(), rows, objective, outputs, activations);
+}
+
+//-------------------------------------------------------------
+//【函数名称】evaluate
+//【函数功能】计算当前参数在数据集上的均方误差
+//【参数】inputs：输入，targets：目标，rows：样本数
+//【返回值】double，均方误差，数据长度不符时为-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 按块计算
+//-------------------------------------------------------------
+double Trainer::evaluate(const vector<double>& inputs, const vector<double>& targets, int64_t rows) const {
+    if (m_layers.empty() || rows <= 0 ||
+        static_cast<int64_t>(inputs.size()) != rows * getInputSize() ||
+        static_cast<int64_t>(targets.size()) != rows * getOutputSize()) {
+        return -1.0;
+    }
+    return squaredError(m_layers, inputs.data(), targets.data(), rows) / static_cast<double>(rows * getOutputSize());
+}
+
+//-------------------------------------------------------------
+//【函数名称】predict
+//【函数功能】用当前参数计算一个样本的输出
+//【参数】input：输入
+//【返回值】vector<double>，输出
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+vector<double> Trainer::predict(const vector<double>& input) const {
+    if (m_layers.empty()) {
+        throw runtime_error("Trainer has no network");
+    }
+    if (static_cast<int64_t>(input.size()) != getInputSize()) {
+        throw runtime_error("Input size mismatch with first layer neuron count");
+    }
+    vector<vector<double>> activations;
+    forwardRows(m_layers, input.data(), 1, activations);
+    return vector<double>(activations.back().begin(), activations.back().begin() + getOutputSize());
+}
+
+//-------------------------------------------------------------
+//【函数名称】setParameters
+//【函数功能】整体替换参数数组
+//【参数】parameters：参数
+//【返回值】bool，是否成功
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 未使用位置的置零移至maskUnusedWeights
+//-------------------------------------------------------------
+bool Trainer::setParameters(const vector<double>& parameters) {
+    if (m_layers.empty() || parameters.size() != m_parameters.size()) {
+        return false;
+    }
+    m_parameters = parameters;
+    maskUnusedWeights(m_parameters.data());
+    refreshLayers(m_layers, m_parameters.data());
+    return true;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getParameters
+//【函数功能】获取扁平参数数组
+//【参数】无
+//【返回值】const vector<double>&，参数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<double>& Trainer::getParameters() const {
+    return m_parameters;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getGradients
+//【函数功能】获取最近一次的梯度
+//【参数】无
+//【返回值】const vector<double>&，梯度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+const vector<double>& Trainer::getGradients() const {
+    return m_gradients;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getParameterCount
+//【函数功能】获取参数数组长度
+//【参数】无
+//【返回值】int64_t，参数个数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Trainer::getParameterCount() const {
+    return static_cast<int64_t>(m_parameters.size());
+}
+
+//-------------------------------------------------------------
+//【函数名称】getTopologyFingerprint
+//【函数功能】获取载入网络的拓扑指纹
+//【参数】无
+//【返回值】uint64_t，指纹值
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+uint64_t Trainer::getTopologyFingerprint() const {
+    return m_uTopologyFingerprint;
+}
+
+//-------------------------------------------------------------
+//【函数名称】getInputSize
+//【函数功能】获取输入长度
+//【参数】无
+//【返回值】int64_t，输入层宽度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Trainer::getInputSize() const {
+    return m_layers.empty() ? 0 : m_layers.front().getWidth();
+}
+
+//-------------------------------------------------------------
+//【函数名称】getOutputSize
+//【函数功能】获取输出长度
+//【参数】无
+//【返回值】int64_t，输出层宽度
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t Trainer::getOutputSize() const {
+    return m_layers.empty() ? 0 : m_layers.back().getWidth();
+}
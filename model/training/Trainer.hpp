@@ -0,0 +1,579 @@
+//-------------------------------------------------------------
+//【文件名】Trainer.hpp
+//【功能模块和目的】反向传播训练器声明：在连续的参数与梯度数组上训练网络
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef Trainer_hpp
+#define Trainer_hpp
+
+#include "Optimizer.hpp"
+#include "BatchLoader.hpp"
+#include "../neural_components/Network.hpp"
+#include "../inference_engine/CompiledLayer.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include "../../utils/ParallelReduction.hpp"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】TrainingReport
+//【功能】trainWithValidation的结果：每轮的训练误差和验证误差，以及早停信息
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct TrainingReport {
+    vector<double> trainingLosses;     // 每轮各批更新前均方误差的加权平均
+    vector<double> validationLosses;   // 每轮结束时参数在验证集上的均方误差
+    int iBestEpoch = -1;               // 验证误差最低的轮次（0起），训练器的参数恢复为该轮结束时的参数
+    double rBestValidationLoss = -1.0;
+    bool bStoppedEarly = false;        // 验证误差连续patience轮没有改善而提前停止
+};
+
+//-------------------------------------------------------------
+//【类名】EvolutionSettings
+//【功能】trainGenerationEvolution的参数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+struct EvolutionSettings {
+    int iPopulation = 32;        // 每代评估的扰动个数（成对的正负扰动，奇数时加1）
+    double rSigma = 0.05;        // 扰动的标准差
+    uint64_t uSeed = 20261018;   // 噪声种子，与代数、扰动编号、参数下标一起决定每个噪声值
+};
+
+//-------------------------------------------------------------
+//【类名】Trainer
+//【功能】从Network载入参数，以均方误差为损失做小批量反向传播，训练后写回Network
+//【说明】参数不再分散在各Synapse对象中：除输入层外，每层依次存放全部偏置和行主序权重
+//       （与CompiledLayer的布局相同），所有层首尾相接为一个数组，梯度数组布局相同。
+//       输入层（逐元素计算）视为固定的预处理，不参与训练。
+//       神经元j只训练实际存在的前min(树突数, 上一层宽度)个权重，其余位置恒为0，
+//       写回后网络结构不变。前向计算使用CompiledLayer::forwardBatch（融合激活函数的
+//       矩阵乘），与Network::predict逐位一致；反向传播用KernelDispatch::axpy累加。
+//       损失为所有样本、所有输出的(y-t)²的平均值，梯度为该平均值的精确梯度。
+//       带ThreadPool参数的版本把一批样本分给各线程：每个分片在线程局部缓冲区中累加梯度，
+//       由ParallelReduction::sum（缓冲区按缓存行对齐，确定模式为固定的二叉树）归约后
+//       只更新一次参数；确定模式下结果与线程数无关。
+//       同一对象不能同时在多个线程中调用
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】2026-10-18 增加数据并行的小批量训练
+//           2026-10-18 增加Hogwild异步SGD（trainEpochHogwild）
+//           2026-10-18 trainEpoch可以从BatchLoader取得预取的小批量
+//           2026-10-18 增加与训练并行的验证和早停（trainWithValidation）
+//           2026-10-18 增加只读的getOptimizer，供CheckpointWriter保存优化器状态
+//           2026-10-18 增加无梯度的进化策略训练（trainGenerationEvolution）
+//           2026-10-18 记录载入网络的拓扑指纹，供CheckpointWriter拒绝结构不同的检查点
+//-------------------------------------------------------------
+class Trainer {
+public:
+    static const int64_t VALIDATION_ROWS = 256;  // 评估时每次批量前向计算的样本数
+
+private:
+    //-------------------------------------------------------------
+    //【类名】Workspace
+    //【功能】一次梯度计算（一个分片）使用的临时缓冲区
+    //【说明】用完归还训练器的空闲列表，各批、各分片重复使用，不随每批重新分配
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    struct Workspace {
+        vector<vector<double>> activations;  // Outputs of every layer, padded rows
+        vector<double> delta;                // dLoss/dSum of the layer being back-propagated
+        vector<double> previousDelta;        // Same for the layer below
+    };
+
+    vector<CompiledLayer> m_layers;          // Layer 0 is the frozen input layer
+    vector<int64_t> m_layerOffsets;          // Start of each layer's biases in m_parameters (index 0 unused)
+    vector<vector<int64_t>> m_rowLengths;    // Trainable weights of each neuron: min(dendrites, input width)
+    vector<double> m_parameters;             // Biases then row-major weights, layer after layer
+    uint64_t m_uTopologyFingerprint;         // Network::getTopologyFingerprint of the loaded network, 0 if none
+    vector<double> m_gradients;              // Same layout as m_parameters
+    unique_ptr<Optimizer> m_optimizer;
+    vector<double> m_reduced;                // Reduced gradients followed by the squared-error sum
+    vector<unique_ptr<Workspace>> m_freeWorkspaces;
+    mutex m_workspaceMutex;                  // Guards m_freeWorkspaces
+
+    //-------------------------------------------------------------
+    //【函数名称】refreshLayers
+    //【函数功能】把扁平参数复制到各CompiledLayer（重新打包面板），之后前向计算使用新参数
+    //【参数】layers：各层（m_layers或Hogwild线程的局部副本），parameters：扁平参数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加参数，Hogwild线程刷新自己的局部副本
+    //-------------------------------------------------------------
+    void refreshLayers(vector<CompiledLayer>& layers, const double* parameters) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】forwardRows
+    //【函数功能】计算一批样本在每一层的输出
+    //【参数】layers：各层（m_layers或Hogwild线程的局部副本），inputs：rows×getInputSize()个输入，
+    //       rows：样本数，activations：每层rows行输出，行跨度为PackedGemm::getPaddedWidth(宽度)
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加layers参数
+    //-------------------------------------------------------------
+    void forwardRows(const vector<CompiledLayer>& layers, const double* inputs, int64_t rows,
+                     vector<vector<double>>& activations) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】squaredError
+    //【函数功能】按块（每块VALIDATION_ROWS个样本）做批量前向计算，累加输出与目标之差的平方
+    //【参数】layers：各层，inputs：rows×getInputSize()个输入，targets：rows×getOutputSize()个目标，
+    //       rows：样本数
+    //【返回值】double，误差平方和（按样本、输出的顺序累加，与分块无关）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double squaredError(const vector<CompiledLayer>& layers, const double* inputs, const double* targets,
+                        int64_t rows) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】objectiveLoss
+    //【函数功能】按块批量前向计算全部样本的输出，交给目标函数计算损失
+    //【参数】layers：各层，inputs：rows×getInputSize()个输入，rows：样本数，objective：目标函数，
+    //       outputs：rows×getOutputSize()个输出的缓冲区，activations：前向计算的缓冲区
+    //【返回值】double，目标函数的返回值
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double objectiveLoss(const vector<CompiledLayer>& layers, const double* inputs, int64_t rows,
+                         const function<double(const double*, int64_t)>& objective, vector<double>& outputs,
+                         vector<vector<double>>& activations) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】maskUnusedWeights
+    //【函数功能】把没有对应树突的权重位置置为0
+    //【参数】parameters：getParameterCount()个扁平参数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void maskUnusedWeights(double* parameters) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】acquireWorkspace
+    //【函数功能】取出一个空闲的临时缓冲区，没有时新建（可在多个线程中调用）
+    //【参数】无
+    //【返回值】unique_ptr<Workspace>，缓冲区
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    unique_ptr<Workspace> acquireWorkspace();
+
+    //-------------------------------------------------------------
+    //【函数名称】releaseWorkspace
+    //【函数功能】归还临时缓冲区（可在多个线程中调用）
+    //【参数】workspace：缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void releaseWorkspace(unique_ptr<Workspace> workspace);
+
+    //-------------------------------------------------------------
+    //【函数名称】accumulateGradients
+    //【函数功能】对若干样本做前向和反向传播，把梯度累加到gradients（不清零）
+    //【参数】layers：各层，parameters：与layers一致的扁平参数（反向传播读取权重），
+    //       inputs：rows×getInputSize()个输入，targets：rows×getOutputSize()个目标，rows：样本数，
+    //       scale：输出误差的系数（整批为2/(批样本数×输出数)），workspace：临时缓冲区，
+    //       gradients：getParameterCount()个累加目标，touched：不为空时按[层][神经元]把
+    //       至少一个样本的delta非零的神经元置1（不清零；其余神经元的梯度未被改动）
+    //【返回值】double，这些样本的误差平方和
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加layers和parameters参数
+    //           2026-10-18 增加touched参数
+    //-------------------------------------------------------------
+    double accumulateGradients(const vector<CompiledLayer>& layers, const double* parameters,
+                               const double* inputs, const double* targets, int64_t rows, double scale,
+                               Workspace& workspace, double* gradients,
+                               vector<vector<uint8_t>>* touched = nullptr) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】applyUpdate
+    //【函数功能】由优化器按当前梯度更新参数并刷新各层
+    //【参数】rows：本批样本数（不大于0时不更新）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void applyUpdate(int64_t rows);
+
+    //-------------------------------------------------------------
+    //【函数名称】runEpoch
+    //【函数功能】按顺序分批训练一遍数据集（两个trainEpoch的共同实现）
+    //【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，
+    //       pool：线程池（为nullptr时单线程），mode：归约方式
+    //【返回值】double，加权平均均方误差，数据长度不符时为-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double runEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                    int64_t batchSize, ThreadPool* pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】runEpoch
+    //【函数功能】按加载器给出的批次训练一轮（两个以BatchLoader为参数的trainEpoch的共同实现）
+    //【参数】loader：批次加载器，pool：线程池（为nullptr时单线程），mode：归约方式
+    //【返回值】double，加权平均均方误差，数据宽度不符时为-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double runEpoch(BatchLoader& loader, ThreadPool* pool, ReductionMode mode);
+
+public:
+    //-------------------------------------------------------------
+    //【函数名称】Trainer
+    //【函数功能】默认构造函数（未载入网络，优化器为学习率0.1的SgdOptimizer）
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Trainer();
+
+    //-------------------------------------------------------------
+    //【函数名称】Trainer（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，优化器状态不可共享）
+    //【参数】other：被拷贝的训练器
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Trainer(const Trainer& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源
+    //【返回值】Trainer&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Trainer& operator=(const Trainer& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~Trainer
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~Trainer();
+
+    //-------------------------------------------------------------
+    //【函数名称】loadFrom
+    //【函数功能】从网络载入结构、激活函数和参数（网络本身不被引用，之后可以自由修改），
+    //           并清空优化器状态
+    //【参数】network：源网络
+    //【返回值】bool，网络有效且至少有两层时返回true，否则返回false并清空训练器
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 载入时清空优化器状态
+    //-------------------------------------------------------------
+    bool loadFrom(const Network& network);
+
+    //-------------------------------------------------------------
+    //【函数名称】writeTo
+    //【函数功能】把训练后的偏置和权重写回网络（Neuron::setBias、setInputSynapseWeight）
+    //【参数】network：目标网络，层数、各层宽度和树突数须与载入时的网络相同
+    //【返回值】bool，结构相符且已载入时返回true；结构不符时返回false且不修改网络
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool writeTo(Network& network) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】setOptimizer
+    //【函数功能】更换优化器
+    //【参数】optimizer：新的优化器（为空时忽略）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void setOptimizer(unique_ptr<Optimizer> optimizer);
+
+    //-------------------------------------------------------------
+    //【函数名称】getOptimizer
+    //【函数功能】获取当前优化器（可修改学习率）
+    //【参数】无
+    //【返回值】Optimizer&，优化器
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    Optimizer& getOptimizer();
+
+    //-------------------------------------------------------------
+    //【函数名称】getOptimizer
+    //【函数功能】获取当前优化器（只读，供保存检查点）
+    //【参数】无
+    //【返回值】const Optimizer&，优化器
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const Optimizer& getOptimizer() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】computeGradients
+    //【函数功能】对一批样本做前向和反向传播，梯度覆盖写入梯度数组（不更新参数）
+    //【参数】inputs：rows×getInputSize()个行主序输入，targets：rows×getOutputSize()个目标，
+    //       rows：样本数
+    //【返回值】double，本批的均方误差；未载入或rows不大于0时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double computeGradients(const double* inputs, const double* targets, int64_t rows);
+
+    //-------------------------------------------------------------
+    //【函数名称】computeGradients
+    //【函数功能】把一批样本按ParallelReduction::sum的分片分给线程池计算梯度，
+    //           各分片的梯度在线程局部缓冲区中累加后归约，结果写入梯度数组
+    //【参数】inputs：输入，targets：目标，rows：样本数，pool：线程池，mode：归约方式
+    //【返回值】double，本批的均方误差；只有一个分片时与单线程版本逐位相同
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double computeGradients(const double* inputs, const double* targets, int64_t rows,
+                            ThreadPool& pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainBatch
+    //【函数功能】计算一批样本的梯度并由优化器更新一次参数
+    //【参数】inputs：输入，targets：目标，rows：样本数
+    //【返回值】double，更新前本批的均方误差
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainBatch(const double* inputs, const double* targets, int64_t rows);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainBatch
+    //【函数功能】在线程池上计算一批样本的梯度，归约后由优化器更新一次参数
+    //【参数】inputs：输入，targets：目标，rows：样本数，pool：线程池，mode：归约方式
+    //【返回值】double，更新前本批的均方误差
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainBatch(const double* inputs, const double* targets, int64_t rows, ThreadPool& pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainEpoch
+    //【函数功能】按顺序把数据集分成每批batchSize个样本（最后一批可以较少）各训练一次
+    //【参数】inputs：rows×getInputSize()个输入，targets：rows×getOutputSize()个目标，
+    //       rows：样本数，batchSize：每批样本数（小于1时按1处理）
+    //【返回值】double，各批更新前均方误差按样本数的加权平均；数据长度不符时为-1且不训练
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows, int64_t batchSize);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainEpoch
+    //【函数功能】按顺序分批训练一遍数据集，每批在线程池上数据并行计算（见trainBatch）
+    //【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，
+    //       pool：线程池，mode：归约方式
+    //【返回值】double，各批更新前均方误差按样本数的加权平均；数据长度不符时为-1且不训练
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainEpoch(const vector<double>& inputs, const vector<double>& targets, int64_t rows, int64_t batchSize,
+                      ThreadPool& pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainEpoch
+    //【函数功能】开始加载器的新一轮，按它给出的（可能打乱的）批次各训练一次；
+    //           后台线程组装下一批的同时当前批在计算
+    //【参数】loader：数据集宽度与网络输入输出一致的批次加载器
+    //【返回值】double，各批更新前均方误差按样本数的加权平均；宽度不符或数据集为空时为-1且不训练
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainEpoch(BatchLoader& loader);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainEpoch
+    //【函数功能】按加载器给出的批次训练一轮，每批在线程池上数据并行计算（见trainBatch）
+    //【参数】loader：批次加载器，pool：线程池，mode：归约方式
+    //【返回值】double，各批更新前均方误差按样本数的加权平均；宽度不符或数据集为空时为-1且不训练
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double trainEpoch(BatchLoader& loader, ThreadPool& pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainEpochHogwild
+    //【函数功能】Hogwild式异步SGD训练一遍数据集：各批分给线程池，每个线程读取共享参数的
+    //           当前值、计算本批梯度后立即把非零梯度以parameter -= 学习率·gradient写回共享参数，
+    //           不加锁，批与批之间也没有屏障（整遍结束时才等待）
+    //【参数】inputs：输入，targets：目标，rows：样本数，batchSize：每批样本数，pool：线程池
+    //【返回值】double，各批更新前均方误差按样本数的加权平均；数据长度不符或优化器不是SGD
+    //       （getName()不为"SGD"）时为-1且不训练
+    //【说明】只支持普通SGD：动量、RMSProp、Adam的状态无法在无锁的异步更新中保持一致，
+    //       因此直接拒绝，不会悄悄退化为SGD。
+    //       共享参数为relaxed原子变量，按神经元分行（偏置和权重），每行带一个版本号。
+    //       线程每批只写回梯度非零的行，写完后增加该行的版本号；下一批开始时只重新读取
+    //       版本号变化的行，并用CompiledLayer::setNeuronParameters只改写这些行的面板通道，
+    //       因此每批的读写量与被改动的行成正比，而不是与参数总数成正比。
+    //       读取的行可能混有其他线程写到一半的更新（此时版本号会再次变化，下一批重新读取），
+    //       两个线程同时更新同一元素时其中一次更新可能丢失。梯度稀疏（如死亡的ReLU、
+    //       稀疏连接）时冲突很少，以少许收敛质量换取接近线性的扩展。单线程时与trainEpoch逐位相同
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 按行读写共享参数，拒绝SGD以外的优化器
+    //-------------------------------------------------------------
+    double trainEpochHogwild(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                             int64_t batchSize, ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainWithValidation
+    //【函数功能】训练至多maxEpochs轮，与训练并行地在验证集上评估每轮结束时的参数，验证误差停滞时提前停止
+    //【参数】inputs、targets、rows：训练集，validationInputs、validationTargets、validationRows：验证集，
+    //       batchSize：每批样本数，maxEpochs：最多轮数，patience：验证误差连续多少轮没有比最好值低minDelta以上时停止（小于1时按1处理），
+    //       minDelta：算作改善的最小降幅，pool：训练使用的线程池，mode：归约方式
+    //【返回值】TrainingReport，各轮误差与早停信息；数据长度不符时各数组为空且不训练
+    //【说明】每轮结束时把参数复制到快照（一次内存复制），验证线程用自己的各层副本载入快照，
+    //       以CompiledLayer::forwardBatch的批量推理路径计算验证误差，同时训练线程开始下一轮。
+    //       下一轮结束时才取验证结果，因此早停判断晚一轮做出，多训练的一轮被丢弃：
+    //       返回前参数恢复为验证误差最低的那一轮的参数。验证只读快照，训练结果与不验证时逐位相同
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    TrainingReport trainWithValidation(const vector<double>& inputs, const vector<double>& targets, int64_t rows,
+                                       const vector<double>& validationInputs, const vector<double>& validationTargets,
+                                       int64_t validationRows, int64_t batchSize, int maxEpochs, int patience,
+                                       double minDelta, ThreadPool& pool, ReductionMode mode);
+
+    //-------------------------------------------------------------
+    //【函数名称】trainGenerationEvolution
+    //【函数功能】进化策略（无梯度）训练一代：在当前参数周围评估一组随机扰动，按其损失排名估计下降方向，
+    //           交给优化器更新参数（参数即搜索分布的均值）
+    //【参数】inputs：rows×getInputSize()个输入，rows：样本数，
+    //       objective：objective(outputs, rows)返回损失（越小越好），outputs为rows×getOutputSize()个
+    //       行主序输出，不必可微，
+    //       settings：种群大小、扰动标准差和噪声种子，generation：代数（决定本代的噪声），pool：线程池
+    //【返回值】double，本代各扰动损失的平均值；数据长度不符、种群小于2或标准差不为正时为-1且不更新
+    //【说明】objective由线程池的各个线程同时调用（每个扰动一次，顺序不定），必须是线程安全且可重入的：
+    //       只读取outputs和只读的捕获数据（如目标标签），不能修改共享状态，也不能调用共享对象上
+    //       不是线程安全的方法（如同一个Network的predict，它会改写神经元的输出）；需要额外的
+    //       网络时应在objective之外为每个线程准备副本。结果与线程数无关的前提是objective本身是确定的。
+    //       扰动成对（+σε、-σε）取样，损失换算为居中的排名效用（最好+0.5、最差-0.5，非有限值排最后），
+    //       对异常的损失值不敏感。噪声ε由计数器式随机数生成：第generation代第k对扰动的第i个元素
+    //       只取决于(uSeed, generation, k, i)，评估扰动的线程各自即时生成所需的噪声，
+    //       估计方向时再按参数分块重新生成，线程之间不共享扰动缓冲区，结果与线程数无关。
+    //       每个扰动由一个线程用自己的各层副本以CompiledLayer::forwardBatch批量前向计算全部样本；
+    //       没有树突的权重位置不扰动、保持为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 写明objective的线程安全要求
+    //-------------------------------------------------------------
+    double trainGenerationEvolution(const vector<double>& inputs, int64_t rows,
+                                    const function<double(const double*, int64_t)>& objective,
+                                    const EvolutionSettings& settings, int64_t generation, ThreadPool& pool);
+
+    //-------------------------------------------------------------
+    //【函数名称】evaluateObjective
+    //【函数功能】用当前参数批量前向计算全部样本，返回目标函数的损失
+    //【参数】inputs：rows×getInputSize()个输入，rows：样本数，objective：目标函数（同trainGenerationEvolution）
+    //【返回值】double，损失；数据长度不符时为-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    double evaluateObjective(const vector<double>& inputs, int64_t rows,
+                             const function<double(const double*, int64_t)>& objective) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】evaluate
+    //【函数功能】计算当前参数在数据集上的均方误差（分块批量前向计算，内存不随样本数增长）
+    //【参数】inputs：输入，targets：目标，rows：样本数
+    //【返回值】double，均方误差；数据长度不符时为-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 按块计算
+    //-------------------------------------------------------------
+    double evaluate(const vector<double>& inputs, const vector<double>& targets, int64_t rows) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】predict
+    //【函数功能】用当前参数计算一个样本的输出
+    //【参数】input：getInputSize()个输入
+    //【返回值】vector<double>，输出；未载入或长度不符时抛出runtime_error
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    vector<double> predict(const vector<double>& input) const;
+
+    //-------------------------------------------------------------
+    //【函数名称】setParameters
+    //【函数功能】整体替换参数数组（布局同getParameters）
+    //【参数】parameters：getParameterCount()个参数，未使用的权重位置会被置为0
+    //【返回值】bool，长度相符时返回true
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool setParameters(const vector<double>& parameters);
+
+    //-------------------------------------------------------------
+    //【函数名称】getParameters
+    //【函数功能】获取扁平参数数组
+    //【参数】无
+    //【返回值】const vector<double>&，参数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<double>& getParameters() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getGradients
+    //【函数功能】获取最近一次computeGradients的梯度
+    //【参数】无
+    //【返回值】const vector<double>&，梯度（布局同参数）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    const vector<double>& getGradients() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getParameterCount
+    //【函数功能】获取参数数组长度（含未使用的权重位置）
+    //【参数】无
+    //【返回值】int64_t，参数个数
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getParameterCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getTopologyFingerprint
+    //【函数功能】获取载入网络的拓扑指纹（Network::getTopologyFingerprint）
+    //【参数】无
+    //【返回值】uint64_t，指纹值，未载入时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    uint64_t getTopologyFingerprint() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getInputSize
+    //【函数功能】获取输入长度
+    //【参数】无
+    //【返回值】int64_t，输入层宽度，未载入时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getInputSize() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】getOutputSize
+    //【函数功能】获取输出长度
+    //【参数】无
+    //【返回值】int64_t，输出层宽度，未载入时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int64_t getOutputSize() const;
+};
+
+#endif // Trainer_hpp
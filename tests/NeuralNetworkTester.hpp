@@ -10,6 +10,8 @@
 
 #include "../controller/NetworkController.hpp"
 #include <string>
+#include <vector>
+#include <memory>
 
 //-------------------------------------------------------------
 //【类名】NeuralNetworkTester
@@ -44,6 +46,37 @@ private:
     //-------------------------------------------------------------
     void recordTestResult(const std::string& testName, bool passed);
     
+    //-------------------------------------------------------------
+    //【函数名称】makeDenseNetwork
+    //【函数功能】生成全连接的合成网络（用D记录描述后导入），权重为确定性的正弦序列
+    //【参数】widths：各层宽度，activations：各层激活函数代码，负数表示神经元j使用j%4
+    //【返回值】std::unique_ptr<Network>，导入失败时为nullptr
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    std::unique_ptr<Network> makeDenseNetwork(const std::vector<int>& widths, const std::vector<int>& activations);
+    
+    //-------------------------------------------------------------
+    //【函数名称】parallelThreadCount
+    //【函数功能】获取并行测试使用的执行者数量：hardware_concurrency，但至少为4，
+    //           使单核机器上的并行测试也真正经过多个线程
+    //【参数】无
+    //【返回值】int，执行者数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int parallelThreadCount();
+    
+    //-------------------------------------------------------------
+    //【函数名称】describeThreads
+    //【函数功能】生成"1 thread"或"N threads"形式的线程数说明
+    //【参数】count：线程数
+    //【返回值】std::string，说明文字
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static std::string describeThreads(int count);
+    
     // 核心功能测试方法
     //-------------------------------------------------------------
     //【函数名称】testNetworkImport
@@ -105,6 +138,156 @@ private:
     //-------------------------------------------------------------
     bool testSaveLoad();
     
+    //-------------------------------------------------------------
+    //【函数名称】testDenseBlockFormat
+    //【函数功能】测试稠密块（D记录）导出导入一致性
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testDenseBlockFormat();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testMemoryStreamIO
+    //【函数功能】测试内存缓冲区与流的导入导出
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testMemoryStreamIO();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testLazyLoading
+    //【函数功能】测试按层延迟加载权重，包括多个线程同时通过常量接口触发加载
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 增加并发加载的检查
+    //-------------------------------------------------------------
+    bool testLazyLoading();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testStreamingInference
+    //【函数功能】测试二进制编译模型的逐层流式推理
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testStreamingInference();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testPatchRoundTrip
+    //【函数功能】测试差异补丁的导出与原地应用
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testPatchRoundTrip();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testHotSwap
+    //【函数功能】测试后台导入、写时复制的编辑与模型热替换期间的并发推理
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 并发推理期间编辑网络
+    //-------------------------------------------------------------
+    bool testHotSwap();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testModelRegistry
+    //【函数功能】测试多模型注册表的LRU淘汰与模型句柄
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testModelRegistry();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testImportCache
+    //【函数功能】测试按内容寻址的编译模型缓存
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testImportCache();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testHeaderCodegen
+    //【函数功能】测试独立C++头文件代码生成
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testHeaderCodegen();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testStaticNetwork
+    //【函数功能】测试编译期固定拓扑网络模板
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testStaticNetwork();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testJitEngine
+    //【函数功能】测试x86-64即时编译推理引擎
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testJitEngine();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testKernelDispatch
+    //【函数功能】测试按CPU特性选择的各指令集稠密内核
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testKernelDispatch();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testBatchGemm
+    //【函数功能】测试批量推理的分块矩阵乘内核，并报告GFLOP/s与峰值的比例
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testBatchGemm();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testFusedActivation
+    //【函数功能】测试融合了偏置和激活函数的内核与分开计算的结果逐位一致，并比较两者耗时
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testFusedActivation();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testDeterministicReduction
+    //【函数功能】测试确定归约模式的结果与线程数无关，并行批量推理与单线程逐位一致，并比较两种模式的耗时
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testDeterministicReduction();
+    
     //-------------------------------------------------------------
     //【函数名称】testErrorHandling
     //【函数功能】测试错误处理和边界情况
@@ -156,6 +339,117 @@ private:
     //-------------------------------------------------------------
     bool testRegression();
     
+    //-------------------------------------------------------------
+    //【函数名称】testTraining
+    //【函数功能】测试反向传播训练器：导数与各激活函数一致、梯度与有限差分一致、
+    //           从未训练的权重学会XOR并经控制器写回网络，并报告训练吞吐量
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testTraining();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testParallelTraining
+    //【函数功能】测试数据并行的小批量训练：确定归约方式下训练结果与线程数无关，
+    //           快速方式与之只差舍入，并报告单线程与多线程的训练吞吐量
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testParallelTraining();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testHogwildTraining
+    //【函数功能】测试Hogwild异步SGD：单线程时与顺序训练逐位相同，多线程无锁更新时
+    //           在super_complex.ann上收敛到与顺序训练相近的误差，SGD以外的优化器被拒绝
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】2026-10-18 检查SGD以外的优化器被拒绝
+    //-------------------------------------------------------------
+    bool testHogwildTraining();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testOptimizers
+    //【函数功能】测试动量SGD、RMSProp和Adam：各指令集级别的更新内核与逐元素公式逐位一致，
+    //           各优化器都能训练XOR网络，并比较Adam一步与一次前向加反向传播的耗时
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testOptimizers();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testDatasetLoading
+    //【函数功能】测试内存映射数据集和预取加载：文件内容与源数据一致，错误文件被拒绝，
+    //           不打乱时与内存中的一轮训练逐位相同，打乱的排列只取决于种子且与是否预取无关，
+    //           并经控制器从数据集文件训练XOR
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testDatasetLoading();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testValidatedTraining
+    //【函数功能】测试与训练并行的验证和早停：各轮误差与先训练后验证的顺序执行逐位相同，
+    //           验证误差停滞时提前停止并恢复最好一轮的参数，报告并行与顺序执行的耗时
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testValidatedTraining();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testCheckpoints
+    //【函数功能】测试异步检查点：capture的停顿与文本导出对比，恢复后继续训练与不中断的训练逐位相同，
+    //           连续capture只保留最新的快照，优化器不匹配或文件截断时恢复失败且训练器不变
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testCheckpoints();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testHyperparameterSearch
+    //【函数功能】测试并行的超参数搜索：逐轮淘汰的候选都不优于同轮的存活者，结果与线程数无关，
+    //           第一名写出后重新导入的验证误差与搜索记录一致，报告多线程与单线程的耗时
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testHyperparameterSearch();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testEvolutionStrategy
+    //【函数功能】测试进化策略训练：以不可微的分类错误率为目标降低错误率，
+    //           结果与线程数无关，稀疏网络中没有树突的权重保持为0，报告种群评估的吞吐量
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testEvolutionStrategy();
+    
+    //-------------------------------------------------------------
+    //【函数名称】testDistillation
+    //【函数功能】测试知识蒸馏：宽网络的输出训练出参数少一个数量级、仍能拟合教师的学生，
+    //           super_complex.ann的蒸馏结果与线程数无关，报告延迟与拟合程度的权衡
+    //【参数】无
+    //【返回值】bool，测试是否通过
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    bool testDistillation();
+    
     // 健壮性测试方法
     //-------------------------------------------------------------
     //【函数名称】testMultipleNetworks
@@ -0,0 +1,76 @@
+//-------------------------------------------------------------
+//【文件名】MemoryStreamBuffer.cpp
+//【功能模块和目的】只读内存区域流缓冲区实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "MemoryStreamBuffer.hpp"
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】MemoryStreamBuffer
+//【函数功能】构造函数，直接以调用者内存作为读取区
+//【参数】data：内存区域首地址，size：字节数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+MemoryStreamBuffer::MemoryStreamBuffer(const char* data, size_t size) {
+    // streambuf only reads through the get area, so the const_cast never leads to a write
+    char* pBegin = const_cast<char*>(data);
+    setg(pBegin, pBegin, pBegin + size);
+}
+
+//-------------------------------------------------------------
+//【函数名称】~MemoryStreamBuffer
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+MemoryStreamBuffer::~MemoryStreamBuffer() = default;
+
+//-------------------------------------------------------------
+//【函数名称】seekoff
+//【函数功能】按相对位置定位读指针
+//【参数】offset：偏移量，direction：起点（beg/cur/end），mode：定位模式
+//【返回值】pos_type，新位置，失败返回-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekoff(off_type offset, ios_base::seekdir direction,
+                                                         ios_base::openmode mode) {
+    if (!(mode & ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+    
+    off_type iBase = 0;
+    if (direction == ios_base::cur) {
+        iBase = gptr() - eback();
+    } else if (direction == ios_base::end) {
+        iBase = egptr() - eback();
+    }
+    
+    off_type iTarget = iBase + offset;
+    if (iTarget < 0 || iTarget > egptr() - eback()) {
+        return pos_type(off_type(-1));
+    }
+    
+    setg(eback(), eback() + iTarget, egptr());
+    return pos_type(iTarget);
+}
+
+//-------------------------------------------------------------
+//【函数名称】seekpos
+//【函数功能】按绝对位置定位读指针
+//【参数】position：绝对位置，mode：定位模式
+//【返回值】pos_type，新位置，失败返回-1
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos(pos_type position, ios_base::openmode mode) {
+    return seekoff(off_type(position), ios_base::beg, mode);
+}
@@ -0,0 +1,88 @@
+//-------------------------------------------------------------
+//【文件名】MemoryStreamBuffer.hpp
+//【功能模块和目的】只读内存区域流缓冲区声明（零拷贝读取）
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef MemoryStreamBuffer_hpp
+#define MemoryStreamBuffer_hpp
+
+#include <streambuf>
+#include <cstddef>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】MemoryStreamBuffer
+//【功能】将调用者持有的内存区域包装为可定位的输入流缓冲区
+//【说明】不复制数据，调用者须保证内存在流使用期间有效
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class MemoryStreamBuffer : public streambuf {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】MemoryStreamBuffer
+    //【函数功能】构造函数
+    //【参数】data：内存区域首地址，size：字节数
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    MemoryStreamBuffer(const char* data, size_t size);
+    
+    //-------------------------------------------------------------
+    //【函数名称】MemoryStreamBuffer（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，流缓冲区不可复制）
+    //【参数】other：被拷贝的缓冲区
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    MemoryStreamBuffer(const MemoryStreamBuffer& other) = delete;
+    
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源缓冲区
+    //【返回值】MemoryStreamBuffer&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    MemoryStreamBuffer& operator=(const MemoryStreamBuffer& other) = delete;
+    
+    //-------------------------------------------------------------
+    //【函数名称】~MemoryStreamBuffer
+    //【函数功能】析构函数
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~MemoryStreamBuffer();
+
+protected:
+    //-------------------------------------------------------------
+    //【函数名称】seekoff
+    //【函数功能】按相对位置定位读指针
+    //【参数】offset：偏移量，direction：起点（beg/cur/end），mode：定位模式
+    //【返回值】pos_type，新位置，失败返回-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    pos_type seekoff(off_type offset, ios_base::seekdir direction,
+                     ios_base::openmode mode = ios_base::in) override;
+    
+    //-------------------------------------------------------------
+    //【函数名称】seekpos
+    //【函数功能】按绝对位置定位读指针
+    //【参数】position：绝对位置，mode：定位模式
+    //【返回值】pos_type，新位置，失败返回-1
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    pos_type seekpos(pos_type position, ios_base::openmode mode = ios_base::in) override;
+};
+
+#endif // MemoryStreamBuffer_hpp
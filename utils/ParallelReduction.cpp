@@ -0,0 +1,118 @@
+//-------------------------------------------------------------
+//【文件名】ParallelReduction.cpp
+//【功能模块和目的】多线程求和的归约实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ParallelReduction.hpp"
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+const int64_t CACHE_LINE_DOUBLES = 8;
+
+} // namespace
+
+//-------------------------------------------------------------
+//【函数名称】getLeafCount
+//【函数功能】计算确定模式下的叶子数
+//【参数】items：项数
+//【返回值】int64_t，叶子数
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int64_t ParallelReduction::getLeafCount(int64_t items) {
+    if (items <= 0) {
+        return 0;
+    }
+    const int64_t iMaxLeaves = MAX_LEAVES;  // min() takes references; the member has no definition
+    return min(iMaxLeaves, (items + LEAF_ITEMS - 1) / LEAF_ITEMS);
+}
+
+//-------------------------------------------------------------
+//【函数名称】sum
+//【函数功能】并行累加items个项的贡献
+//【参数】pool：线程池，mode：归约方式，items：项数，width：长度，accumulate：累加函数，result：输出
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ParallelReduction::sum(ThreadPool& pool, ReductionMode mode, int64_t items, int64_t width,
+                            const function<void(int64_t, int64_t, double*)>& accumulate, double* result) {
+    if (width <= 0) {
+        return;
+    }
+    fill(result, result + width, 0.0);
+    if (items <= 0) {
+        return;
+    }
+    // Fast: one contiguous shard per executor; Deterministic: leaves fixed by the item count
+    const int64_t iParts = mode == ReductionMode::Deterministic ? getLeafCount(items)
+                                                                 : min<int64_t>(pool.getThreadCount(), items);
+    if (iParts == 1) {
+        accumulate(0, items, result);
+        return;
+    }
+
+    // Each part's buffer starts on its own cache line
+    const int64_t iStride = (width + CACHE_LINE_DOUBLES - 1) / CACHE_LINE_DOUBLES * CACHE_LINE_DOUBLES;
+    vector<double> storage(static_cast<size_t>(iParts * iStride + CACHE_LINE_DOUBLES));
+    uintptr_t uAddress = reinterpret_cast<uintptr_t>(storage.data());
+    double* pBuffers = storage.data() + ((64 - uAddress % 64) % 64) / sizeof(double);
+
+    pool.parallelFor(iParts, [&](int64_t iPart, int) {
+        double* pBuffer = pBuffers + iPart * iStride;
+        fill(pBuffer, pBuffer + width, 0.0);
+        accumulate(iPart * items / iParts, (iPart + 1) * items / iParts, pBuffer);
+    });
+
+    // Column blocks are independent; inside a block the order is fixed
+    const int64_t iBlocks = (width + REDUCE_COLUMNS - 1) / REDUCE_COLUMNS;
+    pool.parallelFor(iBlocks, [&](int64_t iBlock, int) {
+        const int64_t iBegin = iBlock * REDUCE_COLUMNS;
+        const int64_t iEnd = min(width, iBegin + REDUCE_COLUMNS);
+        if (mode == ReductionMode::Deterministic) {
+            for (int64_t iStep = 1; iStep < iParts; iStep *= 2) {
+                for (int64_t iPart = 0; iPart + iStep < iParts; iPart += 2 * iStep) {
+                    double* pTarget = pBuffers + iPart * iStride;
+                    const double* pSource = pBuffers + (iPart + iStep) * iStride;
+                    for (int64_t iColumn = iBegin; iColumn < iEnd; ++iColumn) {
+                        pTarget[iColumn] += pSource[iColumn];
+                    }
+                }
+            }
+            copy(pBuffers + iBegin, pBuffers + iEnd, result + iBegin);
+        } else {
+            for (int64_t iPart = 0; iPart < iParts; ++iPart) {
+                const double* pSource = pBuffers + iPart * iStride;
+                for (int64_t iColumn = iBegin; iColumn < iEnd; ++iColumn) {
+                    result[iColumn] += pSource[iColumn];
+                }
+            }
+        }
+    });
+}
+
+//-------------------------------------------------------------
+//【函数名称】dot
+//【函数功能】并行计算点积
+//【参数】pool：线程池，mode：归约方式，a、b：向量，count：元素数
+//【返回值】double，点积
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+double ParallelReduction::dot(ThreadPool& pool, ReductionMode mode, const double* a, const double* b, int64_t count) {
+    double rResult = 0.0;
+    sum(pool, mode, count, 1, [a, b](int64_t iBegin, int64_t iEnd, double* pAccumulator) {
+        double rSum = *pAccumulator;
+        for (int64_t iIdx = iBegin; iIdx < iEnd; ++iIdx) {
+            rSum += a[iIdx] * b[iIdx];
+        }
+        *pAccumulator = rSum;
+    }, &rResult);
+    return rResult;
+}
@@ -0,0 +1,85 @@
+//-------------------------------------------------------------
+//【文件名】ParallelReduction.hpp
+//【功能模块和目的】多线程求和（梯度累加、点积）的归约模式与实现声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef ParallelReduction_hpp
+#define ParallelReduction_hpp
+
+#include "ThreadPool.hpp"
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ReductionMode
+//【功能】多线程求和的归约方式
+//【说明】Fast：每个执行者累加一段连续的项，各段结果按执行者顺序相加，
+//       分段随线程数变化，因此结果的最后几位随线程数变化；
+//       Deterministic：项按只取决于项数的方式分为若干叶子，每个叶子顺序累加，
+//       叶子之间按固定的二叉树两两相加，结果与线程数无关，每次运行逐位相同
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+enum class ReductionMode {
+    Fast,
+    Deterministic
+};
+
+//-------------------------------------------------------------
+//【类名】ParallelReduction
+//【功能】在ThreadPool上把items个项的贡献（各为width个double）累加为一个向量
+//【说明】确定模式下叶子数为min(ceil(items / LEAF_ITEMS), MAX_LEAVES)，第i个叶子包含
+//       [i·items/叶子数, (i+1)·items/叶子数)的项；第一层把叶子i+1加到叶子i上（i为偶数），
+//       第二层把叶子i+2加到叶子i上（i为4的倍数），依此类推，最终结果在叶子0中。
+//       各叶子的缓冲区按缓存行（8个double）对齐跨度，不同线程写入的缓冲区不共享缓存行。
+//       树的合并按REDUCE_COLUMNS列分块并行，每块内按固定顺序完成整棵树。
+//       只有一个叶子时两种模式都等于顺序累加。所有方法均为静态方法
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class ParallelReduction {
+public:
+    static const int64_t LEAF_ITEMS = 64;        // 确定模式下每个叶子至少包含的项数
+    static const int64_t MAX_LEAVES = 64;        // 确定模式的叶子数上限（限制缓冲区内存）
+    static const int64_t REDUCE_COLUMNS = 2048;  // 合并阶段每个任务负责的列数
+
+    //-------------------------------------------------------------
+    //【函数名称】getLeafCount
+    //【函数功能】计算确定模式下的叶子数（只取决于项数）
+    //【参数】items：项数
+    //【返回值】int64_t，叶子数，items不大于0时为0
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static int64_t getLeafCount(int64_t items);
+
+    //-------------------------------------------------------------
+    //【函数名称】sum
+    //【函数功能】并行累加items个项的贡献
+    //【参数】pool：线程池，mode：归约方式，items：项数，width：每项贡献的长度，
+    //       accumulate：accumulate(begin, end, accumulator)把第begin到end-1项的贡献按顺序
+    //       加到width个元素的accumulator上（accumulator初始为0，可能被多个线程同时调用，
+    //       各自使用不同的accumulator），result：width个输出
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static void sum(ThreadPool& pool, ReductionMode mode, int64_t items, int64_t width,
+                    const function<void(int64_t, int64_t, double*)>& accumulate, double* result);
+
+    //-------------------------------------------------------------
+    //【函数名称】dot
+    //【函数功能】并行计算点积Σ a[i]·b[i]
+    //【参数】pool：线程池，mode：归约方式，a、b：count个元素，count：元素数
+    //【返回值】double，点积
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static double dot(ThreadPool& pool, ReductionMode mode, const double* a, const double* b, int64_t count);
+};
+
+#endif // ParallelReduction_hpp
@@ -0,0 +1,164 @@
+//-------------------------------------------------------------
+//【文件名】ThreadPool.cpp
+//【功能模块和目的】固定线程数的并行任务池实现
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【函数名称】ThreadPool
+//【函数功能】构造函数
+//【参数】threads：执行者数量
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ThreadPool::ThreadPool(int threads)
+    : m_pTask(nullptr), m_iTaskCount(0), m_nextTask(0), m_uRound(0), m_iActiveWorkers(0),
+      m_bStopping(false) {
+    for (int iWorker = 1; iWorker < threads; ++iWorker) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, iWorker);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】~ThreadPool
+//【函数功能】析构函数
+//【参数】无
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_bStopping = true;
+    }
+    m_wake.notify_all();
+    for (thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getThreadCount
+//【函数功能】获取执行者数量
+//【参数】无
+//【返回值】int，执行者数量
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(m_workers.size()) + 1;
+}
+
+//-------------------------------------------------------------
+//【函数名称】parallelFor
+//【函数功能】执行count个任务并等待全部完成
+//【参数】count：任务数，task：任务函数
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ThreadPool::parallelFor(int64_t count, const function<void(int64_t, int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    lock_guard<mutex> runLock(m_runMutex);
+    // A single task or a single executor needs no hand-off
+    if (count == 1 || m_workers.empty()) {
+        for (int64_t iTask = 0; iTask < count; ++iTask) {
+            task(iTask, 0);
+        }
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_pTask = &task;
+        m_iTaskCount = count;
+        m_nextTask.store(0);
+        m_iActiveWorkers = static_cast<int>(m_workers.size());
+        m_error = nullptr;
+        ++m_uRound;
+    }
+    m_wake.notify_all();
+    runTasks(0);
+
+    unique_lock<mutex> lock(m_mutex);
+    m_finished.wait(lock, [this]() { return m_iActiveWorkers == 0; });
+    m_pTask = nullptr;
+    if (m_error) {
+        exception_ptr error = m_error;
+        m_error = nullptr;
+        rethrow_exception(error);
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】getShared
+//【函数功能】获取进程共享的池
+//【参数】无
+//【返回值】ThreadPool&，共享池
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool s_pool(static_cast<int>(thread::hardware_concurrency()));
+    return s_pool;
+}
+
+//-------------------------------------------------------------
+//【函数名称】workerLoop
+//【函数功能】后台线程主循环
+//【参数】worker：执行者编号
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ThreadPool::workerLoop(int worker) {
+    uint64_t uSeenRound = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, uSeenRound]() { return m_bStopping || m_uRound != uSeenRound; });
+            if (m_bStopping) {
+                return;
+            }
+            uSeenRound = m_uRound;
+        }
+        runTasks(worker);
+        lock_guard<mutex> lock(m_mutex);
+        if (--m_iActiveWorkers == 0) {
+            m_finished.notify_one();
+        }
+    }
+}
+
+//-------------------------------------------------------------
+//【函数名称】runTasks
+//【函数功能】领取并执行当前一轮的任务
+//【参数】worker：执行者编号
+//【返回值】无
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+void ThreadPool::runTasks(int worker) {
+    // The round state is fixed until every worker has left runTasks
+    const function<void(int64_t, int)>& task = *m_pTask;
+    const int64_t iCount = m_iTaskCount;
+    for (int64_t iTask = m_nextTask.fetch_add(1); iTask < iCount; iTask = m_nextTask.fetch_add(1)) {
+        try {
+            task(iTask, worker);
+        } catch (...) {
+            lock_guard<mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = current_exception();
+            }
+        }
+    }
+}
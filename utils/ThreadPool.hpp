@@ -0,0 +1,140 @@
+//-------------------------------------------------------------
+//【文件名】ThreadPool.hpp
+//【功能模块和目的】固定线程数的并行任务池声明
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstdint>
+
+using namespace std;
+
+//-------------------------------------------------------------
+//【类名】ThreadPool
+//【功能】持有固定数量的工作线程，以parallelFor把编号为0..count-1的任务分给各线程执行
+//【说明】调用线程本身也执行任务（编号0的执行者），因此getThreadCount()个执行者中只有
+//       getThreadCount()-1个是后台线程。任务按编号递增顺序被领取，但哪个线程执行哪个任务
+//       不确定：需要确定结果的调用者应使结果只依赖任务编号（见ParallelReduction）。
+//       多个线程同时调用parallelFor时依次执行；任务内不能再对同一个池调用parallelFor
+//【开发者及日期】林钲凯 2026-10-18
+//【更改记录】
+//-------------------------------------------------------------
+class ThreadPool {
+public:
+    //-------------------------------------------------------------
+    //【函数名称】ThreadPool
+    //【函数功能】构造函数，启动threads-1个后台线程
+    //【参数】threads：执行者数量（含调用线程），小于1时按1处理
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    explicit ThreadPool(int threads);
+
+    //-------------------------------------------------------------
+    //【函数名称】ThreadPool（拷贝构造）
+    //【函数功能】拷贝构造函数（禁用，线程不可复制）
+    //【参数】other：被拷贝的池
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ThreadPool(const ThreadPool& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】operator=
+    //【函数功能】赋值运算符（禁用）
+    //【参数】other：赋值来源
+    //【返回值】ThreadPool&，自身引用
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    //-------------------------------------------------------------
+    //【函数名称】~ThreadPool
+    //【函数功能】析构函数，通知并等待所有后台线程退出
+    //【参数】无
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    ~ThreadPool();
+
+    //-------------------------------------------------------------
+    //【函数名称】getThreadCount
+    //【函数功能】获取执行者数量（含调用线程）
+    //【参数】无
+    //【返回值】int，执行者数量
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    int getThreadCount() const;
+
+    //-------------------------------------------------------------
+    //【函数名称】parallelFor
+    //【函数功能】执行count个任务并等待全部完成
+    //【参数】count：任务数，task：task(任务编号, 执行者编号)，执行者编号在0..getThreadCount()-1之间，
+    //       同一时刻每个执行者编号只对应一个线程，可用于索引线程局部缓冲区
+    //【返回值】无（任务抛出异常时，其余任务仍执行完毕，之后重新抛出第一个异常）
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void parallelFor(int64_t count, const function<void(int64_t, int)>& task);
+
+    //-------------------------------------------------------------
+    //【函数名称】getShared
+    //【函数功能】获取进程共享的池，执行者数量为hardware_concurrency（首次调用时创建）
+    //【参数】无
+    //【返回值】ThreadPool&，共享池
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    static ThreadPool& getShared();
+
+private:
+    //-------------------------------------------------------------
+    //【函数名称】workerLoop
+    //【函数功能】后台线程主循环：等待新一轮任务，领取并执行，直到池被析构
+    //【参数】worker：执行者编号（1起）
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void workerLoop(int worker);
+
+    //-------------------------------------------------------------
+    //【函数名称】runTasks
+    //【函数功能】领取并执行当前一轮的任务，直到没有剩余任务
+    //【参数】worker：执行者编号
+    //【返回值】无
+    //【开发者及日期】林钲凯 2026-10-18
+    //【更改记录】
+    //-------------------------------------------------------------
+    void runTasks(int worker);
+
+    vector<thread> m_workers;
+    mutex m_runMutex;                               // Serialises concurrent parallelFor calls
+    mutex m_mutex;                                  // Guards the round state below
+    condition_variable m_wake;                      // Signals a new round or shutdown
+    condition_variable m_finished;                  // Signals that the last worker left the round
+    const function<void(int64_t, int)>* m_pTask;    // Task of the current round
+    int64_t m_iTaskCount;
+    atomic<int64_t> m_nextTask;                     // Next unclaimed task number
+    uint64_t m_uRound;                              // Incremented for each parallelFor
+    int m_iActiveWorkers;                           // Background workers still in the round
+    bool m_bStopping;
+    exception_ptr m_error;                          // First exception thrown by a task
+};
+
+#endif // ThreadPool_hpp